@@ -0,0 +1,203 @@
+#include "cli/DaemonProtocol.h"
+#include "core/TaskManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <csignal>
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+/**
+ * @file DaemonBench.cpp
+ * @brief Load generator for `task-cli serve`.
+ *
+ * Usage: daemon-bench [tasks] [requests] [pipeline depth] [write percent] [task-cli path]
+ *
+ * Creates a store with the given number of tasks (one in a hundred in progress) under the system
+ * temp directory and starts a daemon on it for every worker count in {1, 2, 4, 8}. For every
+ * client count in {1, 4, 16, 64}, the clients then share the given number of requests, each on
+ * its own connection, sending them in pipelined windows of the given depth. Reads are
+ * `list in-progress` and writes are `mark-done <random id>`. Reports throughput and the median
+ * and 99th percentile latency, measured from sending a window to receiving each response.
+ */
+
+#if defined(_WIN32)
+
+int main() {
+    std::cerr << "daemon-bench needs Unix domain sockets" << std::endl;
+    return 1;
+}
+
+#else
+
+namespace {
+
+    /**
+     * @brief Writes a fresh store with n synthetic tasks, every hundredth one in progress.
+     */
+    void createStore(const std::string& path, std::size_t n) {
+        std::filesystem::remove(path);
+        TaskManager manager(path);
+        manager.setDurability(Durability::NONE);
+        manager.loadTasksFromStore();
+        for(std::size_t i = 2; i <= n; ++i) {
+            TaskStatus status = i % 100 == 0 ? TaskStatus::IN_PROGRESS : TaskStatus::TODO;
+            manager.emplaceTask(static_cast<int>(i), "Synthetic task " + std::to_string(i), status,
+                                1'700'000'000, 1'700'000'000);
+        }
+        manager.compactStore();
+    }
+
+    /**
+     * @brief Starts `task-cli serve` on a store and waits until it accepts connections.
+     * @return The daemon's process ID, or -1 if it could not be started.
+     */
+    pid_t startDaemon(const std::string& taskCli, const std::string& store, unsigned workers) {
+        std::string storeVariable = "TASK_CLI_STORE=" + store;
+        std::vector<char*> environment;
+        for(char** variable = environ; *variable; ++variable) {
+            if(!std::string_view(*variable).starts_with("TASK_CLI_STORE=")) environment.push_back(*variable);
+        }
+        environment.push_back(storeVariable.data());
+        environment.push_back(nullptr);
+
+        std::string workerCount = std::to_string(workers);
+        std::vector<char*> arguments{const_cast<char*>(taskCli.c_str()), const_cast<char*>("serve"),
+                                     const_cast<char*>("--workers"), workerCount.data(), nullptr};
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+        pid_t pid = -1;
+        int failed = posix_spawn(&pid, taskCli.c_str(), &actions, nullptr, arguments.data(), environment.data());
+        posix_spawn_file_actions_destroy(&actions);
+        if(failed != 0) return -1;
+
+        const std::string socket = Daemon::socketPath(store);
+        for(int attempt = 0; attempt < 500; ++attempt) {
+            if(Daemon::Client(socket).connected()) return pid;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        kill(pid, SIGKILL);
+        waitpid(pid, nullptr, 0);
+        return -1;
+    }
+
+    /**
+     * @brief Sends requests on one connection in pipelined windows, recording each latency.
+     * @return False if the daemon dropped the connection.
+     */
+    bool runClient(const std::string& socket, std::size_t requests, std::size_t depth, int writePercent,
+                   std::size_t tasks, unsigned seed, std::vector<double>& latencies) {
+        Daemon::Client client(socket);
+        if(!client.connected()) return false;
+
+        std::mt19937 random(seed);
+        std::uniform_int_distribution<int> percent(0, 99);
+        std::uniform_int_distribution<std::size_t> anyTask(2, tasks);
+        Daemon::Response response;
+        for(std::size_t sent = 0; sent < requests;) {
+            std::size_t window = std::min(depth, requests - sent);
+            for(std::size_t i = 0; i < window; ++i) {
+                if(percent(random) < writePercent) {
+                    std::size_t id = anyTask(random);
+                    if(id % 100 == 0) ++id; // keep the in-progress tasks, so reads stay the same size
+                    std::string idText = std::to_string(id);
+                    std::string_view arguments[] = {"task-cli", "mark-done", idText};
+                    client.send(arguments);
+                } else {
+                    std::string_view arguments[] = {"task-cli", "list", "in-progress"};
+                    client.send(arguments);
+                }
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            if(!client.flush()) return false;
+            for(std::size_t i = 0; i < window; ++i) {
+                if(!client.receive(response)) return false;
+                latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+            }
+            sent += window;
+        }
+        return true;
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000;
+    const std::size_t requests = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20'000;
+    const std::size_t depth = std::max<std::size_t>(1, argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 16);
+    const int writePercent = argc > 4 ? std::atoi(argv[4]) : 10;
+    const std::string taskCli = argc > 5 ? argv[5] : TASK_CLI_PATH;
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / ("daemon-bench-" + std::to_string(getpid()));
+    std::filesystem::create_directories(directory);
+    const std::string store = (directory / "tasks.json").string();
+    const std::string socket = Daemon::socketPath(store);
+
+    std::cout << "Tasks: " << n << ", requests per run: " << requests << ", pipeline depth: " << depth
+              << ", writes: " << writePercent << "%" << std::endl;
+    std::cout << std::setw(8) << "workers" << std::setw(8) << "clients" << std::setw(12) << "ops/s"
+              << std::setw(12) << "p50 us" << std::setw(12) << "p99 us" << std::endl;
+
+    int status = 0;
+    for(unsigned workers : {1u, 2u, 4u, 8u}) {
+        createStore(store, n);
+        pid_t daemon = startDaemon(taskCli, store, workers);
+        if(daemon < 0) {
+            std::cerr << "Failed to start " << taskCli << " serve" << std::endl;
+            status = 1;
+            break;
+        }
+
+        for(std::size_t clients : {1u, 4u, 16u, 64u}) {
+            std::vector<std::vector<double>> latencies(clients);
+            std::vector<char> succeeded(clients, 0);
+            std::vector<std::thread> threads;
+            auto start = std::chrono::steady_clock::now();
+            for(std::size_t c = 0; c < clients; ++c) {
+                std::size_t share = requests / clients + (c < requests % clients ? 1 : 0);
+                threads.emplace_back([&, c, share] {
+                    succeeded[c] = runClient(socket, share, depth, writePercent, n, static_cast<unsigned>(c + 1), latencies[c]);
+                });
+            }
+            for(std::thread& thread : threads) thread.join();
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            if(std::find(succeeded.begin(), succeeded.end(), 0) != succeeded.end()) {
+                std::cerr << "The daemon dropped a connection" << std::endl;
+                status = 1;
+            }
+            std::vector<double> all;
+            for(const auto& client : latencies) all.insert(all.end(), client.begin(), client.end());
+            if(all.empty()) continue;
+            std::sort(all.begin(), all.end());
+            std::cout << std::setw(8) << workers << std::setw(8) << clients << std::fixed << std::setprecision(0)
+                      << std::setw(12) << static_cast<double>(all.size()) / seconds << std::setprecision(1)
+                      << std::setw(12) << all[all.size() / 2]
+                      << std::setw(12) << all[std::min(all.size() - 1, all.size() * 99 / 100)] << std::endl;
+        }
+
+        kill(daemon, SIGTERM);
+        waitpid(daemon, nullptr, 0);
+    }
+
+    std::filesystem::remove_all(directory);
+    return status;
+}
+
+#endif
@@ -0,0 +1,99 @@
+#include "core/TaskManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+/**
+ * @file DurabilityBench.cpp
+ * @brief Measures the per-mutation save latency of every Durability level.
+ *
+ * Usage: durability-bench [tasks] [mutations] [directory]
+ *
+ * Creates a store with the given number of tasks in a scratch directory (by default under the
+ * system temp directory; pass a directory on the disk you care about), then repeatedly changes
+ * the status of one task and calls saveTasksToStore(). Every combination of store mode
+ * (snapshot, journal) and durability level (none, fsync-data, fsync-full) is timed, and the
+ * mean, median and 99th percentile latency per mutation are reported.
+ */
+
+namespace {
+
+    const char* durabilityName(Durability durability) {
+        switch(durability) {
+            case Durability::NONE: return "none";
+            case Durability::FSYNC_DATA: return "fsync-data";
+            case Durability::FSYNC_FULL: return "fsync-full";
+        }
+        return "unknown";
+    }
+
+    /**
+     * @brief Writes a fresh store with n synthetic tasks.
+     */
+    void createStore(const std::string& path, std::size_t n) {
+        std::filesystem::remove(path);
+        std::filesystem::remove(path + ".log");
+        TaskManager manager(path);
+        manager.setDurability(Durability::NONE);
+        manager.loadTasksFromStore();
+        for(std::size_t i = 2; i <= n; ++i) {
+            manager.emplaceTask(static_cast<int>(i), "Synthetic task " + std::to_string(i), TaskStatus::TODO,
+                                1'700'000'000, 1'700'000'000);
+        }
+        manager.compactStore();
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000;
+    const int mutations = argc > 2 ? std::atoi(argv[2]) : 200;
+    const std::filesystem::path directory = argc > 3 ? std::filesystem::path(argv[3])
+                                                     : std::filesystem::temp_directory_path() / "durability-bench";
+    std::filesystem::create_directories(directory);
+    const std::string store = (directory / "tasks.json").string();
+
+    std::cout << "Tasks: " << n << ", mutations per run: " << mutations << ", directory: " << directory.string() << std::endl;
+    std::cout << std::left << std::setw(10) << "mode" << std::setw(12) << "durability" << std::right
+              << std::setw(12) << "mean us" << std::setw(12) << "p50 us" << std::setw(12) << "p99 us" << std::endl;
+
+    for(StoreMode mode : {StoreMode::SNAPSHOT, StoreMode::JOURNAL}) {
+        for(Durability durability : {Durability::NONE, Durability::FSYNC_DATA, Durability::FSYNC_FULL}) {
+            createStore(store, n);
+            TaskManager manager(store);
+            manager.setStoreMode(mode);
+            manager.setDurability(durability);
+            manager.setJournalCompactionThreshold(UINTMAX_MAX);
+            manager.loadTasksFromStore();
+
+            std::vector<double> latencies;
+            latencies.reserve(static_cast<std::size_t>(mutations));
+            for(int i = 0; i < mutations; ++i) {
+                int id = 1 + static_cast<int>(static_cast<std::size_t>(i) % n);
+                TaskStatus status = i % 2 == 0 ? TaskStatus::DONE : TaskStatus::IN_PROGRESS;
+                auto start = std::chrono::steady_clock::now();
+                manager.setStatus(id, status, 1'700'000'000 + i);
+                manager.saveTasksToStore();
+                latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+            }
+
+            std::sort(latencies.begin(), latencies.end());
+            double mean = 0;
+            for(double latency : latencies) mean += latency;
+            mean /= static_cast<double>(latencies.size());
+            std::cout << std::left << std::setw(10) << (mode == StoreMode::SNAPSHOT ? "snapshot" : "journal")
+                      << std::setw(12) << durabilityName(durability) << std::right << std::fixed << std::setprecision(1)
+                      << std::setw(12) << mean
+                      << std::setw(12) << latencies[latencies.size() / 2]
+                      << std::setw(12) << latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)] << std::endl;
+        }
+    }
+
+    for(const char* suffix : {"", ".log", ".idx"}) std::filesystem::remove(store + suffix);
+    if(argc <= 3) std::filesystem::remove(directory);
+    return 0;
+}
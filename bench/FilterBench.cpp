@@ -0,0 +1,140 @@
+#include "core/FilterKernels.h"
+#include "core/TaskTable.h"
+#include <bit>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+
+/**
+ * @file FilterBench.cpp
+ * @brief Microbenchmark comparing the FilterKernels with the per-task map filtering loop.
+ *
+ * Usage: filter-bench [tasks] [repetitions]
+ *
+ * Builds a synthetic set of tasks both as a std::map<int, Task> and as a TaskTable, then times:
+ * the original `task.getStatus() != statusFilter` loop over the map, and the status, updatedAt
+ * range and combined kernels at every instruction set the CPU supports. Each measurement
+ * reports the best of several repetitions. Exits with 1 if any kernel disagrees with the loop.
+ */
+
+namespace {
+
+    /**
+     * @brief Runs a callable several times and returns the fastest run in nanoseconds.
+     */
+    template<typename F>
+    double bestOf(int repetitions, F&& run) {
+        double best = 0;
+        for(int i = 0; i < repetitions; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            run();
+            double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            if(i == 0 || elapsed < best) best = elapsed;
+        }
+        return best;
+    }
+
+    /**
+     * @brief Counts the set bits of a bitmap.
+     */
+    std::size_t popcount(const std::vector<std::uint64_t>& bitmap) {
+        std::size_t count = 0;
+        for(std::uint64_t word : bitmap) count += static_cast<std::size_t>(std::popcount(word));
+        return count;
+    }
+
+    /**
+     * @brief Prints one result row.
+     */
+    void report(const std::string& name, double nanos, std::size_t n, double baseline) {
+        std::cout << std::left << std::setw(28) << name << std::right
+                  << std::setw(10) << std::fixed << std::setprecision(3) << nanos / n << " ns/task"
+                  << std::setw(10) << std::setprecision(1) << baseline / nanos << "x" << std::endl;
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    const int repetitions = argc > 2 ? std::atoi(argv[2]) : 10;
+    const std::time_t now = 1'700'000'000;
+
+    std::mt19937_64 random(42);
+    std::map<int, Task> tasks;
+    TaskTable table;
+    table.reserve(n);
+    // The kernels run over whole columns; the table keeps its columns in chunks
+    std::vector<std::uint8_t> statuses;
+    std::vector<std::int64_t> updatedAts;
+    statuses.reserve(n);
+    updatedAts.reserve(n);
+    for(std::size_t i = 0; i < n; ++i) {
+        auto status = static_cast<TaskStatus>(random() % 3);
+        std::time_t updatedAt = now - static_cast<std::time_t>(random() % (86400 * 365));
+        Task task(static_cast<int>(i + 1), "Synthetic task " + std::to_string(i), status, updatedAt, updatedAt);
+        table.append(task);
+        statuses.push_back(static_cast<std::uint8_t>(status));
+        updatedAts.push_back(updatedAt);
+        tasks.emplace_hint(tasks.end(), task.getId(), std::move(task));
+    }
+
+    const TaskStatus wanted = TaskStatus::DONE;
+    const std::time_t from = now - 86400 * 30, until = now;
+    std::size_t expectedStatus = 0, expectedCombined = 0;
+    double baseline = bestOf(repetitions, [&] {
+        expectedStatus = 0;
+        for(const auto& [id, task] : tasks) {
+            if(task.getStatus() != wanted) continue;
+            ++expectedStatus;
+        }
+    });
+    for(const auto& [id, task] : tasks) {
+        if(task.getStatus() == wanted && task.getUpdatedAt() >= from && task.getUpdatedAt() < until) ++expectedCombined;
+    }
+
+    std::cout << "tasks: " << n << ", repetitions: " << repetitions
+              << ", best isa: " << FilterKernels::isaName(FilterKernels::bestSupportedIsa()) << std::endl;
+    report("map loop (status)", baseline, n, baseline);
+
+    const std::size_t words = FilterKernels::bitmapWords(n);
+    std::vector<std::uint64_t> bitmap(words), scratch(words);
+    bool consistent = true;
+    for(auto isa : {FilterKernels::Isa::SCALAR, FilterKernels::Isa::SSE2, FilterKernels::Isa::AVX2}) {
+        if(isa > FilterKernels::bestSupportedIsa()) continue;
+        FilterKernels::setIsa(isa);
+        std::string suffix = std::string(" [") + FilterKernels::isaName(isa) + "]";
+
+        double status = bestOf(repetitions, [&] {
+            FilterKernels::statusEquals(statuses.data(), n, static_cast<std::uint8_t>(wanted), bitmap.data());
+        });
+        consistent &= popcount(bitmap) == expectedStatus;
+        report("status ==" + suffix, status, n, baseline);
+
+        double range = bestOf(repetitions, [&] {
+            FilterKernels::inRange(updatedAts.data(), n, from, until, scratch.data());
+        });
+        report("updatedAt in range" + suffix, range, n, baseline);
+
+        double combined = bestOf(repetitions, [&] {
+            FilterKernels::statusEquals(statuses.data(), n, static_cast<std::uint8_t>(wanted), bitmap.data());
+            FilterKernels::inRange(updatedAts.data(), n, from, until, scratch.data());
+            FilterKernels::andBitmaps(bitmap.data(), scratch.data(), words);
+        });
+        consistent &= popcount(bitmap) == expectedCombined;
+        report("status && range" + suffix, combined, n, baseline);
+
+        std::vector<std::size_t> rows;
+        double select = bestOf(repetitions, [&] { rows = table.select({wanted, std::nullopt, std::nullopt}); });
+        consistent &= rows.size() == expectedStatus;
+        report("TaskTable::select" + suffix, select, n, baseline);
+    }
+
+    if(!consistent) {
+        std::cerr << "Kernel results disagree with the map loop" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include "core/TaskManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file LoadBench.cpp
+ * @brief Measures how loadTasksFromStore scales with the number of parsing threads.
+ *
+ * Usage: load-bench [tasks] [repetitions] [max threads]
+ *
+ * Writes a JSON store with the given number of tasks (1,000,000 by default) under the system
+ * temp directory, then loads it with 1, 2, 4, ... threads up to the maximum (one per CPU by
+ * default) and reports the best load time, throughput and speedup over one thread. Every load
+ * is checked to produce exactly the tasks of the single-threaded load.
+ */
+
+namespace {
+
+    /**
+     * @brief Writes a fresh JSON store with n synthetic tasks.
+     */
+    void createStore(const std::string& path, std::size_t n) {
+        for(const char* suffix : {"", ".log", ".idx", ".fts", ".lock"}) std::filesystem::remove(path + suffix);
+        TaskManager manager(path);
+        manager.setDurability(Durability::NONE);
+        manager.loadTasksFromStore();
+        manager.removeTask(1);
+        for(std::size_t i = 1; i <= n; ++i) {
+            TaskStatus status = i % 3 == 0 ? TaskStatus::DONE : i % 3 == 1 ? TaskStatus::TODO : TaskStatus::IN_PROGRESS;
+            std::string description = "Task " + std::to_string(i) + " \"review\" the quarterly report, then email the client";
+            manager.emplaceTask(static_cast<int>(i), description, status, 1'700'000'000 + static_cast<std::time_t>(i),
+                                1'700'000'000 + static_cast<std::time_t>(i) * 2);
+        }
+        manager.compactStore();
+    }
+
+    /**
+     * @brief Checks that two loads produced the same tasks.
+     */
+    bool sameTasks(const TaskMap& a, const TaskMap& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const auto& x, const auto& y) {
+            return x.first == y.first && x.second.toJSON() == y.second.toJSON();
+        });
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    const int repetitions = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+    const std::size_t maxThreads = argc > 3 ? std::strtoull(argv[3], nullptr, 10)
+                                            : std::max(1u, std::thread::hardware_concurrency());
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "load-bench";
+    std::filesystem::create_directories(directory);
+    const std::string store = (directory / "tasks.json").string();
+    createStore(store, n);
+    const double megabytes = static_cast<double>(std::filesystem::file_size(store)) / (1024 * 1024);
+
+    std::cout << "Tasks: " << n << ", store: " << std::fixed << std::setprecision(1) << megabytes << " MiB"
+              << ", parallel threshold: " << TaskManager::PARALLEL_LOAD_THRESHOLD / (1024 * 1024) << " MiB" << std::endl;
+    std::cout << std::left << std::setw(10) << "threads" << std::right << std::setw(12) << "ms"
+              << std::setw(12) << "MiB/s" << std::setw(12) << "speedup" << std::endl;
+
+    TaskManager reference(store);
+    reference.setLoadThreads(1);
+    reference.loadTasksFromStore();
+
+    std::vector<std::size_t> counts;
+    for(std::size_t threads = 1; threads < maxThreads; threads *= 2) counts.push_back(threads);
+    counts.push_back(std::max<std::size_t>(1, maxThreads));
+
+    double single = 0;
+    int failures = 0;
+    for(std::size_t threads : counts) {
+        double best = 0;
+        for(int i = 0; i < repetitions; ++i) {
+            TaskManager manager(store);
+            manager.setLoadThreads(threads);
+            auto start = std::chrono::steady_clock::now();
+            manager.loadTasksFromStore();
+            double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if(i == 0 || elapsed < best) best = elapsed;
+            if(i == 0 && !sameTasks(manager.getTasks(), reference.getTasks())) {
+                std::cerr << "Load with " << threads << " threads differs from the single-threaded load" << std::endl;
+                ++failures;
+            }
+        }
+        if(threads == 1) single = best;
+        std::cout << std::left << std::setw(10) << threads << std::right << std::setw(12) << std::setprecision(1) << best
+                  << std::setw(12) << megabytes / (best / 1000) << std::setw(11) << std::setprecision(2) << single / best
+                  << "x" << std::endl;
+    }
+
+    for(const char* suffix : {"", ".log", ".idx", ".fts", ".lock"}) std::filesystem::remove(store + suffix);
+    std::filesystem::remove(directory);
+    return failures == 0 ? 0 : 1;
+}
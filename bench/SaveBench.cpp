@@ -0,0 +1,97 @@
+#include "core/TaskManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file SaveBench.cpp
+ * @brief Measures how JSON snapshot saves scale with the number of encoding threads.
+ *
+ * Usage: save-bench [tasks] [repetitions] [max threads]
+ *
+ * Builds a store with the given number of tasks (1,000,000 by default) under the system temp
+ * directory, then writes full snapshots (compactStore) with 1, 2, 4, ... threads up to the
+ * maximum (one per CPU by default) and reports the best save time, throughput and speedup over
+ * one thread. Every snapshot is checked to be byte-identical to the single-threaded one.
+ */
+
+namespace {
+
+    /**
+     * @brief Reads a whole file.
+     */
+    std::string readFile(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    const int repetitions = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+    const std::size_t maxThreads = argc > 3 ? std::strtoull(argv[3], nullptr, 10)
+                                            : std::max(1u, std::thread::hardware_concurrency());
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "save-bench";
+    std::filesystem::create_directories(directory);
+    const std::string store = (directory / "tasks.json").string();
+    for(const char* suffix : {"", ".log", ".idx", ".fts", ".lock"}) std::filesystem::remove(store + suffix);
+
+    TaskManager manager(store);
+    manager.setDurability(Durability::NONE);
+    manager.loadTasksFromStore();
+    manager.removeTask(1);
+    for(std::size_t i = 1; i <= n; ++i) {
+        TaskStatus status = i % 3 == 0 ? TaskStatus::DONE : i % 3 == 1 ? TaskStatus::TODO : TaskStatus::IN_PROGRESS;
+        std::string description = "Task " + std::to_string(i) + " \"review\" the quarterly report,\tthen email the client";
+        manager.emplaceTask(static_cast<int>(i), description, status, 1'700'000'000 + static_cast<std::time_t>(i),
+                            1'700'000'000 + static_cast<std::time_t>(i) * 2);
+    }
+    manager.setSaveThreads(1);
+    manager.compactStore();
+    const std::string reference = readFile(store);
+    const double megabytes = static_cast<double>(reference.size()) / (1024 * 1024);
+
+    std::cout << "Tasks: " << n << ", store: " << std::fixed << std::setprecision(1) << megabytes << " MiB"
+              << ", parallel threshold: " << TaskManager::PARALLEL_SAVE_THRESHOLD << " tasks" << std::endl;
+    std::cout << std::left << std::setw(10) << "threads" << std::right << std::setw(12) << "ms"
+              << std::setw(12) << "MiB/s" << std::setw(12) << "speedup" << std::endl;
+
+    std::vector<std::size_t> counts;
+    for(std::size_t threads = 1; threads < maxThreads; threads *= 2) counts.push_back(threads);
+    counts.push_back(std::max<std::size_t>(1, maxThreads));
+
+    double single = 0;
+    int failures = 0;
+    for(std::size_t threads : counts) {
+        manager.setSaveThreads(threads);
+        double best = 0;
+        for(int i = 0; i < repetitions; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            manager.compactStore();
+            double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if(i == 0 || elapsed < best) best = elapsed;
+        }
+        if(readFile(store) != reference) {
+            std::cerr << "Snapshot written with " << threads << " threads differs from the single-threaded one" << std::endl;
+            ++failures;
+        }
+        if(threads == 1) single = best;
+        std::cout << std::left << std::setw(10) << threads << std::right << std::setw(12) << std::setprecision(1) << best
+                  << std::setw(12) << megabytes / (best / 1000) << std::setw(11) << std::setprecision(2) << single / best
+                  << "x" << std::endl;
+    }
+
+    for(const char* suffix : {"", ".log", ".idx", ".fts", ".lock"}) std::filesystem::remove(store + suffix);
+    std::filesystem::remove(directory);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,323 @@
+#include "cli/Commands.h"
+#include "core/JsonReader.h"
+#include "core/TaskManager.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @file TaskBench.cpp
+ * @brief Store-level benchmark suite with machine-readable output and baseline comparison.
+ *
+ * Usage: task-bench [--tasks 1000,10000,100000] [--description-length 48] [--status-mix 60,20,20]
+ *                   [--repetitions 5] [--json <file>] [--baseline <file>] [--tolerance 10]
+ *
+ * For every task count, generates a synthetic JSON store under the system temp directory with
+ * descriptions of about the given length and the given todo,in-progress,done percentages, then
+ * times loadTasksFromStore, saveTasksToStore after a status change, findTaskById, `list done`
+ * (through the manager's indexes and through a table snapshot, as the daemon runs it), and
+ * Task::toJSON and Task::toString over every task. Each measurement reports the best of the
+ * repetitions.
+ *
+ * --json writes the results as {"benchmarks": [{"name", "tasks", "ns_per_op"}, ...]}. --baseline
+ * reads such a file and prints the change of every measurement it also contains; the exit code
+ * is 1 if any of them got slower by more than the tolerance (in percent).
+ */
+
+namespace {
+
+    /**
+     * @brief One measurement.
+     */
+    struct Result {
+        std::string name;  ///< What was measured.
+        std::size_t tasks; ///< Size of the store.
+        double nsPerOp;    ///< Best time of one operation in nanoseconds.
+    };
+
+    /**
+     * @brief Runs a callable several times and returns the fastest run in nanoseconds.
+     */
+    template<typename F>
+    double bestOf(int repetitions, F&& run) {
+        double best = 0;
+        for(int i = 0; i < repetitions; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            run();
+            double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            if(i == 0 || elapsed < best) best = elapsed;
+        }
+        return best;
+    }
+
+    /**
+     * @brief Parses a comma-separated list of numbers.
+     */
+    std::vector<std::size_t> parseList(const std::string& text) {
+        std::vector<std::size_t> values;
+        std::istringstream in(text);
+        for(std::string item; std::getline(in, item, ',');) values.push_back(std::strtoull(item.c_str(), nullptr, 10));
+        return values;
+    }
+
+    /**
+     * @brief Writes a fresh JSON store with n synthetic tasks.
+     * @param path The store file; its journal, indexes and lock are removed first.
+     * @param n The number of tasks.
+     * @param descriptionLength The approximate length of every description.
+     * @param mix The todo, in-progress and done percentages.
+     * @note Deterministic for the same arguments. Tasks are created over a year and updated at a
+     *       random later time, so update time ranges select a realistic share of them.
+     */
+    void createStore(const std::string& path, std::size_t n, std::size_t descriptionLength, const std::vector<std::size_t>& mix) {
+        for(const char* suffix : {"", ".log", ".idx", ".fts", ".lock"}) std::filesystem::remove(path + suffix);
+
+        static const char* const words[] = {"review", "report", "email", "client", "meeting", "draft", "budget",
+                                            "deploy", "fix", "server", "plan", "invoice", "call", "update", "design"};
+        std::mt19937 random(42);
+        std::uniform_int_distribution<std::size_t> word(0, std::size(words) - 1);
+        std::uniform_int_distribution<std::size_t> percent(0, 99);
+        std::uniform_int_distribution<std::time_t> age(0, 365 * 24 * 3600);
+
+        TaskManager manager(path);
+        manager.setDurability(Durability::NONE);
+        manager.loadTasksFromStore();
+        manager.removeTask(1);
+        std::string description;
+        for(std::size_t i = 1; i <= n; ++i) {
+            description = "Task " + std::to_string(i);
+            while(description.size() < descriptionLength) {
+                description += ' ';
+                description += words[word(random)];
+            }
+
+            std::size_t roll = percent(random);
+            TaskStatus status = roll < mix[0] ? TaskStatus::TODO
+                              : roll < mix[0] + mix[1] ? TaskStatus::IN_PROGRESS : TaskStatus::DONE;
+            std::time_t createdAt = 1'700'000'000 + static_cast<std::time_t>(i) * 365 * 24 * 3600 / static_cast<std::time_t>(n);
+            manager.emplaceTask(static_cast<int>(i), description, status, createdAt, createdAt + age(random) / 4);
+        }
+        manager.compactStore();
+    }
+
+    /**
+     * @brief Runs a CLI command against a manager, discarding its output.
+     */
+    void runQuiet(const std::function<int(int, char**)>& command, std::vector<std::string> arguments) {
+        std::vector<char*> argv;
+        for(std::string& argument : arguments) argv.push_back(argument.data());
+        std::ostringstream out, err;
+        CLI::OutputScope scope(out, err);
+        command(static_cast<int>(argv.size()), argv.data());
+    }
+
+    /**
+     * @brief Runs every benchmark on one store.
+     */
+    void benchmarkStore(const std::string& store, std::size_t n, int repetitions, std::vector<Result>& results) {
+        results.push_back({"load", n, bestOf(repetitions, [&] {
+            TaskManager manager(store);
+            manager.loadTasksFromStore();
+        })});
+
+        TaskManager manager(store);
+        manager.setDurability(Durability::NONE);
+        manager.loadTasksFromStore();
+        std::mt19937 random(7);
+        std::uniform_int_distribution<int> anyTask(1, static_cast<int>(n));
+
+        int flip = 0;
+        results.push_back({"save", n, bestOf(repetitions, [&] {
+            ++flip;
+            manager.setStatus(anyTask(random), flip % 2 ? TaskStatus::DONE : TaskStatus::TODO, 1'800'000'000 + flip);
+            manager.saveTasksToStore();
+        })});
+
+        constexpr std::size_t lookups = 100'000;
+        std::vector<int> ids(lookups);
+        for(int& id : ids) id = anyTask(random);
+        std::size_t found = 0;
+        results.push_back({"find", n, bestOf(repetitions, [&] {
+            for(int id : ids) found += manager.findTaskById(id).has_value();
+        }) / lookups});
+
+        runQuiet([&](int argc, char** argv) { return CLI::list(manager, argc, argv); }, {"task-cli", "list", "done"});
+        results.push_back({"list-done", n, bestOf(repetitions, [&] {
+            runQuiet([&](int argc, char** argv) { return CLI::list(manager, argc, argv); }, {"task-cli", "list", "done"});
+        })});
+
+        const TaskTable& table = manager.getTable();
+        results.push_back({"list-done-snapshot", n, bestOf(repetitions, [&] {
+            runQuiet([&](int argc, char** argv) { return CLI::list(table, argc, argv); }, {"task-cli", "list", "done"});
+        })});
+
+        std::size_t bytes = 0;
+        results.push_back({"to-json", n, bestOf(repetitions, [&] {
+            for(const auto& [id, task] : manager.getTasks()) bytes += task.toJSON().size();
+        }) / static_cast<double>(n)});
+        results.push_back({"to-string", n, bestOf(repetitions, [&] {
+            for(const auto& [id, task] : manager.getTasks()) bytes += task.toString().size();
+        }) / static_cast<double>(n)});
+
+        if(found == 0 || bytes == 0) std::cerr << "Benchmark produced no work" << std::endl;
+    }
+
+    /**
+     * @brief Writes results as JSON.
+     */
+    void writeJson(const std::string& path, const std::vector<Result>& results) {
+        std::ofstream out(path);
+        out << "{\"benchmarks\": [";
+        for(std::size_t i = 0; i < results.size(); ++i) {
+            out << (i == 0 ? "\n" : ",\n") << "  {\"name\": \"" << results[i].name << "\", \"tasks\": " << results[i].tasks
+                << ", \"ns_per_op\": " << std::fixed << std::setprecision(1) << results[i].nsPerOp << "}";
+        }
+        out << "\n]}\n";
+    }
+
+    /**
+     * @brief Reads results written by writeJson().
+     * @return The time per operation of every (name, tasks) pair.
+     * @throws std::runtime_error If the file is not valid.
+     */
+    std::map<std::pair<std::string, std::size_t>, double> readJson(const std::string& path) {
+        std::ifstream in(path);
+        if(!in) throw std::runtime_error("Failed to open baseline: " + path);
+        std::string json((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+        std::map<std::pair<std::string, std::size_t>, double> baseline;
+        JsonReader reader(json);
+        std::string key, name;
+        reader.expect('{');
+        while(!reader.consume('}')) {
+            reader.readString(key);
+            reader.expect(':');
+            if(key != "benchmarks") {
+                reader.skipValue();
+            } else {
+                reader.expect('[');
+                while(!reader.consume(']')) {
+                    Result result{};
+                    reader.expect('{');
+                    while(!reader.consume('}')) {
+                        reader.readString(key);
+                        reader.expect(':');
+                        if(key == "name") {
+                            reader.readString(result.name);
+                        } else if(key == "tasks") {
+                            result.tasks = static_cast<std::size_t>(reader.readInteger());
+                        } else if(key == "ns_per_op") {
+                            reader.peek();
+                            std::size_t start = reader.position();
+                            reader.skipValue();
+                            result.nsPerOp = std::strtod(json.c_str() + start, nullptr);
+                        } else {
+                            reader.skipValue();
+                        }
+                        reader.consume(',');
+                    }
+                    baseline[{result.name, result.tasks}] = result.nsPerOp;
+                    reader.consume(',');
+                }
+            }
+            reader.consume(',');
+        }
+        return baseline;
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::size_t> sizes = {1'000, 10'000, 100'000};
+    std::size_t descriptionLength = 48;
+    std::vector<std::size_t> mix = {60, 20, 20};
+    int repetitions = 5;
+    std::string jsonPath, baselinePath;
+    double tolerance = 10;
+    for(int i = 1; i + 1 < argc; i += 2) {
+        std::string option = argv[i], value = argv[i + 1];
+        if(option == "--tasks") sizes = parseList(value);
+        else if(option == "--description-length") descriptionLength = std::strtoull(value.c_str(), nullptr, 10);
+        else if(option == "--status-mix") mix = parseList(value);
+        else if(option == "--repetitions") repetitions = std::max(1, std::atoi(value.c_str()));
+        else if(option == "--json") jsonPath = value;
+        else if(option == "--baseline") baselinePath = value;
+        else if(option == "--tolerance") tolerance = std::strtod(value.c_str(), nullptr);
+        else {
+            std::cerr << "Unknown option: " << option << std::endl;
+            return 1;
+        }
+    }
+    if(argc % 2 == 0) {
+        std::cerr << "Missing value for " << argv[argc - 1] << std::endl;
+        return 1;
+    }
+    if(mix.size() != 3 || mix[0] + mix[1] + mix[2] != 100) {
+        std::cerr << "--status-mix needs three percentages (todo,in-progress,done) adding up to 100" << std::endl;
+        return 1;
+    }
+
+    std::map<std::pair<std::string, std::size_t>, double> baseline;
+    if(!baselinePath.empty()) {
+        try {
+            baseline = readJson(baselinePath);
+        } catch(const std::exception& e) {
+            std::cerr << "Error reading baseline: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "task-bench";
+    std::filesystem::create_directories(directory);
+    const std::string store = (directory / "tasks.json").string();
+
+    std::cout << "Description length: " << descriptionLength << ", status mix: " << mix[0] << "/" << mix[1] << "/" << mix[2]
+              << " (todo/in-progress/done), repetitions: " << repetitions << std::endl;
+    std::cout << std::left << std::setw(20) << "benchmark" << std::right << std::setw(10) << "tasks"
+              << std::setw(16) << "ns/op" << (baseline.empty() ? "" : "    vs baseline") << std::endl;
+
+    std::vector<Result> results;
+    int regressions = 0;
+    for(std::size_t n : sizes) {
+        if(n == 0) continue;
+        createStore(store, n, descriptionLength, mix);
+        std::size_t first = results.size();
+        benchmarkStore(store, n, repetitions, results);
+
+        for(std::size_t i = first; i < results.size(); ++i) {
+            const Result& result = results[i];
+            std::cout << std::left << std::setw(20) << result.name << std::right << std::setw(10) << result.tasks
+                      << std::setw(16) << std::fixed << std::setprecision(1) << result.nsPerOp;
+            if(auto it = baseline.find({result.name, result.tasks}); it != baseline.end() && it->second > 0) {
+                double change = (result.nsPerOp / it->second - 1) * 100;
+                std::cout << std::setw(14) << std::showpos << std::setprecision(1) << change << "%" << std::noshowpos;
+                if(change > tolerance) {
+                    std::cout << "  REGRESSION";
+                    ++regressions;
+                }
+            }
+            std::cout << std::endl;
+        }
+    }
+
+    for(const char* suffix : {"", ".log", ".idx", ".fts", ".lock"}) std::filesystem::remove(store + suffix);
+    std::filesystem::remove(directory);
+
+    if(!jsonPath.empty()) writeJson(jsonPath, results);
+    if(regressions > 0) {
+        std::cout << regressions << " measurement(s) slower than the baseline by more than " << tolerance << "%" << std::endl;
+        return 1;
+    }
+    return 0;
+}
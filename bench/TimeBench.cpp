@@ -0,0 +1,110 @@
+#include "core/Task.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * @file TimeBench.cpp
+ * @brief Compares Task::formatTime with the localtime_r + std::put_time implementation it replaced.
+ *
+ * Usage: time-bench [calls] [repetitions]
+ *
+ * Formats the given number of timestamps (1,000,000 by default, spread over a year like the
+ * tasks of a real store) with both implementations and reports the best time per call, then
+ * times Task::toString on the same number of tasks. Before timing, both implementations are
+ * compared on every quarter hour of two years and on random times from 1900 to 2200, so
+ * daylight saving transitions of the local time zone (set TZ to try others) are covered.
+ */
+
+namespace {
+
+    /**
+     * @brief The previous Task::formatTime.
+     */
+    std::string legacyFormatTime(std::time_t time) {
+        std::tm localTime{};
+#if defined(_WIN32)
+        localtime_s(&localTime, &time);
+#else
+        localtime_r(&time, &localTime);
+#endif
+        std::ostringstream oss;
+        oss << std::put_time(&localTime, "%Y/%m/%d %H:%M:%S");
+        return oss.str();
+    }
+
+    /**
+     * @brief Runs a callable several times and returns the fastest run in nanoseconds.
+     */
+    template<typename F>
+    double bestOf(int repetitions, F&& run) {
+        double best = 0;
+        for(int i = 0; i < repetitions; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            run();
+            double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            if(i == 0 || elapsed < best) best = elapsed;
+        }
+        return best;
+    }
+
+}
+
+int main(int argc, char* argv[]) {
+    const std::size_t calls = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    const int repetitions = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+
+    // Correctness first: every quarter hour of 2024-2025, then random times over three centuries
+    std::size_t mismatches = 0, checked = 0;
+    auto check = [&](std::time_t time) {
+        ++checked;
+        if(Task::formatTime(time) == legacyFormatTime(time)) return;
+        if(++mismatches <= 5) {
+            std::cerr << "Mismatch at " << time << ": " << Task::formatTime(time) << " vs " << legacyFormatTime(time) << std::endl;
+        }
+    };
+    for(std::time_t time = 1'704'067'200; time < 1'767'225'600; time += 900) check(time);
+    std::mt19937_64 random(42);
+    std::uniform_int_distribution<std::time_t> anyTime(-2'208'988'800, 7'258'118'400);
+    for(int i = 0; i < 200'000; ++i) check(anyTime(random));
+    std::cout << "Checked " << checked << " timestamps, " << mismatches << " mismatches" << std::endl;
+
+    std::uniform_int_distribution<std::time_t> lastYear(1'700'000'000, 1'700'000'000 + 365 * 24 * 3600);
+    std::vector<std::time_t> times(calls);
+    for(std::time_t& time : times) time = lastYear(random);
+
+    std::size_t bytes = 0;
+    double legacy = bestOf(repetitions, [&] {
+        for(std::time_t time : times) bytes += legacyFormatTime(time).size();
+    }) / static_cast<double>(calls);
+    double string = bestOf(repetitions, [&] {
+        for(std::time_t time : times) bytes += Task::formatTime(time).size();
+    }) / static_cast<double>(calls);
+    double buffer = bestOf(repetitions, [&] {
+        char text[Task::TIME_BUFFER_SIZE];
+        for(std::time_t time : times) bytes += Task::formatTime(time, text);
+    }) / static_cast<double>(calls);
+
+    std::vector<Task> tasks;
+    tasks.reserve(calls);
+    for(std::size_t i = 0; i < calls; ++i) {
+        tasks.emplace_back(static_cast<int>(i + 1), "Review the quarterly report", TaskStatus::TODO, times[i], times[i] + 3600);
+    }
+    double toString = bestOf(repetitions, [&] {
+        for(const Task& task : tasks) bytes += task.toString().size();
+    }) / static_cast<double>(calls);
+
+    std::cout << std::left << std::setw(34) << "benchmark" << std::right << std::setw(12) << "ns/call" << std::endl;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << std::left << std::setw(34) << "localtime_r + put_time (previous)" << std::right << std::setw(12) << legacy << std::endl;
+    std::cout << std::left << std::setw(34) << "formatTime -> std::string" << std::right << std::setw(12) << string << std::endl;
+    std::cout << std::left << std::setw(34) << "formatTime -> buffer" << std::right << std::setw(12) << buffer << std::endl;
+    std::cout << std::left << std::setw(34) << "Task::toString" << std::right << std::setw(12) << toString << std::endl;
+    if(bytes == 0) std::cerr << "Benchmark produced no work" << std::endl;
+    return mismatches == 0 ? 0 : 1;
+}
@@ -2,6 +2,7 @@
 #define COMMANDS_H
 
 #include "core/TaskManager.h"
+#include <ostream>
 
 /**
  * @namespace CLI
@@ -13,6 +14,47 @@
  */
 namespace CLI{
 
+    /**
+     * @class OutputScope
+     * @brief Redirects what CLI commands print on the calling thread while it is alive.
+     *
+     * Commands print through out() and err(), which default to std::cout and std::cerr. The
+     * daemon runs commands on several threads at once and captures each one's output this way.
+     */
+    class OutputScope {
+    private:
+        std::ostream* previousOut; ///< Output stream restored on destruction.
+        std::ostream* previousErr; ///< Error stream restored on destruction.
+    public:
+
+        /**
+         * @brief Redirects command output on the calling thread.
+         * @param out The stream receiving results.
+         * @param err The stream receiving errors and usage messages.
+         */
+        OutputScope(std::ostream& out, std::ostream& err);
+
+        /**
+         * @brief Restores the streams that were active before this scope.
+         */
+        ~OutputScope();
+
+        OutputScope(const OutputScope&) = delete;
+        OutputScope& operator=(const OutputScope&) = delete;
+    };
+
+    /**
+     * @brief Gets the stream commands on the calling thread print results to.
+     * @return std::cout unless redirected by an OutputScope.
+     */
+    std::ostream& out();
+
+    /**
+     * @brief Gets the stream commands on the calling thread print errors to.
+     * @return std::cerr unless redirected by an OutputScope.
+     */
+    std::ostream& err();
+
     /**
      * @brief Adds a new task to the TaskManager.
      * @param manager The TaskManager instance to modify.
@@ -37,9 +79,20 @@ namespace CLI{
      * @param argc The number of command-line arguments.
      * @param argv The array of command-line arguments (expects ID at argv[2]).
      * @return 0 on success, 1 on failure (e.g., insufficient arguments or task not found).
+     * @note Only marks the task as deleted, so it can be restored until the store is compacted.
      */
     int deleteTask(TaskManager& manager, int argc, char* argv[]);
 
+    /**
+     * @brief Brings back a deleted task.
+     * @param manager The TaskManager instance to modify.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (expects ID at argv[2], optionally followed
+     *             by the status to restore, todo by default).
+     * @return 0 on success, 1 on failure (e.g., invalid status, or no deleted task with that ID).
+     */
+    int restore(TaskManager& manager, int argc, char* argv[]);
+
     /**
      * @brief Changes the status of an existing task in the TaskManager.
      * @param manager The TaskManager instance to modify.
@@ -54,10 +107,103 @@ namespace CLI{
      * @brief Lists tasks from the TaskManager, optionally filtered by status.
      * @param manager The TaskManager instance to query.
      * @param argc The number of command-line arguments.
-     * @param argv The array of command-line arguments (optional status filter at argv[2]).
-     * @return 0 on success, 1 on failure (e.g., invalid status filter).
+     * @param argv The array of command-line arguments (optional status filter at argv[2], then
+     *             --since <time>, --until <time>, --sort id|updated|recent, --limit <n>,
+     *             --offset <n>, --after <cursor> and --format human|jsonl|tsv).
+     * @return 0 on success, 1 on failure (e.g., invalid status filter or option).
      */
     int list(TaskManager& manager, int argc, char* argv[]);
+
+    /**
+     * @brief Lists tasks from a table, with the same arguments as list() on a TaskManager.
+     * @param table The tasks to query.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (optional status filter at argv[2], then options).
+     * @return 0 on success, 1 on failure (e.g., invalid status filter or option).
+     */
+    int list(const TaskTable& table, int argc, char* argv[]);
+
+    /**
+     * @brief Prints the tasks whose descriptions match a full-text query.
+     * @param manager The TaskManager instance to query.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (query words from argv[2] on).
+     * @return 0 on success, 1 on failure (e.g., missing query).
+     */
+    int search(TaskManager& manager, int argc, char* argv[]);
+
+    /**
+     * @brief Converts a task store between the JSON and binary formats.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (expects source at argv[2], destination at argv[3]).
+     * @return 0 on success, 1 on failure (e.g., insufficient arguments or unreadable source).
+     */
+    int convert(int argc, char* argv[]);
+
+    /**
+     * @brief Prints memory statistics of the loaded task store.
+     * @param manager The TaskManager instance to query.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (no arguments expected).
+     * @return 0 on success.
+     */
+    int stats(TaskManager& manager, int argc, char* argv[]);
+
+    /**
+     * @brief Prints how many tasks have each status.
+     * @param manager The TaskManager instance to query.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (no arguments expected).
+     * @return 0 on success.
+     */
+    int statusStats(TaskManager& manager, int argc, char* argv[]);
+
+    /**
+     * @brief Prints how many tasks of a table have each status, like statusStats() on a TaskManager.
+     * @param table The tasks to count.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (no arguments expected).
+     * @return 0 on success.
+     */
+    int statusStats(const TaskTable& table, int argc, char* argv[]);
+
+    /**
+     * @brief Removes deleted tasks for good and rewrites the store without them.
+     * @param manager The TaskManager instance to compact.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (optionally --min-ratio <r>).
+     * @return 0 on success, 1 on failure (e.g., invalid ratio).
+     */
+    int compact(TaskManager& manager, int argc, char* argv[]);
+
+    /**
+     * @brief Applies newline-delimited commands from a file or stdin in one load/save cycle.
+     * @param manager The TaskManager instance to modify.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (optional file at argv[2], "-" for stdin,
+     *             optionally followed by --save-every <n>; or the commands themselves in one or
+     *             more --lines <text> arguments).
+     * @return 0 if every command succeeded, 1 otherwise.
+     */
+    int batch(TaskManager& manager, int argc, char* argv[]);
+
+    /**
+     * @brief Runs the command named by argv[1] against a loaded TaskManager.
+     * @param manager The TaskManager instance to operate on.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (action at argv[1]).
+     * @return The command's exit code, or 1 for an unknown action.
+     */
+    int run(TaskManager& manager, int argc, char* argv[]);
+
+    /**
+     * @brief Runs a read-only command (list or status-stats) against a table.
+     * @param table The tasks to read.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (action at argv[1]).
+     * @return The command's exit code, or 1 for an action that is not read-only.
+     */
+    int run(const TaskTable& table, int argc, char* argv[]);
 }
 
 #endif
\ No newline at end of file
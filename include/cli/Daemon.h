@@ -0,0 +1,53 @@
+#ifndef DAEMON_H
+#define DAEMON_H
+
+#include "cli/DaemonProtocol.h"
+#include "core/TaskManager.h"
+#include <optional>
+#include <string>
+
+/**
+ * @namespace Daemon
+ * @brief Keeps a TaskManager resident and serves CLI commands over a Unix domain socket.
+ *
+ * `task-cli serve` loads the store once and answers every command sent to `<store>.sock`, so a
+ * command no longer pays for process start-up, store parsing and a save of its own. Read-only
+ * commands run concurrently on an immutable snapshot of the tasks; commands that change tasks
+ * are applied by a single writer thread and answered right away, and their changes are saved
+ * together in the background a few milliseconds later. The wire format is in DaemonProtocol.h.
+ */
+namespace Daemon {
+
+    /**
+     * @brief Serves commands for a loaded TaskManager until interrupted.
+     * @param manager The TaskManager to keep resident; it must already be loaded.
+     * @param socketPath The socket to listen on.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (optionally --flush-interval <ms> and
+     *             --workers <n> from argv[2]).
+     * @return 0 after a clean shutdown, 1 if the socket cannot be set up or the final save fails.
+     * @note Pending changes are saved on SIGINT and SIGTERM before the socket is removed.
+     */
+    int serve(TaskManager& manager, const std::string& socketPath, int argc, char* argv[]);
+
+    /**
+     * @brief Runs a command through the daemon listening on the given socket, if there is one.
+     * @param socketPath The socket of the daemon.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments to forward.
+     * @return The command's exit code after printing its output, or std::nullopt if no daemon is
+     *         listening and the command should run locally.
+     * @note A batch is read here and its commands are sent along, since the daemon cannot read
+     *       the caller's files or stdin.
+     */
+    std::optional<int> forward(const std::string& socketPath, int argc, char* argv[]);
+
+    /**
+     * @brief Checks whether a daemon is listening on the given socket.
+     * @param socketPath The socket of the daemon.
+     * @return False if nothing listens there, including on platforms without the daemon.
+     */
+    bool serving(const std::string& socketPath);
+}
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef DAEMON_PROTOCOL_H
+#define DAEMON_PROTOCOL_H
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @namespace Daemon
+ * @brief Wire format spoken between `task-cli` and `task-cli serve`.
+ *
+ * A connection carries any number of requests, each answered by one response in the order the
+ * requests were sent, so a client may pipeline requests without waiting for their responses.
+ * Integers are native-endian because the client and the daemon always run on the same host.
+ * - Request: u32 argument count, then for each argument a u32 length and its bytes.
+ * - Response: i32 exit code, then the u32 length and bytes of stdout, then those of stderr.
+ */
+namespace Daemon {
+
+    /**
+     * @brief Gets the socket path a daemon serving the given store listens on.
+     * @param storeName The file path of the task store.
+     * @return The store path with a ".sock" suffix.
+     */
+    std::string socketPath(const std::string& storeName);
+
+    /**
+     * @struct Response
+     * @brief The result of one command run by the daemon.
+     */
+    struct Response {
+        std::int32_t code = 1; ///< Exit code of the command.
+        std::string out;       ///< What the command printed to stdout.
+        std::string err;       ///< What the command printed to stderr.
+    };
+
+    /**
+     * @brief Appends an encoded request to a buffer.
+     * @param out The buffer to append to.
+     * @param arguments The command-line arguments, starting with the program name.
+     */
+    void appendRequest(std::string& out, std::span<const std::string_view> arguments);
+
+    /**
+     * @brief Decodes the request at the start of a buffer.
+     * @param in The received bytes.
+     * @param arguments Receives the command-line arguments.
+     * @return The number of bytes consumed, or 0 if the request is not complete yet.
+     * @throws std::runtime_error If the request exceeds the argument count or size limits.
+     */
+    std::size_t decodeRequest(std::string_view in, std::vector<std::string>& arguments);
+
+    /**
+     * @brief Appends an encoded response to a buffer.
+     * @param out The buffer to append to.
+     * @param code The exit code of the command.
+     * @param stdoutText What the command printed to stdout.
+     * @param stderrText What the command printed to stderr.
+     */
+    void appendResponse(std::string& out, std::int32_t code, std::string_view stdoutText, std::string_view stderrText);
+
+    /**
+     * @brief Decodes the response at the start of a buffer.
+     * @param in The received bytes.
+     * @param response Receives the decoded response.
+     * @return The number of bytes consumed, or 0 if the response is not complete yet.
+     */
+    std::size_t decodeResponse(std::string_view in, Response& response);
+
+    /**
+     * @class Client
+     * @brief A connection to a daemon that can pipeline requests.
+     *
+     * send() only queues a request; flush() writes every queued request at once and receive()
+     * reads responses in the order their requests were sent.
+     */
+    class Client {
+    private:
+        int fd = -1;           ///< Connected socket, or -1.
+        std::string output;    ///< Encoded requests not yet written.
+        std::string input;     ///< Received bytes not yet decoded.
+        std::size_t inputPos = 0; ///< Offset of the first undecoded byte in input.
+    public:
+
+        /**
+         * @brief Connects to the daemon listening on a socket.
+         * @param socketPath The socket of the daemon.
+         * @note Check connected() afterwards; nothing listening is not an error.
+         */
+        explicit Client(const std::string& socketPath);
+
+        /**
+         * @brief Closes the connection.
+         */
+        ~Client();
+
+        Client(const Client&) = delete;
+        Client& operator=(const Client&) = delete;
+
+        /**
+         * @brief Checks whether a daemon accepted the connection.
+         * @return True if connected.
+         */
+        bool connected() const;
+
+        /**
+         * @brief Queues a request.
+         * @param arguments The command-line arguments, starting with the program name.
+         */
+        void send(std::span<const std::string_view> arguments);
+
+        /**
+         * @brief Writes every queued request.
+         * @return False if the connection was lost.
+         */
+        bool flush();
+
+        /**
+         * @brief Waits for the response to the oldest unanswered request.
+         * @param response Receives the response.
+         * @return False if the connection was lost.
+         */
+        bool receive(Response& response);
+    };
+}
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef TASK_PRINTER_H
+#define TASK_PRINTER_H
+
+#include "core/TaskSerializer.h"
+#include "core/TaskView.h"
+#include <optional>
+#include <ostream>
+#include <string_view>
+
+namespace CLI {
+
+    /**
+     * @enum OutputFormat
+     * @brief How commands print lists of tasks.
+     */
+    enum class OutputFormat {
+        HUMAN, ///< One Task::toString() line per task.
+        JSONL, ///< One JSON object per line, as stored in tasks.json.
+        TSV    ///< A header row, then id, status key, description and epoch timestamps separated by tabs.
+    };
+
+    /**
+     * @brief Parses the value of a --format option.
+     * @param name "human", "jsonl" or "tsv".
+     * @return The format, or std::nullopt for any other name.
+     */
+    std::optional<OutputFormat> parseOutputFormat(std::string_view name);
+
+    /**
+     * @class TaskPrinter
+     * @brief Formats tasks straight into a large buffer that is written out in big chunks.
+     *
+     * Every task is appended to a TaskSerializer buffer without temporary strings, and only the
+     * fields the format shows are formatted: timestamps are only converted to local time for
+     * OutputFormat::HUMAN. The buffer is written to the stream whenever it passes
+     * TaskSerializer::FLUSH_THRESHOLD, so memory stays bounded however many tasks are printed,
+     * and the stream is never flushed per line.
+     */
+    class TaskPrinter {
+    private:
+        std::ostream& out;         ///< Where the output goes.
+        OutputFormat format;       ///< How tasks are printed.
+        TaskSerializer buffer;     ///< Output not yet written to out.
+        std::size_t printed = 0;   ///< Tasks printed so far.
+    public:
+
+        /**
+         * @brief Starts printing tasks, writing the TSV header if needed.
+         * @param out The stream to print to.
+         * @param format How tasks are printed.
+         */
+        TaskPrinter(std::ostream& out, OutputFormat format);
+
+        /**
+         * @brief Writes whatever is still buffered.
+         */
+        ~TaskPrinter();
+
+        TaskPrinter(const TaskPrinter&) = delete;
+        TaskPrinter& operator=(const TaskPrinter&) = delete;
+
+        /**
+         * @brief Prints one task.
+         * @param task The task to print.
+         */
+        void print(const TaskView& task);
+
+        /**
+         * @brief Writes the buffered output to the stream and flushes it.
+         */
+        void flush();
+
+        /**
+         * @brief Gets the number of tasks printed.
+         * @return The number of print() calls.
+         */
+        std::size_t count() const;
+    };
+}
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef ATOMIC_FILE_H
+#define ATOMIC_FILE_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @enum Durability
+ * @brief How hard store writes push data to stable storage before returning.
+ */
+enum class Durability {
+  NONE,       ///< Writes are atomic against crashes of the process, but nothing is forced to disk.
+  FSYNC_DATA, ///< File contents are flushed to disk before they replace the old file.
+  FSYNC_FULL  ///< Contents and metadata, including the directory entry of a rename, are flushed to disk.
+};
+
+/**
+ * @class AtomicFile
+ * @brief Replaces a file atomically by writing a temporary file and renaming it over the target.
+ *
+ * Readers (and a process restarted after a crash) see either the complete old file or the
+ * complete new one, never a truncated mix. Depending on the Durability, the temporary file is
+ * fsync'ed before the rename and the containing directory after it, so the replacement also
+ * survives a power loss. If the AtomicFile is destroyed without commit(), the temporary file
+ * is removed and the target is left untouched.
+ */
+class AtomicFile {
+private:
+    std::string path;       ///< The file being replaced.
+    std::string tempPath;   ///< The temporary file receiving the new contents.
+    Durability durability;  ///< How the new contents are flushed on commit.
+    int fd = -1;            ///< Descriptor of the temporary file while it is open.
+public:
+
+    /**
+     * @brief Creates the temporary file next to the target.
+     * @param path The file to replace.
+     * @param durability How the new contents are flushed on commit.
+     * @throws std::runtime_error If the temporary file cannot be created.
+     */
+    AtomicFile(std::string path, Durability durability);
+
+    AtomicFile(const AtomicFile&) = delete;
+    AtomicFile& operator=(const AtomicFile&) = delete;
+
+    /**
+     * @brief Discards the temporary file unless commit() succeeded.
+     */
+    ~AtomicFile();
+
+    /**
+     * @brief Appends bytes to the temporary file.
+     * @param bytes The bytes to write.
+     * @throws std::runtime_error If the write fails.
+     */
+    void write(std::string_view bytes);
+
+    /**
+     * @brief Appends several buffers to the temporary file, in order.
+     * @param parts The buffers to write.
+     * @throws std::runtime_error If the write fails.
+     */
+    void write(const std::vector<std::string_view>& parts);
+
+    /**
+     * @brief Flushes the temporary file according to the durability and renames it over the target.
+     * @throws std::runtime_error If flushing or renaming fails.
+     */
+    void commit();
+
+    /**
+     * @brief Appends bytes to a file, flushing them according to the durability.
+     * @param path The file to append to; created if missing.
+     * @param bytes The bytes to append, written with a single write.
+     * @param durability How the appended bytes are flushed.
+     * @throws std::runtime_error If the file cannot be opened or written.
+     */
+    static void append(const std::string& path, std::string_view bytes, Durability durability);
+
+    /**
+     * @brief Flushes the current contents of an existing file according to the durability.
+     * @param path The file to flush.
+     * @param durability How the contents are flushed; Durability::NONE does nothing.
+     * @throws std::runtime_error If the file cannot be opened or flushed.
+     * @note Used after patching a file in place.
+     */
+    static void sync(const std::string& path, Durability durability);
+
+    /**
+     * @brief Removes a file, if it exists, flushing its directory according to the durability.
+     * @param path The file to remove.
+     * @param durability With Durability::FSYNC_FULL the removal itself is made durable.
+     * @throws std::runtime_error If the file cannot be removed or the directory cannot be flushed.
+     */
+    static void remove(const std::string& path, Durability durability);
+};
+
+#endif
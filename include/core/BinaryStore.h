@@ -0,0 +1,108 @@
+#ifndef BINARY_STORE_H
+#define BINARY_STORE_H
+
+#include "core/AtomicFile.h"
+#include "core/MappedFile.h"
+#include "core/TaskView.h"
+#include <cstdint>
+#include <map>
+#include <optional>
+
+/**
+ * @class BinaryStore
+ * @brief A compact, memory-mapped task store with a fixed-width record table.
+ *
+ * The file starts with a header, followed by one fixed-width record per task (sorted by id)
+ * and a string heap holding the descriptions:
+ *
+ *     header  : magic "TTSTORE1", version, record count, heap offset, heap size
+ *     records : id, status, createdAt, updatedAt, description offset, description length
+ *     heap    : description bytes, back to back
+ *
+ * Records are read in place through TaskView, so listing and lookups never copy descriptions.
+ * Status changes are patched directly into the mapped record. Integers are stored in native
+ * byte order; the store is meant to be read on the machine that wrote it (use `task-cli convert`
+ * to move it elsewhere as JSON).
+ */
+class BinaryStore {
+private:
+    MappedFile file; ///< The mapped store file.
+    std::uint32_t count = 0; ///< Number of records in the table.
+public:
+
+    /**
+     * @brief Checks whether a file is a binary store.
+     * @param path The file to inspect.
+     * @return True if the file exists and starts with the binary store magic.
+     */
+    static bool isBinaryStore(const std::string& path);
+
+    /**
+     * @brief Writes tasks to a new binary store file.
+     * @param path The destination file; replaced if it exists.
+     * @param tasks The tasks to write.
+     * @param durability How the new file is flushed to disk before it replaces the old one.
+     * @throws std::runtime_error If the file cannot be written.
+     * @note Writes to a temporary file and renames it over the destination, so an open
+     *       mapping of the old file stays valid.
+     */
+    static void write(const std::string& path, const TaskMap& tasks, Durability durability = Durability::NONE);
+
+    /**
+     * @brief Maps a binary store file for reading and in-place status updates.
+     * @param path The store file to open.
+     * @throws std::runtime_error If the file is missing, not a binary store, truncated, or corrupt.
+     */
+    void open(const std::string& path);
+
+    /**
+     * @brief Gets the number of tasks in the store.
+     * @return The record count.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Gets a view of the record at the given position.
+     * @param index The record index, in ascending id order.
+     * @return A view into the mapped record and its description.
+     */
+    TaskView at(std::size_t index) const;
+
+    /**
+     * @brief Finds a record by task ID using binary search over the record table.
+     * @param id The ID of the task to find.
+     * @return A view of the task if found, or std::nullopt if not.
+     */
+    std::optional<TaskView> find(int id) const;
+
+    /**
+     * @brief Overwrites the status and updatedAt fields of a record in place.
+     * @param id The ID of the task to update.
+     * @param status The new status.
+     * @param updatedAt The new last updated timestamp.
+     * @return True if the task exists and was patched.
+     */
+    bool patchStatus(int id, TaskStatus status, std::time_t updatedAt);
+
+    /**
+     * @brief Flushes in-place updates to disk.
+     * @throws std::runtime_error If the mapping cannot be synced.
+     */
+    void sync();
+
+    /**
+     * @brief Unmaps the store.
+     */
+    void close();
+
+private:
+
+    /**
+     * @brief Finds the position of a record by task ID.
+     * @param id The ID of the task to find.
+     * @return The record index, or std::nullopt if not found.
+     */
+    std::optional<std::size_t> indexOf(int id) const;
+};
+
+#endif
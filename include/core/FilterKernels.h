@@ -0,0 +1,108 @@
+#ifndef FILTER_KERNELS_H
+#define FILTER_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @namespace FilterKernels
+ * @brief Vectorized predicates over packed task columns, producing selection bitmaps.
+ *
+ * Each kernel evaluates a predicate over a contiguous column and writes one bit per element
+ * (bit i of word i / 64) into a bitmap of bitmapWords(n) words; unused trailing bits are zero.
+ * Bitmaps from different predicates are combined with andBitmaps() / orBitmaps().
+ *
+ * Kernels are implemented for AVX2, SSE2 and plain scalar code. The widest instruction set
+ * supported by the running CPU is selected on first use; setIsa() can force a narrower one
+ * (for benchmarking or testing).
+ */
+namespace FilterKernels {
+
+  /**
+   * @enum Isa
+   * @brief Instruction sets the kernels are implemented for.
+   */
+  enum class Isa {
+    SCALAR, ///< Portable C++.
+    SSE2,   ///< 128-bit SSE2 (baseline on x86-64).
+    AVX2    ///< 256-bit AVX2.
+  };
+
+  /**
+   * @brief Gets the instruction set the kernels currently dispatch to.
+   * @return The active instruction set.
+   */
+  Isa activeIsa();
+
+  /**
+   * @brief Gets the widest instruction set supported by the running CPU.
+   * @return The best supported instruction set.
+   */
+  Isa bestSupportedIsa();
+
+  /**
+   * @brief Forces the kernels to a given instruction set.
+   * @param isa The instruction set to use; clamped to bestSupportedIsa().
+   */
+  void setIsa(Isa isa);
+
+  /**
+   * @brief Gets a printable name for an instruction set.
+   * @param isa The instruction set.
+   * @return "scalar", "sse2" or "avx2".
+   */
+  const char* isaName(Isa isa);
+
+  /**
+   * @brief Gets the number of 64-bit words needed for a bitmap of n bits.
+   * @param n The number of elements.
+   * @return The bitmap size in words.
+   */
+  std::size_t bitmapWords(std::size_t n);
+
+  /**
+   * @brief Selects the elements equal to a status value.
+   * @param statuses The status column.
+   * @param n The number of elements.
+   * @param status The status value to match.
+   * @param out The output bitmap of bitmapWords(n) words.
+   */
+  void statusEquals(const std::uint8_t* statuses, std::size_t n, std::uint8_t status, std::uint64_t* out);
+
+  /**
+   * @brief Selects the elements within a half-open range [from, until).
+   * @param values The timestamp column.
+   * @param n The number of elements.
+   * @param from The inclusive lower bound.
+   * @param until The exclusive upper bound.
+   * @param out The output bitmap of bitmapWords(n) words.
+   */
+  void inRange(const std::int64_t* values, std::size_t n, std::int64_t from, std::int64_t until, std::uint64_t* out);
+
+  /**
+   * @brief Intersects two bitmaps in place (dst &= src).
+   * @param dst The bitmap to update.
+   * @param src The bitmap to intersect with.
+   * @param words The bitmap size in words.
+   */
+  void andBitmaps(std::uint64_t* dst, const std::uint64_t* src, std::size_t words);
+
+  /**
+   * @brief Unites two bitmaps in place (dst |= src).
+   * @param dst The bitmap to update.
+   * @param src The bitmap to unite with.
+   * @param words The bitmap size in words.
+   */
+  void orBitmaps(std::uint64_t* dst, const std::uint64_t* src, std::size_t words);
+
+  /**
+   * @brief Appends the positions of all set bits to a vector.
+   * @param bitmap The bitmap to read.
+   * @param n The number of elements the bitmap covers.
+   * @param rows The vector receiving the positions, ascending.
+   */
+  void collect(const std::uint64_t* bitmap, std::size_t n, std::vector<std::size_t>& rows);
+}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+/**
+ * @class JsonReader
+ * @brief A forward-only JSON tokenizer over an in-memory buffer.
+ *
+ * The JsonReader walks a JSON document exactly once, exposing just enough primitives
+ * (punctuation, strings, integers and value skipping) to decode the store formats used by
+ * the task tracker. It never copies the underlying buffer; strings are unescaped directly
+ * into a caller-provided std::string so that buffers can be reused between calls.
+ */
+class JsonReader {
+private:
+    std::string_view input; ///< The JSON document being read.
+    std::size_t pos = 0;    ///< Current read offset into the input.
+public:
+
+    /**
+     * @brief Constructs a reader over the given JSON text.
+     * @param input The JSON document; must outlive the reader.
+     */
+    explicit JsonReader(std::string_view input);
+
+    /**
+     * @brief Gets the current read offset.
+     * @return The byte offset of the next unread character.
+     */
+    std::size_t position() const;
+
+    /**
+     * @brief Checks whether only whitespace remains in the input.
+     * @return True if the end of the input has been reached.
+     */
+    bool atEnd();
+
+    /**
+     * @brief Gets the next non-whitespace character without consuming it.
+     * @return The next character, or '\0' at the end of the input.
+     */
+    char peek();
+
+    /**
+     * @brief Consumes the next non-whitespace character if it matches.
+     * @param c The expected character.
+     * @return True if the character was consumed.
+     */
+    bool consume(char c);
+
+    /**
+     * @brief Consumes the next non-whitespace character, which must match.
+     * @param c The expected character.
+     * @throws std::runtime_error If a different character (or the end) is found.
+     */
+    void expect(char c);
+
+    /**
+     * @brief Reads a JSON string, unescaping it into the output buffer.
+     * @param out The buffer receiving the decoded string; cleared first.
+     * @throws std::runtime_error If the string is malformed or unterminated.
+     */
+    void readString(std::string& out);
+
+    /**
+     * @brief Reads a JSON integer.
+     * @return The parsed integer value.
+     * @throws std::runtime_error If no valid integer is present.
+     */
+    long long readInteger();
+
+    /**
+     * @brief Skips over a complete JSON value of any type.
+     * @throws std::runtime_error If the value is malformed.
+     */
+    void skipValue();
+
+    /**
+     * @brief Skips over a JSON string without decoding it.
+     * @throws std::runtime_error If the string is unterminated.
+     */
+    void skipString();
+
+private:
+
+    /**
+     * @brief Advances past any JSON whitespace.
+     */
+    void skipWhitespace();
+
+    /**
+     * @brief Reads the four hex digits of a \\u escape.
+     * @return The decoded UTF-16 code unit.
+     */
+    unsigned readHex4();
+
+    /**
+     * @brief Throws a std::runtime_error annotated with the current offset.
+     * @param message Description of the problem.
+     */
+    [[noreturn]] void fail(const std::string& message) const;
+};
+
+#endif
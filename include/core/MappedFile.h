@@ -0,0 +1,90 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @class MappedFile
+ * @brief RAII wrapper around a memory-mapped file.
+ *
+ * On POSIX systems the file is mapped with mmap (shared, so writes through a read-write
+ * mapping reach the file). On other platforms the file is read into memory instead, and a
+ * read-write mapping is written back by sync(). Mapped files are move-only.
+ */
+class MappedFile {
+public:
+
+    /**
+     * @enum Access
+     * @brief Selects whether the mapping may be written to.
+     */
+    enum class Access {
+      READ_ONLY, ///< The mapping is read-only.
+      READ_WRITE ///< Writes through the mapping update the file.
+    };
+
+private:
+    std::string path;   ///< Path of the mapped file.
+    char* bytes = nullptr; ///< Start of the mapping, or nullptr if nothing is mapped.
+    std::size_t length = 0; ///< Size of the mapping in bytes.
+    Access access = Access::READ_ONLY; ///< Access mode of the mapping.
+    std::vector<char> fallback; ///< Backing storage on platforms without mmap.
+public:
+
+    /**
+     * @brief Constructs an empty (unmapped) file.
+     */
+    MappedFile() = default;
+
+    /**
+     * @brief Maps the given file.
+     * @param path The file to map.
+     * @param access Whether the mapping may be written to.
+     * @throws std::runtime_error If the file cannot be opened or mapped.
+     */
+    MappedFile(const std::string& path, Access access);
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Unmaps the file.
+     */
+    ~MappedFile();
+
+    /**
+     * @brief Gets a read-only pointer to the mapped bytes.
+     * @return The start of the mapping, or nullptr for an empty file.
+     */
+    const char* data() const;
+
+    /**
+     * @brief Gets a writable pointer to the mapped bytes.
+     * @return The start of the mapping, or nullptr for an empty file.
+     * @note Only valid to write through for Access::READ_WRITE mappings.
+     */
+    char* data();
+
+    /**
+     * @brief Gets the size of the mapping.
+     * @return The mapped size in bytes.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Flushes writes made through a read-write mapping to the file.
+     * @throws std::runtime_error If the data cannot be written back.
+     */
+    void sync();
+
+    /**
+     * @brief Unmaps the file, leaving this object empty.
+     */
+    void close();
+};
+
+#endif
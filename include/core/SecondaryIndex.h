@@ -0,0 +1,96 @@
+#ifndef SECONDARY_INDEX_H
+#define SECONDARY_INDEX_H
+
+#include "core/Task.h"
+#include "core/TaskTable.h"
+#include <ctime>
+#include <map>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+/**
+ * @class SecondaryIndex
+ * @brief Per-status indexes over the tasks map, ordered by ID and by last update time.
+ *
+ * For every TaskStatus there is one map ordered by ID and one ordered by (updatedAt, ID). Both
+ * point straight at the tasks in TaskManager's map, whose nodes never move, so a query touches
+ * only the tasks it returns: O(log n + k) for k results, instead of a scan over every task.
+ * Each family of maps is built on the first query that needs it, and every later mutation
+ * updates it in place. Index nodes come from a pool, so the constant churn of status changes
+ * reuses memory.
+ */
+class SecondaryIndex {
+public:
+
+    /**
+     * @struct Key
+     * @brief The indexed fields of a task, needed to unlink it after it changed.
+     */
+    struct Key {
+        TaskStatus status;     ///< The indexed status.
+        std::time_t updatedAt; ///< The indexed last updated timestamp.
+    };
+
+private:
+    using UpdatedKey = std::pair<std::time_t, int>; ///< (updatedAt, ID).
+    static constexpr std::size_t STATUS_COUNT = TaskUtils::STATUS_COUNT;
+
+    std::pmr::unsynchronized_pool_resource pool; ///< Memory of the index nodes.
+    std::vector<std::pmr::map<int, const Task*>> byId;               ///< Tasks of each status by ID.
+    std::vector<std::pmr::map<UpdatedKey, const Task*>> byUpdatedAt; ///< Tasks of each status by update time.
+    bool byIdBuilt = false;        ///< Whether byId holds every task.
+    bool byUpdatedAtBuilt = false; ///< Whether byUpdatedAt holds every task.
+
+    static std::size_t slot(TaskStatus status);
+    void buildById(const TaskMap& tasks);
+    void buildByUpdatedAt(const TaskMap& tasks);
+
+public:
+
+    /**
+     * @brief Constructs an empty index.
+     */
+    SecondaryIndex();
+
+    SecondaryIndex(const SecondaryIndex&) = delete;
+    SecondaryIndex& operator=(const SecondaryIndex&) = delete;
+
+    /**
+     * @brief Removes every entry and returns the node memory to the system.
+     * @note The maps are rebuilt by the next query that needs them.
+     */
+    void clear();
+
+    /**
+     * @brief Checks whether any maps are built and must be kept up to date.
+     * @return True if insert() and erase() have work to do.
+     */
+    bool isBuilt() const;
+
+    /**
+     * @brief Indexes one task.
+     * @param task The task; it must stay in place while indexed.
+     */
+    void insert(const Task& task);
+
+    /**
+     * @brief Unlinks one task.
+     * @param id The ID of the task.
+     * @param key The status and updatedAt the task was indexed with.
+     */
+    void erase(int id, const Key& key);
+
+    /**
+     * @brief Answers a query.
+     * @param query The filter, order and page.
+     * @param tasks The tasks to build missing maps from; they must stay in place while indexed.
+     * @return The matching tasks in the requested order, at most query.limit of them.
+     * @note O(log n + offset + limit) from any cursor, except for an updatedAt range returned in
+     *       ID order, which sorts all m tasks in the range: O(log n + m log m). Queries without
+     *       any filter in ID order are answered from the tasks map instead.
+     */
+    std::vector<const Task*> query(const TaskQuery& query, const TaskMap& tasks);
+};
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef STATS_H
+#define STATS_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * @namespace Stats
+ * @brief Scoped phase timers and counters behind `--stats`.
+ *
+ * Code is instrumented through the TASK_STATS_SCOPE and TASK_STATS_ADD macros. Timers nest: a
+ * scope opened inside another one is reported beneath it, and scopes with the same name under the
+ * same parent are summed. Nothing is recorded until enable() is called, and without
+ * TASK_TRACKER_STATS (the TASK_TRACKER_ENABLE_STATS CMake option) the macros compile to nothing.
+ * Recording is thread-safe, so the daemon's worker threads may be instrumented too.
+ */
+namespace Stats {
+
+#ifdef TASK_TRACKER_STATS
+
+    /**
+     * @brief Starts recording timers and counters.
+     */
+    void enable();
+
+    /**
+     * @brief Checks whether timers and counters are recorded.
+     * @return True after enable().
+     */
+    bool enabled();
+
+    /**
+     * @brief Adds to a counter.
+     * @param counter The counter's name; must be a string literal.
+     * @param amount The amount to add.
+     */
+    void add(const char* counter, std::uint64_t amount);
+
+    /**
+     * @brief Prints every timer, indented under its parent, followed by every counter.
+     * @param out The stream to print to.
+     */
+    void report(std::ostream& out);
+
+    /**
+     * @class ScopedTimer
+     * @brief Times a phase from construction to destruction.
+     */
+    class ScopedTimer {
+    private:
+        std::size_t index;  ///< The timer being recorded, or SIZE_MAX if recording is off.
+        std::size_t parent; ///< The timer that was innermost on this thread before this one.
+        std::chrono::steady_clock::time_point start; ///< When the phase started.
+    public:
+
+        /**
+         * @brief Starts timing a phase, nested under the innermost phase open on this thread.
+         * @param name The phase's name; must be a string literal.
+         */
+        explicit ScopedTimer(const char* name);
+
+        /**
+         * @brief Adds the elapsed time to the phase.
+         */
+        ~ScopedTimer();
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+    };
+
+#endif
+
+}
+
+#ifdef TASK_TRACKER_STATS
+#define TASK_STATS_JOIN_(a, b) a##b
+#define TASK_STATS_JOIN(a, b) TASK_STATS_JOIN_(a, b)
+/// Times the rest of the enclosing block as the named phase.
+#define TASK_STATS_SCOPE(name) const Stats::ScopedTimer TASK_STATS_JOIN(taskStatsScope, __LINE__)(name)
+/// Adds an amount to the named counter; the amount is not evaluated unless stats are enabled.
+#define TASK_STATS_ADD(counter, amount) (Stats::enabled() ? Stats::add(counter, static_cast<std::uint64_t>(amount)) : void())
+#else
+#define TASK_STATS_SCOPE(name) static_cast<void>(0)
+#define TASK_STATS_ADD(counter, amount) static_cast<void>(0)
+#endif
+
+#endif
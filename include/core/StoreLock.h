@@ -0,0 +1,107 @@
+#ifndef STORE_LOCK_H
+#define STORE_LOCK_H
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @class StoreLock
+ * @brief An advisory inter-process lock and version counter kept in a file next to the store.
+ *
+ * Every process that loads a store takes the lock shared, and every process that saves one takes
+ * it exclusive. The lock file also holds a counter that each save increments. Together they give
+ * optimistic concurrency: a manager remembers the version it loaded, and if the version has moved
+ * by the time it saves, another process committed in between and its changes must be merged first.
+ *
+ * Locks are taken with flock() on POSIX systems and LockFileEx() on Windows, and are released
+ * automatically if the process dies. Locking is re-entrant within one StoreLock.
+ */
+class StoreLock {
+public:
+
+    /**
+     * @enum Mode
+     * @brief The kind of lock to take.
+     */
+    enum class Mode {
+      SHARED,   ///< Held while reading; any number of processes may hold it.
+      EXCLUSIVE ///< Held while writing; excludes every other holder.
+    };
+
+    /**
+     * @class Scope
+     * @brief Holds a StoreLock for the lifetime of the object.
+     */
+    class Scope {
+    private:
+        StoreLock& lock; ///< The lock being held.
+    public:
+
+        /**
+         * @brief Takes the lock.
+         * @param lock The lock to take.
+         * @param mode The kind of lock.
+         */
+        Scope(StoreLock& lock, Mode mode);
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        /**
+         * @brief Releases the lock.
+         */
+        ~Scope();
+    };
+
+private:
+    std::string path; ///< Path of the lock file.
+    int fd = -1;      ///< Descriptor of the lock file while it is open.
+    int depth = 0;    ///< Number of nested lock() calls currently held.
+    Mode held = Mode::SHARED; ///< The kind of lock currently held.
+public:
+
+    /**
+     * @brief Constructs a lock backed by the given file; nothing is opened yet.
+     * @param path The lock file path.
+     */
+    explicit StoreLock(std::string path);
+
+    StoreLock(const StoreLock&) = delete;
+    StoreLock& operator=(const StoreLock&) = delete;
+
+    /**
+     * @brief Releases the lock and closes the lock file.
+     */
+    ~StoreLock();
+
+    /**
+     * @brief Blocks until the lock is acquired.
+     * @param mode The kind of lock.
+     * @throws std::runtime_error If an exclusive lock is requested and the lock file cannot be created.
+     * @throws std::logic_error If an exclusive lock is requested while only a shared one is held.
+     * @note If the lock file cannot be created (e.g. a read-only directory), shared locks proceed unlocked.
+     */
+    void lock(Mode mode);
+
+    /**
+     * @brief Releases one level of the lock.
+     */
+    void unlock();
+
+    /**
+     * @brief Reads the version counter.
+     * @return The number of saves committed under this lock file, or 0 if there is none.
+     * @note Only meaningful while the lock is held.
+     */
+    std::uint64_t version() const;
+
+    /**
+     * @brief Increments the version counter.
+     * @return The new version.
+     * @throws std::runtime_error If the counter cannot be written.
+     * @note Requires the exclusive lock.
+     */
+    std::uint64_t bumpVersion();
+};
+
+#endif
@@ -2,7 +2,10 @@
 #define TASK_H
 
 #include "core/TaskStatus.h"
+#include <map>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include <ctime>
 
 
@@ -18,11 +21,14 @@
 class Task {
 private:
     int id; ///< Unique identifier for the task.
-    std::string description; ///< Brief description of the task.
+    std::pmr::string description; ///< Brief description of the task, stored with the task's allocator.
     TaskStatus status; ///< Current status of the task (e.g., TODO, IN_PROGRESS).
     std::time_t createdAt; ///< Timestamp when the task was created.
     std::time_t updatedAt; ///< Timestamp when the task was last updated.
 public:
+    /// Allocator used for the description; lets containers such as TaskMap place it in their arena.
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
     /**
        * @brief Constructs a Task object with the specified attributes.
        * @param id The unique identifier for the task.
@@ -30,8 +36,30 @@ public:
        * @param status The initial status of the task.
        * @param createdAt The creation timestamp of the task.
        * @param updatedAt The last updated timestamp of the task.
+       * @param allocator The allocator the description is stored with.
        */
-    Task(int id, std::string description, TaskStatus status, std::time_t createdAt, std::time_t updatedAt);
+    Task(int id, std::string_view description, TaskStatus status, std::time_t createdAt, std::time_t updatedAt,
+         const allocator_type& allocator = {});
+
+    Task(const Task& other) = default;
+    Task(Task&& other) = default;
+    Task& operator=(const Task& other) = default;
+    Task& operator=(Task&& other) = default;
+
+    /**
+     * @brief Copies a task, storing the description with the given allocator.
+     * @param other The task to copy.
+     * @param allocator The allocator the copy's description is stored with.
+     */
+    Task(const Task& other, const allocator_type& allocator);
+
+    /**
+     * @brief Moves a task, storing the description with the given allocator.
+     * @param other The task to move from.
+     * @param allocator The allocator the new description is stored with.
+     * @note The description buffer is only stolen when both allocators share a memory resource.
+     */
+    Task(Task&& other, const allocator_type& allocator);
 
     /**
        * @brief Gets the task's unique identifier.
@@ -47,15 +75,16 @@ public:
 
     /**
      * @brief Gets the task's description.
-     * @return The task description.
+     * @return A view of the task description, valid until the description is changed.
      */
-    std::string getDescription() const;
+    std::string_view getDescription() const;
 
     /**
      * @brief Sets the task's description.
      * @param description The new task description.
+     * @note Reuses the existing buffer when the new description fits in it.
      */
-    void setDescription(std::string description);
+    void setDescription(std::string_view description);
 
     /**
      * @brief Gets the task's current status.
@@ -131,14 +160,26 @@ public:
      */
     std::string toJSON() const;
 
-private:
-
     /**
      * @brief Formats a timestamp into a human-readable string.
      * @param time The timestamp to format.
      * @return The formatted time string (e.g., "2025/03/04 12:00:00").
      */
-    std::string formatTime(std::time_t time) const;
+    static std::string formatTime(std::time_t time);
+
+    /// Size of a buffer that holds any timestamp formatted by formatTime(std::time_t, char*).
+    static constexpr std::size_t TIME_BUFFER_SIZE = 32;
+
+    /**
+     * @brief Formats a timestamp into a caller-provided buffer.
+     * @param time The timestamp to format.
+     * @param out The buffer receiving the text, at least TIME_BUFFER_SIZE bytes; not null-terminated.
+     * @return The number of characters written (19 for years 0 to 9999).
+     */
+    static std::size_t formatTime(std::time_t time, char* out);
 };
 
+/// Tasks keyed by id; nodes and descriptions come from the map's memory resource.
+using TaskMap = std::pmr::map<int, Task>;
+
 #endif
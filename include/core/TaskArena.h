@@ -0,0 +1,72 @@
+#ifndef TASK_ARENA_H
+#define TASK_ARENA_H
+
+#include <cstddef>
+#include <memory_resource>
+
+/**
+ * @struct ArenaStats
+ * @brief Usage counters of a TaskArena.
+ */
+struct ArenaStats {
+    std::size_t usedBytes = 0;         ///< Bytes handed out since the last release.
+    std::size_t reservedBytes = 0;     ///< Bytes currently obtained from the system.
+    std::size_t peakReservedBytes = 0; ///< Highest reservedBytes ever reached.
+    std::size_t allocations = 0;       ///< Allocations served since the last release.
+};
+
+/**
+ * @class TaskArena
+ * @brief A monotonic (bump) memory resource with usage statistics.
+ *
+ * TaskManager allocates its map nodes and task descriptions from a TaskArena. Allocation is a
+ * pointer bump inside large blocks, individual deallocations are no-ops, and release() frees
+ * every block at once. Memory of erased or replaced tasks is only reclaimed on release(), which
+ * TaskManager calls whenever it reloads the store.
+ */
+class TaskArena : public std::pmr::memory_resource {
+private:
+
+    /**
+     * @class CountingUpstream
+     * @brief Forwards to the default new/delete resource, tracking reserved bytes.
+     */
+    class CountingUpstream : public std::pmr::memory_resource {
+    public:
+        std::size_t reservedBytes = 0;     ///< Bytes currently allocated.
+        std::size_t peakReservedBytes = 0; ///< Highest reservedBytes ever reached.
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    };
+
+    CountingUpstream upstream; ///< Source of the arena's blocks.
+    std::pmr::monotonic_buffer_resource monotonic{&upstream}; ///< The bump allocator.
+    std::size_t usedBytes = 0;   ///< Bytes handed out since the last release.
+    std::size_t allocations = 0; ///< Allocations served since the last release.
+public:
+
+    TaskArena() = default;
+    TaskArena(const TaskArena&) = delete;
+    TaskArena& operator=(const TaskArena&) = delete;
+
+    /**
+     * @brief Frees every block of the arena at once.
+     * @note Everything allocated from the arena must already be destroyed.
+     */
+    void release();
+
+    /**
+     * @brief Gets the arena's usage counters.
+     * @return The current statistics.
+     */
+    ArenaStats stats() const;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+};
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef TASK_INDEX_H
+#define TASK_INDEX_H
+
+#include "core/MappedFile.h"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @class TaskIndex
+ * @brief A persisted id -> byte-offset index over a JSON task store.
+ *
+ * The index lets TaskManager locate a single task object inside tasks.json without parsing
+ * the whole file. It is stored next to the store (tasks.json.idx) as a header followed by
+ * fixed-width entries sorted by id, and is memory-mapped so lookups are a binary search.
+ * The header records the size, modification time and StoreLock version of the store it was
+ * built from; if the store changes behind its back the index is rebuilt with a single
+ * structural scan.
+ */
+class TaskIndex {
+public:
+
+    /**
+     * @struct Entry
+     * @brief Location of one task object inside the store file.
+     */
+    struct Entry {
+        std::int32_t id;      ///< Task ID.
+        std::uint32_t length; ///< Length of the JSON object in bytes.
+        std::uint64_t offset; ///< Byte offset of the object's opening '{'.
+    };
+
+private:
+    std::string storePath; ///< Path of the indexed store.
+    std::string indexPath; ///< Path of the index file.
+    std::uint64_t version = 0; ///< Store version the index is stamped with.
+    MappedFile file;       ///< Mapped index file.
+    std::size_t count = 0; ///< Number of entries in the mapped file.
+    std::vector<Entry> appended; ///< Entries added since open(), not yet written.
+public:
+
+    /**
+     * @brief Opens the index for a store, rebuilding it if missing or stale.
+     * @param storePath The JSON store to index.
+     * @param storeVersion The current StoreLock version of the store.
+     * @throws std::runtime_error If the store is malformed or the index cannot be written.
+     */
+    void open(const std::string& storePath, std::uint64_t storeVersion = 0);
+
+    /**
+     * @brief Finds the location of a task by ID.
+     * @param id The ID of the task to find.
+     * @return The index entry, or std::nullopt if the task is not in the store.
+     */
+    std::optional<Entry> find(int id) const;
+
+    /**
+     * @brief Gets the number of indexed tasks.
+     * @return The entry count, including appended entries.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Gets the highest indexed task ID.
+     * @return The highest ID, or 0 if the index is empty.
+     */
+    int maxId() const;
+
+    /**
+     * @brief Adds an entry for a task appended to the end of the store.
+     * @param entry The location of the new task; its id must exceed maxId().
+     */
+    void append(const Entry& entry);
+
+    /**
+     * @brief Persists appended entries and re-stamps the index with the store's current size and mtime.
+     * @param storeVersion The StoreLock version the patched store is saved as.
+     * @throws std::runtime_error If the index file cannot be written.
+     * @note Call after patching the store in place, so the index is not considered stale.
+     */
+    void commit(std::uint64_t storeVersion = 0);
+
+    /**
+     * @brief Unmaps the index and discards appended entries.
+     */
+    void close();
+
+private:
+
+    /**
+     * @brief Reads the entry at the given position.
+     * @param index The entry index.
+     * @return The entry.
+     */
+    Entry entryAt(std::size_t index) const;
+
+    /**
+     * @brief Scans the store and writes a fresh index file.
+     * @throws std::runtime_error If the store is malformed or the index cannot be written.
+     */
+    void rebuild();
+};
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef TASK_JOURNAL_H
+#define TASK_JOURNAL_H
+
+#include "core/AtomicFile.h"
+#include "core/Task.h"
+#include "core/TaskSerializer.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+
+/**
+ * @class TaskJournal
+ * @brief An append-only log of task mutations stored next to the task store.
+ *
+ * Each mutation (add, update, status change or delete) is encoded as one JSON record per line.
+ * Records are buffered in memory and appended to the log with a single write, so persisting a
+ * change costs O(1) I/O instead of a full store rewrite. Every record carries the complete
+ * resulting task (or the deleted id), which makes replaying the log over a snapshot idempotent.
+ */
+class TaskJournal {
+private:
+    std::string path;   ///< File path of the log.
+    TaskSerializer buffer; ///< Encoded records not yet appended to the log.
+public:
+
+    /**
+     * @brief Constructs a journal backed by the given log file.
+     * @param path The file path of the log.
+     */
+    explicit TaskJournal(std::string path);
+
+    /**
+     * @brief Gets the file path of the log.
+     * @return The log path.
+     */
+    const std::string& getPath() const;
+
+    /**
+     * @brief Records that a task was added or modified.
+     * @param op The operation name ("add", "update" or "status").
+     * @param task The task state after the mutation.
+     */
+    void recordPut(std::string_view op, const Task& task);
+
+    /**
+     * @brief Records that a task was deleted.
+     * @param id The ID of the deleted task.
+     */
+    void recordDelete(int id);
+
+    /**
+     * @brief Checks whether any records are waiting to be appended.
+     * @return True if there are buffered records.
+     */
+    bool hasPending() const;
+
+    /**
+     * @brief Discards buffered records without writing them.
+     */
+    void discardPending();
+
+    /**
+     * @brief Appends all buffered records to the log in a single write.
+     * @param durability How the appended records are flushed to disk.
+     * @throws std::runtime_error If the log cannot be opened for appending.
+     */
+    void flush(Durability durability = Durability::NONE);
+
+    /**
+     * @brief Gets the size of the log on disk.
+     * @return The log size in bytes, or 0 if it does not exist.
+     */
+    std::uintmax_t size() const;
+
+    /**
+     * @brief Applies every record in the log to the given tasks.
+     * @param tasks The tasks loaded from the last snapshot.
+     * @throws std::runtime_error If a record other than the last one is malformed.
+     */
+    void replay(TaskMap& tasks) const;
+
+    /**
+     * @brief Deletes the log file and discards any buffered records.
+     */
+    void clear();
+};
+
+#endif
@@ -1,9 +1,39 @@
 #ifndef TASK_MANAGER_H
 #define TASK_MANAGER_H
 
+#include "core/BinaryStore.h"
+#include "core/SecondaryIndex.h"
 #include "core/Task.h"
+#include "core/TaskArena.h"
+#include "core/TaskIndex.h"
+#include "core/TaskJournal.h"
+#include "core/TaskTable.h"
+#include "core/TaskView.h"
+#include "core/TextIndex.h"
+#include "core/StoreLock.h"
+#include <cstdint>
+#include <functional>
 #include <map>
 #include <optional>
+#include <vector>
+
+/**
+ * @enum StoreMode
+ * @brief Selects how TaskManager persists mutations.
+ */
+enum class StoreMode {
+  SNAPSHOT, ///< Every save rewrites the whole store file.
+  JOURNAL   ///< Saves append mutation records to a log, compacting it into the store when it grows.
+};
+
+/**
+ * @enum StoreFormat
+ * @brief The on-disk format of a task store.
+ */
+enum class StoreFormat {
+  JSON,  ///< A JSON array of task objects.
+  BINARY ///< A memory-mapped BinaryStore with a fixed-width record table.
+};
 
 /**
  * @class TaskManager
@@ -12,12 +42,77 @@
  * The TaskManager class handles the storage, retrieval, and manipulation of Task objects.
  * It maintains tasks in a map indexed by their IDs and supports saving to and loading from
  * a JSON file specified by the store name. This class provides methods to add, remove, and
- * find tasks, as well as access the entire task collection.
+ * find tasks, as well as access the entire task collection. In StoreMode::JOURNAL, mutations
+ * made through the manager are appended to a log next to the store instead of rewriting it.
+ *
+ * Stores in StoreFormat::BINARY are memory-mapped rather than parsed: read paths (forEachTask,
+ * findTaskView) work directly on the mapped records, status changes are patched into them on
+ * save, and the tasks map is only materialized when a mutation needs it.
+ *
+ * With lazy loading enabled, JSON stores are not parsed up front either: a persisted TaskIndex
+ * locates individual task objects, only the tasks a command touches are decoded, and changes are
+ * patched back into the file in place when the rewritten object fits in the old one.
+ *
+ * deleteTask() only turns a task into a tombstone with TaskStatus::DELETED, so a delete is saved
+ * like a status change. Tombstones are hidden from queries that do not filter on that status,
+ * restoreTask() brings them back, and purgeDeletedTasks() followed by compactStore() drops them.
+ *
+ * The tasks map allocates its nodes and descriptions from a monotonic TaskArena, so loading a
+ * store costs a handful of large allocations and reloading frees them all at once.
+ *
+ * Several processes may work on the same store. Loads and saves are coordinated through a
+ * StoreLock (tasks.json.lock) whose version counter is recorded at load; if another process
+ * saved in the meantime, saving first rebuilds the tasks from the store and re-applies the
+ * mutations made through this manager, so no update is lost.
+ *
+ * Once a store has been searched, its TextIndex (tasks.json.fts) is kept up to date by every
+ * save that adds, updates or deletes tasks, so searches never rebuild it from scratch.
  */
 class TaskManager {
+public:
+    static constexpr std::uintmax_t PARALLEL_LOAD_THRESHOLD = 4 << 20; ///< Store size (bytes) from which loads are parsed on several threads.
+    static constexpr std::uintmax_t PARALLEL_LOAD_CHUNK = 1 << 20;     ///< Smallest share of the store given to one parsing thread.
+    static constexpr std::size_t PARALLEL_SAVE_THRESHOLD = 1 << 16;    ///< Task count from which JSON snapshots are encoded on several threads.
+    static constexpr std::size_t PARALLEL_SAVE_CHUNK = 1 << 14;        ///< Smallest number of tasks per encoding thread.
+    static constexpr std::size_t PARALLEL_SAVE_BATCH = 1 << 12;        ///< Tasks encoded into one buffer of a parallel save.
 private:
-    std::map<int, Task> tasks; ///< Container mapping task IDs to Task objects.
-    std::string storeName;    ///< File path for storing tasks in JSON format.
+    TaskArena arena;          ///< Memory for the tasks map; declared first so it outlives the map.
+    mutable TaskMap tasks{&arena}; ///< Container mapping task IDs to Task objects.
+    std::string storeName;    ///< File path for storing tasks.
+    StoreFormat storeFormat = StoreFormat::JSON; ///< Format of the store file, detected on load.
+    BinaryStore binaryStore;  ///< Mapped store, used while the format is StoreFormat::BINARY.
+    mutable bool materialized = true; ///< Whether tasks holds every task of the store.
+    bool lazyLoading = false; ///< Whether JSON stores are indexed instead of parsed on load.
+    mutable TaskIndex index;  ///< Offset index over a lazily loaded JSON store.
+    std::vector<int> patchedIds;  ///< Tasks of a lazily loaded or mapped store modified since load.
+    std::vector<int> appendedIds; ///< Tasks added to a lazily loaded store since load.
+    mutable TaskTable table;  ///< Columnar copy of the tasks used for scans.
+    mutable bool tableValid = false; ///< Whether table reflects the current tasks.
+    mutable SecondaryIndex secondaryIndex; ///< Status and updatedAt indexes over tasks, used by queryTasks().
+    mutable TextIndex textIndex; ///< Inverted index over descriptions, used by searchTasks().
+    StoreMode storeMode = StoreMode::SNAPSHOT; ///< How mutations are persisted.
+    TaskJournal journal;      ///< Log of mutations made since the last snapshot.
+    std::uintmax_t journalCompactionThreshold = 1024 * 1024; ///< Log size (bytes) that triggers compaction.
+    std::size_t loadThreads = 0; ///< Threads parsing large JSON stores; 0 means one per CPU.
+    std::size_t saveThreads = 0; ///< Threads encoding large JSON snapshots; 0 means one per CPU.
+    Durability durability = Durability::FSYNC_DATA; ///< How store and journal writes are flushed to disk.
+    mutable StoreLock storeLock; ///< Inter-process lock and version counter of the store.
+    std::uint64_t loadedVersion = 0; ///< Store version the tasks are based on.
+    mutable std::uint64_t indexVersion = 0; ///< Store version the lazy index was validated at.
+
+    /**
+     * @struct PendingChange
+     * @brief A mutation made since the last load or save.
+     */
+    struct PendingChange {
+        std::string_view op; ///< The operation ("add", "update", "status" or "delete").
+        int id;              ///< The ID of the mutated task.
+    };
+
+    std::vector<PendingChange> pendingChanges; ///< Mutations to re-apply if another process saved first.
+    std::map<int, int> remappedIds; ///< Added task IDs that were taken by another process, and their new IDs.
+    bool deferredSaving = false; ///< Whether saveTasksToStore() only marks the tasks as needing a save.
+    bool pendingSave = false;    ///< Whether a deferred save has not been flushed yet.
 public:
 
     /**
@@ -27,15 +122,115 @@ public:
     TaskManager(const std::string& storeName = "tasks.json");
 
     /**
-     * @brief Saves all tasks to the store file in JSON format.
+     * @brief Sets how mutations are persisted by saveTasksToStore().
+     * @param mode The store mode to use.
+     */
+    void setStoreMode(StoreMode mode);
+
+    /**
+     * @brief Sets the log size above which the journal is folded back into the store.
+     * @param bytes The compaction threshold in bytes.
+     */
+    void setJournalCompactionThreshold(std::uintmax_t bytes);
+
+    /**
+     * @brief Sets how store and journal writes are flushed to disk.
+     * @param level The durability level to use.
+     * @note Stores are always replaced atomically; the level only decides what survives a power loss.
+     */
+    void setDurability(Durability level);
+
+    /**
+     * @brief Gets the format of the loaded store.
+     * @return The detected store format.
+     */
+    StoreFormat getStoreFormat() const;
+
+    /**
+     * @brief Enables or disables lazy loading of JSON stores.
+     * @param enabled Whether loadTasksFromStore() should index the store instead of parsing it.
+     * @note Intended for commands that touch a single task. Ignored when a journal must be replayed.
+     */
+    void setLazyLoading(bool enabled);
+
+    /**
+     * @brief Sets how many threads parse a JSON store on load.
+     * @param threads The maximum number of threads; 0 uses one per CPU and 1 disables parallel loading.
+     * @note Stores smaller than PARALLEL_LOAD_THRESHOLD are always parsed on the calling thread.
+     */
+    void setLoadThreads(std::size_t threads);
+
+    /**
+     * @brief Sets how many threads encode a JSON snapshot on save.
+     * @param threads The maximum number of threads; 0 uses one per CPU and 1 disables parallel encoding.
+     * @note Snapshots of fewer than PARALLEL_SAVE_THRESHOLD tasks are always encoded on the calling thread.
+     */
+    void setSaveThreads(std::size_t threads);
+
+    /**
+     * @brief Persists the tasks according to the current store mode.
+     * @throws std::runtime_error If the store or journal file cannot be opened for writing.
+     * @note In StoreMode::SNAPSHOT, rewrites the store file and removes any leftover journal.
+     * @note In StoreMode::JOURNAL, appends pending mutations and compacts once the log passes the threshold.
+     */
+    void saveTasksToStore();
+
+    /**
+     * @brief Writes a full snapshot of all tasks to the store and removes the journal.
      * @throws std::runtime_error If the store file cannot be opened for writing.
      */
-    void saveTasksToStore() const;
+    void compactStore();
+
+    /**
+     * @brief Defers saves, so saveTasksToStore() only records that the tasks need saving.
+     * @param enabled Whether saves are deferred.
+     * @note Lets a long-running owner of the store batch many commands into one write with flushPendingSave().
+     */
+    void setDeferredSaving(bool enabled);
+
+    /**
+     * @brief Checks whether a deferred save is waiting to be flushed.
+     * @return True if saveTasksToStore() was called since the last flush.
+     */
+    bool hasPendingSave() const;
+
+    /**
+     * @brief Performs the deferred save, if any.
+     * @return True if another process's save was merged in, so the tasks changed beyond the deferred changes.
+     * @throws std::runtime_error If the store, journal or lock file cannot be written.
+     */
+    bool flushPendingSave();
+
+    /**
+     * @brief Reloads the store if another process saved since it was loaded.
+     * @return True if the tasks were reloaded.
+     * @throws std::runtime_error If the store or journal is malformed or cannot be written.
+     * @note Unsaved changes are saved first, merged with the other process's changes.
+     */
+    bool refresh();
+
+    /**
+     * @brief Gets the ID an added task ended up with after the last save.
+     * @param id The ID the task was added with.
+     * @return The task's current ID; differs from id if another process added a task with that ID first.
+     */
+    int resolveId(int id) const;
+
+    /**
+     * @brief Writes every task to another file in the given format.
+     * @param path The destination file.
+     * @param format The format to write.
+     * @throws std::runtime_error If the destination cannot be written.
+     */
+    void exportStore(const std::string& path, StoreFormat format) const;
 
     /**
      * @brief Loads tasks from the store file into the tasks map.
      * @note If the file does not exist, creates a default file with an initial task.
      * @note Overwrites any existing tasks in the map with the loaded data.
+     * @note Replays the journal, if present, over the loaded snapshot.
+     * @note Binary stores are mapped instead of parsed; see StoreFormat::BINARY.
+     * @throws std::runtime_error If the store or journal is malformed.
      */
     void loadTasksFromStore();
 
@@ -43,16 +238,77 @@ public:
      * @brief Finds a task by its ID.
      * @param id The ID of the task to find.
      * @return An optional reference to the Task if found, or std::nullopt if not.
+     * @note Changes made through the returned reference are not journaled; use
+     *       updateDescription() and setStatus() to mutate tasks.
      */
     std::optional<std::reference_wrapper<Task>> findTaskById(int id);
 
+    /**
+     * @brief Finds a task by its ID without materializing it.
+     * @param id The ID of the task to find.
+     * @return A view of the task if found, or std::nullopt if not.
+     * @note The view is invalidated by any mutation of the manager.
+     */
+    std::optional<TaskView> findTaskView(int id) const;
+
+    /**
+     * @brief Visits every task in ascending ID order.
+     * @param visit Called with a view of each task.
+     * @note Binary stores are read in place; no Task objects are built.
+     */
+    void forEachTask(const std::function<void(const TaskView&)>& visit) const;
+
+    /**
+     * @brief Gets the ID that the next added task should use.
+     * @return One past the highest existing ID, or 1 if there are no tasks.
+     */
+    int nextId() const;
+
     /**
      * @brief Adds a task to the manager.
      * @param task The Task object to add.
-     * @note If a task with the same ID already exists, it will be overwritten.
+     * @note If a task with the same ID already exists, the existing task is kept.
      */
     void addTask(const Task& task);
 
+    /**
+     * @brief Adds a task to the manager, moving it into the tasks map.
+     * @param task The Task object to add.
+     * @note If a task with the same ID already exists, the existing task is kept.
+     */
+    void addTask(Task&& task);
+
+    /**
+     * @brief Constructs a task directly inside the tasks map.
+     * @param id The unique identifier for the task.
+     * @param description A brief description of the task.
+     * @param status The initial status of the task.
+     * @param createdAt The creation timestamp of the task.
+     * @param updatedAt The last updated timestamp of the task.
+     * @return A view of the added task, or std::nullopt if a task with the same ID already exists.
+     * @note The description is copied once, straight into the tasks arena; no temporary Task is built.
+     */
+    std::optional<TaskView> emplaceTask(int id, std::string_view description, TaskStatus status,
+                                        std::time_t createdAt, std::time_t updatedAt);
+
+    /**
+     * @brief Replaces the description of a task.
+     * @param id The ID of the task to update.
+     * @param description The new description.
+     * @param updatedAt The new last updated timestamp.
+     * @return True if the task exists and was updated.
+     */
+    bool updateDescription(int id, std::string_view description, std::time_t updatedAt);
+
+    /**
+     * @brief Changes the status of a task.
+     * @param id The ID of the task to update.
+     * @param status The new status.
+     * @param updatedAt The new last updated timestamp.
+     * @return True if the task exists and was updated.
+     */
+    bool setStatus(int id, TaskStatus status, std::time_t updatedAt);
+
     /**
      * @brief Removes a task by its ID.
      * @param id The ID of the task to remove.
@@ -60,11 +316,206 @@ public:
      */
     void removeTask(int id);
 
+    /**
+     * @brief Soft-deletes a task by turning it into a tombstone with TaskStatus::DELETED.
+     * @param id The ID of the task to delete.
+     * @param deletedAt The new last updated timestamp.
+     * @return True if the task exists and was not already deleted.
+     * @note Saved like any status change, so no full rewrite is needed; see setStatus().
+     */
+    bool deleteTask(int id, std::time_t deletedAt);
+
+    /**
+     * @brief Brings a soft-deleted task back.
+     * @param id The ID of the deleted task.
+     * @param status The status to restore it with.
+     * @param restoredAt The new last updated timestamp.
+     * @return True if the task exists and was deleted.
+     */
+    bool restoreTask(int id, TaskStatus status, std::time_t restoredAt);
+
+    /**
+     * @brief Removes every soft-deleted task for good.
+     * @return The number of tasks removed.
+     * @note Materializes the tasks; follow with compactStore() to reclaim the space in the store.
+     */
+    std::size_t purgeDeletedTasks();
+
     /**
      * @brief Gets the collection of all tasks.
      * @return A const reference to the tasks map.
+     * @note Materializes binary stores; prefer forEachTask() for read-only iteration.
+     */
+    const TaskMap& getTasks() const;
+
+    /**
+     * @brief Gets the columnar table of all tasks, building it on first use.
+     * @return A const reference to the task table.
+     * @note Once built, the table is kept up to date by every mutation.
+     */
+    const TaskTable& getTable() const;
+
+    /**
+     * @brief Finds tasks by status and update time through the secondary indexes.
+     * @param query The filter, order and page.
+     * @return Views of the matching tasks in the requested order, at most query.limit of them.
+     * @note Runs in O(log n + offset + k) for k results from any cursor once the indexes are
+     *       built; see SecondaryIndex.
+     * @note The views are invalidated by any mutation of the manager.
+     */
+    std::vector<TaskView> queryTasks(const TaskQuery& query) const;
+
+    /**
+     * @brief Finds tasks whose descriptions match a full-text query.
+     * @param query The query; see TextIndex::search().
+     * @return Views of the matching tasks in ascending ID order.
+     * @throws std::runtime_error If the text index cannot be written.
+     * @note Builds the persisted text index if it is missing or stale; otherwise only the matching
+     *       tasks are decoded.
+     * @note The views are invalidated by any mutation of the manager.
+     */
+    std::vector<TaskView> searchTasks(std::string_view query) const;
+
+    /**
+     * @brief Gets the usage counters of the arena backing the tasks map.
+     * @return The arena statistics.
+     */
+    ArenaStats getArenaStats() const;
+
+private:
+
+    /**
+     * @brief Takes the exclusive store lock and writes pending changes or a full snapshot.
+     * @param compact Whether to write a full snapshot rather than only the pending changes.
+     * @return True if another process's save was merged in first.
+     * @throws std::runtime_error If the store, journal or lock file cannot be written.
+     */
+    bool persist(bool compact);
+
+    /**
+     * @brief Writes pending changes according to the store mode and format.
+     * @note Requires the exclusive store lock.
+     */
+    void writeChanges();
+
+    /**
+     * @brief Writes a full snapshot of all tasks to the store and removes the journal.
+     * @note Requires the exclusive store lock.
+     */
+    void writeCompacted();
+
+    /**
+     * @brief Reloads the tasks saved by another process and re-applies the pending changes.
+     * @note Requires the exclusive store lock.
+     */
+    void rebase();
+
+    /**
+     * @brief Checks whether mutations should be recorded in the journal.
+     * @return True in StoreMode::JOURNAL for JSON stores.
+     */
+    bool isJournaling() const;
+
+    /**
+     * @brief Prepares the tasks map for inserting a task.
+     * @param id The ID of the task about to be inserted.
+     * @return False if a task with that ID already exists in a lazily loaded store.
+     */
+    bool prepareInsert(int id);
+
+    /**
+     * @brief Gets a modifiable task for a mutation.
+     * @param id The ID of the task.
+     * @return A pointer to the task, or nullptr if it does not exist.
+     */
+    Task* mutableTask(int id);
+
+    /**
+     * @brief Copies a task of a mapped binary store into the tasks map, so it can be changed before a save.
+     * @param id The ID of the task.
+     * @return A pointer to the cached task, or nullptr if it does not exist.
+     */
+    Task* cachedBinaryTask(int id);
+
+    /**
+     * @brief Propagates a completed mutation to the pending changes, the journal, the lazy write-back lists,
+     *        the table, the secondary indexes and the text index.
+     * @param op The operation ("add", "update", "status" or "delete").
+     * @param id The ID of the mutated task.
+     * @param previous The status and updatedAt of the task before the mutation, if it existed.
+     */
+    void recordChange(std::string_view op, int id, std::optional<SecondaryIndex::Key> previous = std::nullopt);
+
+    /**
+     * @brief Applies a mutation to the open text index.
+     * @param op The operation ("add", "update", "status" or "delete").
+     * @param id The ID of the mutated task.
+     */
+    void applyTextChange(std::string_view op, int id) const;
+
+    /**
+     * @brief Opens the store's text index before a save, so the save keeps it up to date.
+     * @note Requires the exclusive store lock. No effect if the store has no text index, or if it
+     *       is stale and left for the next search to rebuild.
+     */
+    void openTextIndex();
+
+    /**
+     * @brief Parses the whole JSON store into the given map.
+     * @param into The map receiving the tasks; existing entries are kept.
+     * @throws std::runtime_error If the store contains malformed JSON.
+     */
+    void readStore(TaskMap& into) const;
+
+    /**
+     * @brief Parses a large JSON store on several threads into the given map.
+     * @param into The map receiving the tasks; existing entries are kept.
+     * @param threads The number of threads to parse with, including the calling one.
+     * @throws std::runtime_error If the store contains malformed JSON.
+     */
+    void readStoreParallel(TaskMap& into, std::size_t threads) const;
+
+    /**
+     * @brief Decodes a single task of a lazily loaded store, caching it in the tasks map.
+     * @param id The ID of the task to load.
+     * @return A pointer to the cached task, or nullptr if it does not exist.
+     */
+    Task* loadLazyTask(int id) const;
+
+    /**
+     * @brief Writes lazily made changes back into the JSON store in place.
+     * @return True if every change was written, false if a patched task no longer fits its slot.
+     * @throws std::runtime_error If the store or index cannot be written.
+     */
+    bool persistLazyChanges();
+
+    /**
+     * @brief Restores the JSON store from the undo record of an in-place patch interrupted by a crash.
+     * @throws std::runtime_error If the undo record is malformed or the store cannot be written.
+     * @note Requires the exclusive store lock. No effect if there is no undo record.
+     */
+    void rollBackInterruptedPatch();
+
+    /**
+     * @brief Makes the store ready to load: rolls back an interrupted patch and creates a missing store.
+     * @throws std::runtime_error If the store cannot be written.
+     * @note Takes the exclusive store lock, but only if there is something to do.
+     */
+    void prepareStore();
+
+    /**
+     * @brief Loads every task of a mapped binary or lazily loaded JSON store into the tasks map.
+     * @note No effect if the tasks are already materialized.
+     */
+    void materializeTasks() const;
+
+    /**
+     * @brief Writes every task to a file in the given format.
+     * @param path The destination file.
+     * @param format The format to write.
+     * @throws std::runtime_error If the destination cannot be opened for writing.
      */
-    const std::map<int, Task>& getTasks() const;
+    void writeSnapshot(const std::string& path, StoreFormat format) const;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,106 @@
+#ifndef TASK_PARSER_H
+#define TASK_PARSER_H
+
+#include "core/JsonReader.h"
+#include "core/Task.h"
+#include <optional>
+#include <vector>
+
+/**
+ * @class TaskParser
+ * @brief Streams Task objects out of a JSON array in a single pass.
+ *
+ * The TaskParser decodes the store format (a JSON array of task objects) one task at a time.
+ * It runs in time linear to the input, unescapes descriptions correctly (so commas, braces and
+ * quotes inside descriptions are preserved), and ignores unknown keys.
+ */
+class TaskParser {
+private:
+    JsonReader reader;      ///< Tokenizer over the store contents.
+    std::string key;        ///< Scratch buffer for object keys, reused across tasks.
+    std::string text;       ///< Scratch buffer for decoded string values, reused across tasks.
+    bool started = false;   ///< Whether the opening '[' has been consumed.
+    bool finished = false;  ///< Whether the closing ']' has been consumed.
+    std::size_t objectOffset = 0; ///< Byte offset of the last task object returned.
+    std::size_t objectLength = 0; ///< Byte length of the last task object returned.
+public:
+
+    /**
+     * @brief Constructs a parser over the given JSON array.
+     * @param json The store contents; must outlive the parser.
+     */
+    explicit TaskParser(std::string_view json);
+
+    /**
+     * @brief Parses the next task in the array.
+     * @param allocator The allocator the task's description is stored with.
+     * @return The parsed Task, or std::nullopt once the array is exhausted.
+     * @throws std::runtime_error If the JSON is malformed or a task has no id.
+     */
+    std::optional<Task> next(const Task::allocator_type& allocator = {});
+
+    /**
+     * @brief Scans the next task in the array, decoding only its id.
+     * @return The task id, or std::nullopt once the array is exhausted.
+     * @throws std::runtime_error If the JSON is malformed or a task has no id.
+     * @note Descriptions are skipped without being unescaped, which makes this much cheaper than next().
+     */
+    std::optional<int> scanNext();
+
+    /**
+     * @brief Gets the byte offset of the last task object returned by next() or scanNext().
+     * @return The offset of the object's opening '{'.
+     */
+    std::size_t lastObjectOffset() const;
+
+    /**
+     * @brief Gets the byte length of the last task object returned by next() or scanNext().
+     * @return The length of the object, from '{' to '}' inclusive.
+     */
+    std::size_t lastObjectLength() const;
+
+    /**
+     * @brief Parses a single task object at the reader's position.
+     * @param reader The reader positioned at a '{'.
+     * @param key Scratch buffer used for object keys.
+     * @param text Scratch buffer used for string values.
+     * @param allocator The allocator the task's description is stored with.
+     * @return The parsed Task.
+     * @throws std::runtime_error If the object is malformed or has no id.
+     */
+    static Task parseObject(JsonReader& reader, std::string& key, std::string& text,
+                            const Task::allocator_type& allocator = {});
+
+    /**
+     * @brief Splits a JSON array of task objects into runs of whole objects.
+     * @param json The store contents.
+     * @param parts The number of runs wanted.
+     * @return At most `parts` runs of about equal size, in array order, or an empty vector if the
+     *         input does not look like a non-empty array.
+     * @note A structural pre-scan: it only tracks strings, escapes and nesting depth, and cuts
+     *       before a '{' at the top level of the array. Each run holds comma-separated objects
+     *       (the trailing comma included), so runs can be decoded independently with parseRun().
+     */
+    static std::vector<std::string_view> split(std::string_view json, std::size_t parts);
+
+    /**
+     * @brief Parses every task object in a run returned by split().
+     * @param run The run to parse.
+     * @param last Whether this is the last run of the array, which must not end with a comma.
+     * @param into The vector the parsed tasks are appended to, in order.
+     * @param allocator The allocator the tasks' descriptions are stored with.
+     * @throws std::runtime_error If the run is malformed or a task has no id.
+     */
+    static void parseRun(std::string_view run, bool last, std::vector<Task>& into,
+                         const Task::allocator_type& allocator = {});
+
+private:
+
+    /**
+     * @brief Advances past the array punctuation preceding the next task object.
+     * @return True if another task object follows, false once the array is exhausted.
+     */
+    bool advance();
+};
+
+#endif
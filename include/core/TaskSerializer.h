@@ -0,0 +1,95 @@
+#ifndef TASK_SERIALIZER_H
+#define TASK_SERIALIZER_H
+
+#include "core/TaskView.h"
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+/**
+ * @class TaskSerializer
+ * @brief Encodes tasks as JSON into a single reusable output buffer.
+ *
+ * The TaskSerializer is the write-side counterpart of TaskParser. Integers are formatted with
+ * std::to_chars, status keys come from a precomputed table, and descriptions are escaped
+ * (quotes, backslashes and control characters) in bulk runs, so encoding a task never creates
+ * temporary strings. Callers stream large outputs by calling flush() whenever size() passes
+ * FLUSH_THRESHOLD; each flush is a single write.
+ */
+class TaskSerializer {
+private:
+    std::string buffer; ///< Encoded output not yet flushed.
+public:
+
+    /// Buffered bytes after which streaming callers should flush.
+    static constexpr std::size_t FLUSH_THRESHOLD = 1 << 20;
+
+    /**
+     * @brief Appends text to the output verbatim.
+     * @param text The text to append.
+     */
+    void appendRaw(std::string_view text);
+
+    /**
+     * @brief Appends a JSON string literal, escaping it as needed.
+     * @param text The unescaped string.
+     */
+    void appendString(std::string_view text);
+
+    /**
+     * @brief Appends a JSON integer.
+     * @param value The value to append.
+     */
+    void appendInteger(long long value);
+
+    /**
+     * @brief Appends a task as a JSON object.
+     * @param task The task to encode.
+     * @note Produces {"id":<id>,"description":"<desc>","status":"<key>","createdAt":<time>,"updatedAt":<time>}.
+     */
+    void appendTask(const TaskView& task);
+
+    /**
+     * @brief Reserves buffer space for the given number of bytes.
+     * @param bytes The expected size of the output.
+     */
+    void reserve(std::size_t bytes);
+
+    /**
+     * @brief Gets the number of buffered bytes.
+     * @return The buffer size.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Checks whether the buffer is empty.
+     * @return True if nothing is buffered.
+     */
+    bool empty() const;
+
+    /**
+     * @brief Gets the buffered output.
+     * @return A view of the buffer, valid until the next append or clear.
+     */
+    std::string_view view() const;
+
+    /**
+     * @brief Moves the buffered output out of the serializer.
+     * @return The encoded text; the serializer is left empty.
+     */
+    std::string take();
+
+    /**
+     * @brief Discards the buffered output, keeping its capacity.
+     */
+    void clear();
+
+    /**
+     * @brief Writes the buffered output to a stream in a single write and clears it.
+     * @param out The destination stream.
+     */
+    void flush(std::ostream& out);
+};
+
+#endif
@@ -1,8 +1,9 @@
 #ifndef TASK_STATUS_H
 #define TASK_STATUS_H
 
-#include <string>
-#include <unordered_map>
+#include <array>
+#include <cstddef>
+#include <string_view>
 
 /**
  * @enum TaskStatus
@@ -26,30 +27,69 @@ enum class TaskStatus{
  *
  * This namespace contains helper functions to work with the TaskStatus enum, including
  * converting statuses to human-readable labels, machine-readable keys, and parsing keys
- * back to TaskStatus values.
+ * back to TaskStatus values. The tables are constexpr arrays indexed by the enum value, so
+ * every conversion is an array access or a single string comparison, without allocating.
  */
 namespace TaskUtils{
 
+  /// Number of TaskStatus values, including UNKNOWN.
+  inline constexpr std::size_t STATUS_COUNT = static_cast<std::size_t>(TaskStatus::UNKNOWN) + 1;
+
+  /// Human-readable labels indexed by TaskStatus value.
+  inline constexpr std::array<std::string_view, STATUS_COUNT> STATUS_LABELS = {
+    "Todo", "In progress", "Done", "Deleted", "Unknown",
+  };
+
+  /// Machine-readable keys, as stored in tasks.json, indexed by TaskStatus value.
+  inline constexpr std::array<std::string_view, STATUS_COUNT> STATUS_KEYS = {
+    "todo", "in_progress", "done", "deleted", "unknown",
+  };
+
   /**
    * @brief Converts a TaskStatus enum value to a human-readable label.
    * @param status The TaskStatus value to convert.
-   * @return A string label (e.g., "Todo", "In progress", "Done"), or "Unknown" if not found.
+   * @return A label (e.g., "Todo", "In progress", "Done"), or "Unknown" for values outside the enum.
    */
-  std::string statusToLabel(TaskStatus status);
+  constexpr std::string_view statusToLabel(TaskStatus status) {
+    const auto index = static_cast<std::size_t>(status);
+    return index < STATUS_COUNT ? STATUS_LABELS[index] : STATUS_LABELS.back();
+  }
+
   /**
    * @brief Converts a TaskStatus enum value to a machine-readable key.
    * @param status The TaskStatus value to convert.
-   * @return A string key (e.g., "todo", "in_progress", "done"), or "unknown" if not found.
+   * @return A key (e.g., "todo", "in_progress", "done"), or "unknown" for values outside the enum.
    */
-  std::string statusToKey(TaskStatus status);
+  constexpr std::string_view statusToKey(TaskStatus status) {
+    const auto index = static_cast<std::size_t>(status);
+    return index < STATUS_COUNT ? STATUS_KEYS[index] : STATUS_KEYS.back();
+  }
 
   /**
-   *
    * @brief Converts a machine-readable key to a TaskStatus enum value.
-   * @param key The string key to parse (e.g., "todo", "done").
-   * @return The corresponding TaskStatus value, or TaskStatus::UNKNOWN if not recognized.
+   * @param key The key to parse (e.g., "todo", "done").
+   * @return The corresponding TaskStatus value, or TaskStatus::UNKNOWN if the key is not recognized.
+   * @note The length and first character pick the only possible status, so at most one string
+   *       comparison is made; the static_assert below keeps this in step with STATUS_KEYS.
    */
-  TaskStatus keyToStatus(const std::string& key);
+  constexpr TaskStatus keyToStatus(std::string_view key) {
+    TaskStatus candidate;
+    switch(key.size()) {
+      case 4: candidate = key[0] == 't' ? TaskStatus::TODO : TaskStatus::DONE; break;
+      case 7: candidate = TaskStatus::DELETED; break;
+      case 11: candidate = TaskStatus::IN_PROGRESS; break;
+      default: return TaskStatus::UNKNOWN;
+    }
+    return key == statusToKey(candidate) ? candidate : TaskStatus::UNKNOWN;
+  }
+
+  static_assert([] {
+    for(std::size_t i = 0; i < STATUS_COUNT; ++i) {
+      if(STATUS_LABELS[i].empty() || STATUS_KEYS[i].empty()) return false;
+      if(i + 1 < STATUS_COUNT && keyToStatus(STATUS_KEYS[i]) != static_cast<TaskStatus>(i)) return false;
+    }
+    return keyToStatus(STATUS_KEYS.back()) == TaskStatus::UNKNOWN;
+  }(), "every TaskStatus needs a label and a key, and keyToStatus() must parse every key");
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,253 @@
+#ifndef TASK_TABLE_H
+#define TASK_TABLE_H
+
+#include "core/TaskView.h"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @struct TaskFilter
+ * @brief Selection criteria for scanning a TaskTable.
+ *
+ * Tasks with TaskStatus::DELETED are tombstones kept until the store is compacted; they are only
+ * selected by a filter on that status.
+ */
+struct TaskFilter {
+    std::optional<TaskStatus> status;        ///< Only select tasks with this status; without one, all but deleted tasks.
+    std::optional<std::time_t> updatedFrom;  ///< Only select tasks updated at or after this time.
+    std::optional<std::time_t> updatedUntil; ///< Only select tasks updated before this time.
+};
+
+/**
+ * @enum TaskOrder
+ * @brief The order in which a TaskQuery returns tasks.
+ */
+enum class TaskOrder {
+    ID,          ///< Ascending ID.
+    UPDATED,     ///< Least recently updated first; ties by ascending ID.
+    RECENT       ///< Most recently updated first; ties by descending ID.
+};
+
+/**
+ * @struct TaskCursor
+ * @brief A position in the order of a TaskQuery: the last task of the previous page.
+ */
+struct TaskCursor {
+    std::time_t updatedAt = 0; ///< Last updated time of that task; only compared in TaskOrder::UPDATED and RECENT.
+    int id = 0;                ///< ID of that task.
+};
+
+/**
+ * @struct TaskQuery
+ * @brief A filter plus the order and the page of the tasks to return.
+ *
+ * Pages are taken after the cursor, if any: offset matching tasks are skipped and then at most
+ * limit tasks are returned. A cursor costs a lookup, while an offset costs a walk over the
+ * skipped tasks, so paging through large results should pass the last task as the next cursor.
+ */
+struct TaskQuery {
+    TaskFilter filter;                 ///< Which tasks to return.
+    TaskOrder order = TaskOrder::ID;   ///< In which order to return them.
+    std::size_t limit = SIZE_MAX;      ///< At most how many to return.
+    std::size_t offset = 0;            ///< How many tasks to skip first.
+    std::optional<TaskCursor> after;   ///< Only return tasks strictly after this position in the order.
+
+    /**
+     * @brief Gets how many tasks must be found to fill the page, including skipped ones.
+     * @return offset + limit, saturated at SIZE_MAX.
+     */
+    std::size_t end() const { return limit > SIZE_MAX - offset ? SIZE_MAX : offset + limit; }
+};
+
+/**
+ * @class TaskTable
+ * @brief A columnar (structure-of-arrays) copy of the tasks, ordered by ID.
+ *
+ * Each task attribute lives in its own contiguous array, and descriptions are packed back to
+ * back in a string arena. Filtering by status or timestamp therefore scans a few dense arrays
+ * instead of chasing map nodes and heap-allocated strings, using the SIMD kernels in
+ * FilterKernels. Rows are read back as TaskView objects.
+ *
+ * The rows are split into chunks of about CHUNK_ROWS rows, each with its own columns and arena,
+ * held through shared pointers. Copying a table only copies those pointers, and a mutation
+ * clones the one chunk it touches if another copy still shares it. The daemon publishes a copy
+ * after every write batch, so a publish costs O(n / CHUNK_ROWS) plus one chunk per changed row.
+ */
+class TaskTable {
+public:
+
+    /// Rows filtered in the first block of an ID order page; later blocks double in size.
+    static constexpr std::size_t PAGE_BLOCK_ROWS = 4096;
+
+    /// Rows per chunk: appends start a new chunk once the last one is full, inserts split a chunk at twice this.
+    static constexpr std::size_t CHUNK_ROWS = 4096;
+
+private:
+
+    /**
+     * @struct Chunk
+     * @brief The columns of a run of consecutive rows, and the arena their descriptions live in.
+     */
+    struct Chunk {
+        std::vector<std::int32_t> ids;         ///< Task IDs, ascending.
+        std::vector<std::uint8_t> statuses;    ///< TaskStatus values, one byte per task.
+        std::vector<std::int64_t> createdAts;  ///< Creation timestamps.
+        std::vector<std::int64_t> updatedAts;  ///< Last updated timestamps.
+        std::vector<std::uint64_t> descriptionOffsets; ///< Offsets of descriptions in the arena.
+        std::vector<std::uint32_t> descriptionLengths; ///< Lengths of descriptions in the arena.
+        std::string arena;                     ///< Description bytes, back to back.
+        std::size_t garbageBytes = 0;          ///< Arena bytes no longer referenced by any row.
+        std::size_t deletedRows = 0;           ///< Rows with TaskStatus::DELETED.
+
+        TaskView row(std::size_t row) const;               ///< Gets a view of a row of the chunk.
+        void push(const TaskView& task);                   ///< Appends a row.
+        void set(std::size_t row, const TaskView& task);   ///< Overwrites a row, re-storing the description only if it changed.
+        void insert(std::size_t row, const TaskView& task); ///< Inserts a row before the given one.
+        void erase(std::size_t row);                       ///< Removes a row.
+        std::uint64_t store(std::string_view description); ///< Appends a description to the arena, returning its offset.
+        void compactArena();                               ///< Rewrites the arena without garbage once it makes up half of it.
+    };
+
+    std::vector<std::shared_ptr<Chunk>> chunks; ///< The rows, in ID order; possibly shared with copies of the table.
+    std::vector<std::size_t> chunkStarts;       ///< Index of the first row of each chunk.
+    std::size_t rowCount = 0;                   ///< Rows in all chunks.
+public:
+
+    /**
+     * @brief Removes every row.
+     * @note Chunks still shared with copies of the table stay alive in those copies.
+     */
+    void clear();
+
+    /**
+     * @brief Reserves capacity for the given number of rows.
+     * @param rows The expected number of tasks.
+     */
+    void reserve(std::size_t rows);
+
+    /**
+     * @brief Appends a row; the task ID must be greater than every existing ID.
+     * @param task The task to append.
+     */
+    void append(const TaskView& task);
+
+    /**
+     * @brief Inserts or replaces the row for a task, keeping rows ordered by ID.
+     * @param task The task to store.
+     */
+    void upsert(const TaskView& task);
+
+    /**
+     * @brief Removes the row for a task.
+     * @param id The ID of the task to remove.
+     * @note No effect if the ID is not in the table.
+     */
+    void erase(int id);
+
+    /**
+     * @brief Gets the number of rows.
+     * @return The number of tasks in the table.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Finds the row of a task by ID.
+     * @param id The ID of the task to find.
+     * @return The row index, or std::nullopt if not found.
+     */
+    std::optional<std::size_t> find(int id) const;
+
+    /**
+     * @brief Gets a view of a row.
+     * @param row The row index.
+     * @return A view whose description points into the table's arena.
+     */
+    TaskView row(std::size_t row) const;
+
+    /**
+     * @brief Gets the number of chunks the columns are split into.
+     * @return The number of chunks; the column accessors take a chunk index below it.
+     */
+    std::size_t chunkCount() const;
+
+    /**
+     * @brief Gets the ID column of a chunk.
+     * @param chunk The chunk index.
+     * @return The task IDs of the chunk, ascending.
+     */
+    std::span<const std::int32_t> idColumn(std::size_t chunk) const;
+
+    /**
+     * @brief Gets the status column of a chunk.
+     * @param chunk The chunk index.
+     * @return The task statuses of the chunk as one byte per task.
+     */
+    std::span<const std::uint8_t> statusColumn(std::size_t chunk) const;
+
+    /**
+     * @brief Gets the updatedAt column of a chunk.
+     * @param chunk The chunk index.
+     * @return The last updated timestamps of the chunk.
+     */
+    std::span<const std::int64_t> updatedAtColumn(std::size_t chunk) const;
+
+    /**
+     * @brief Selects the rows matching a filter.
+     * @param filter The selection criteria.
+     * @return The matching row indexes, ascending.
+     */
+    std::vector<std::size_t> select(const TaskFilter& filter) const;
+
+    /**
+     * @brief Selects, orders and pages rows.
+     * @param query The filter, order and page.
+     * @return The matching row indexes in the requested order, at most query.limit of them.
+     * @note Pages in ID order cost O(log n) plus the rows scanned to fill them. Other orders scan
+     *       the whole table; TaskManager::queryTasks() answers them from its secondary indexes.
+     */
+    std::vector<std::size_t> query(const TaskQuery& query) const;
+
+private:
+
+    /**
+     * @brief Appends the rows of [begin, end) that match a filter.
+     * @param filter The selection criteria.
+     * @param begin The first row to test.
+     * @param end The row after the last one to test.
+     * @param rows Receives the matching row indexes, ascending.
+     */
+    void selectRange(const TaskFilter& filter, std::size_t begin, std::size_t end, std::vector<std::size_t>& rows) const;
+
+    /**
+     * @brief Gets the chunk holding a row.
+     * @param row The row index, below size().
+     * @return The chunk index.
+     */
+    std::size_t chunkOf(std::size_t row) const;
+
+    /**
+     * @brief Gets the chunk a task with the given ID belongs in.
+     * @param id The task ID.
+     * @return The first chunk whose last ID is at least id, or chunkCount() if id is past every row.
+     */
+    std::size_t chunkFor(int id) const;
+
+    /**
+     * @brief Gets a chunk for writing, cloning it first if a copy of the table shares it.
+     * @param chunk The chunk index.
+     * @return The chunk, owned by this table alone.
+     */
+    Chunk& writable(std::size_t chunk);
+
+    /**
+     * @brief Moves the second half of an oversized chunk into a new chunk after it.
+     * @param chunk The chunk index.
+     */
+    void split(std::size_t chunk);
+};
+
+#endif
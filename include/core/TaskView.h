@@ -0,0 +1,85 @@
+#ifndef TASK_VIEW_H
+#define TASK_VIEW_H
+
+#include "core/Task.h"
+#include <string_view>
+
+/**
+ * @class TaskView
+ * @brief A lightweight, non-owning view of a task's fields.
+ *
+ * A TaskView exposes the same read accessors as Task, but its description is a std::string_view
+ * into storage owned by someone else (a Task, or a memory-mapped store file). Views are cheap to
+ * copy and let read-only paths such as listing and lookups avoid materializing Task objects.
+ * A view is only valid while the storage it points into is alive and unmodified.
+ */
+class TaskView {
+private:
+    int id; ///< Unique identifier for the task.
+    std::string_view description; ///< Description, borrowed from the owning storage.
+    TaskStatus status; ///< Current status of the task.
+    std::time_t createdAt; ///< Timestamp when the task was created.
+    std::time_t updatedAt; ///< Timestamp when the task was last updated.
+public:
+
+    /**
+     * @brief Constructs a view with the specified attributes.
+     * @param id The unique identifier for the task.
+     * @param description The task description; must outlive the view.
+     * @param status The status of the task.
+     * @param createdAt The creation timestamp of the task.
+     * @param updatedAt The last updated timestamp of the task.
+     */
+    TaskView(int id, std::string_view description, TaskStatus status, std::time_t createdAt, std::time_t updatedAt);
+
+    /**
+     * @brief Constructs a view over an existing task.
+     * @param task The task to view; must outlive the view.
+     */
+    TaskView(const Task& task);
+
+    /**
+     * @brief Gets the task's unique identifier.
+     * @return The task ID.
+     */
+    int getId() const;
+
+    /**
+     * @brief Gets the task's description.
+     * @return A view of the task description.
+     */
+    std::string_view getDescription() const;
+
+    /**
+     * @brief Gets the task's current status.
+     * @return The task status as a TaskStatus enum value.
+     */
+    TaskStatus getStatus() const;
+
+    /**
+     * @brief Gets the task's creation timestamp.
+     * @return The creation time as a std::time_t value.
+     */
+    std::time_t getCreatedAt() const;
+
+    /**
+     * @brief Gets the task's last updated timestamp.
+     * @return The last updated time as a std::time_t value.
+     */
+    std::time_t getUpdatedAt() const;
+
+    /**
+     * @brief Copies the viewed fields into an owning Task.
+     * @param allocator The allocator the task's description is stored with.
+     * @return A Task with the same attributes.
+     */
+    Task toTask(const Task::allocator_type& allocator = {}) const;
+
+    /**
+     * @brief Converts the task to a human-readable string representation.
+     * @return A string describing the task's attributes.
+     */
+    std::string toString() const;
+};
+
+#endif
@@ -0,0 +1,135 @@
+#ifndef TEXT_INDEX_H
+#define TEXT_INDEX_H
+
+#include "core/MappedFile.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @class TextIndex
+ * @brief A persisted inverted index over task descriptions: term -> sorted list of task IDs.
+ *
+ * The index is stored next to the store (tasks.json.fts) as a header, a term table sorted by
+ * term, the posting lists and the term text, followed by a log of changed tasks. It is
+ * memory-mapped, so looking up a term or a term prefix is a binary search over the term table.
+ * Changes are kept in memory on top of the mapped index and appended to the log on commit(),
+ * so adding, updating or deleting a task never rewrites the whole index; the log is merged
+ * into the term table once it grows past a threshold. Like TaskIndex, the header records the
+ * size, modification time and StoreLock version of the store it matches.
+ */
+class TextIndex {
+private:
+    std::string storePath; ///< Path of the indexed store.
+    std::string indexPath; ///< Path of the index file.
+    MappedFile file;       ///< Mapped index file.
+    std::string built;     ///< Term table built in memory by build(), not yet written.
+    std::string_view image; ///< Term table being queried: the mapped file or built.
+    std::uint64_t logSize = 0; ///< Bytes of log records in the file.
+    std::map<int, std::vector<std::string>> changed; ///< Terms of tasks changed since the term table was written; empty if deleted.
+    std::string pending;   ///< Log records not yet written.
+    bool opened = false;   ///< Whether the index holds the terms of the store.
+public:
+
+    /**
+     * @brief Splits text into the terms it is indexed under.
+     * @param text The text to split.
+     * @return The distinct terms, lowercased, in ascending order.
+     * @note Terms are runs of ASCII letters and digits and of non-ASCII (UTF-8) bytes.
+     */
+    static std::vector<std::string> tokenize(std::string_view text);
+
+    /**
+     * @brief Checks whether a store has an index file.
+     * @param storePath The store.
+     * @return True if the index file exists, whether or not it is up to date.
+     */
+    static bool exists(const std::string& storePath);
+
+    /**
+     * @brief Opens the index of a store if it is up to date.
+     * @param storePath The store.
+     * @param storeVersion The current StoreLock version of the store.
+     * @return False if the index is missing, stale or damaged; it must then be built.
+     * @throws std::runtime_error If the index file cannot be mapped.
+     */
+    bool open(const std::string& storePath, std::uint64_t storeVersion);
+
+    /**
+     * @brief Builds the index in memory from every task of a store.
+     * @param storePath The store.
+     * @param documents The ID and description of every task, in ascending ID order.
+     * @note Nothing is written until commit().
+     */
+    void build(const std::string& storePath, const std::vector<std::pair<int, std::string_view>>& documents);
+
+    /**
+     * @brief Checks whether the index is open or built.
+     * @return True if queries and changes are possible.
+     */
+    bool isOpen() const;
+
+    /**
+     * @brief Indexes the description of an added or updated task, replacing its old terms.
+     * @param id The ID of the task.
+     * @param description The new description.
+     */
+    void put(int id, std::string_view description);
+
+    /**
+     * @brief Removes a deleted task from the index.
+     * @param id The ID of the task.
+     */
+    void remove(int id);
+
+    /**
+     * @brief Writes the changes since the last commit and stamps the index with the store's state.
+     * @param storeVersion The StoreLock version the store was saved as.
+     * @throws std::runtime_error If the index file cannot be written.
+     * @note Call after the store is written, under the exclusive store lock.
+     */
+    void commit(std::uint64_t storeVersion);
+
+    /**
+     * @brief Finds the tasks whose descriptions match a query.
+     * @param query Words separated by whitespace. Every word must match (AND); "OR" between
+     *              words separates alternatives, and binds looser than AND. A word ending in
+     *              '*' matches every term starting with it.
+     * @return The matching task IDs in ascending order.
+     */
+    std::vector<int> search(std::string_view query) const;
+
+    /**
+     * @brief Unmaps the index and discards unwritten changes.
+     */
+    void close();
+
+private:
+
+    /**
+     * @brief Finds the tasks indexed under a term.
+     * @param term A lowercased term.
+     * @param prefix Whether every term starting with term matches.
+     * @return The task IDs in ascending order.
+     */
+    std::vector<int> match(std::string_view term, bool prefix) const;
+
+    /**
+     * @brief Applies log records to the changed tasks.
+     * @param records The encoded records.
+     * @return False if the records are torn or malformed.
+     */
+    bool replay(std::string_view records);
+
+    /**
+     * @brief Merges the changed tasks into the term table and writes a fresh index file.
+     * @param storeVersion The StoreLock version to stamp the index with.
+     * @throws std::runtime_error If the index file cannot be written.
+     */
+    void compact(std::uint64_t storeVersion);
+};
+
+#endif
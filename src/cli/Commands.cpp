@@ -1,5 +1,289 @@
 #include <cli/Commands.h>
+#include <cli/TaskPrinter.h>
+#include <core/Stats.h>
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+    /**
+     * @brief Splits a batch line into whitespace-separated arguments.
+     * @param line The line to split.
+     * @return The arguments, with surrounding double quotes removed.
+     * @throws std::invalid_argument If a quoted argument is not terminated.
+     * @note Inside double quotes, \" and \\ escape a quote and a backslash.
+     */
+    std::vector<std::string> splitArguments(const std::string& line) {
+        std::vector<std::string> arguments;
+        std::size_t pos = 0;
+        while (true) {
+            pos = line.find_first_not_of(" \t\r", pos);
+            if (pos == std::string::npos) break;
+
+            std::string argument;
+            if (line[pos] == '"') {
+                ++pos;
+                while (pos < line.size() && line[pos] != '"') {
+                    if (line[pos] == '\\' && pos + 1 < line.size()) ++pos;
+                    argument += line[pos++];
+                }
+                if (pos >= line.size()) throw std::invalid_argument("unterminated quote");
+                ++pos;
+            } else {
+                std::size_t end = line.find_first_of(" \t\r", pos);
+                if (end == std::string::npos) end = line.size();
+                argument = line.substr(pos, end - pos);
+                pos = end;
+            }
+            arguments.push_back(std::move(argument));
+        }
+        return arguments;
+    }
+
+    /**
+     * @brief Parses a task ID argument.
+     * @throws std::invalid_argument If the argument is not a number.
+     */
+    int parseId(const std::string& argument) {
+        std::size_t parsed = 0;
+        int id = 0;
+        try {
+            id = std::stoi(argument, &parsed);
+        } catch (const std::exception&) {
+            parsed = 0;
+        }
+        if (parsed == 0 || parsed != argument.size()) throw std::invalid_argument("invalid id: " + argument);
+        return id;
+    }
+
+    /**
+     * @brief Parses the task ID argument of a single-task command.
+     * @return The ID, or std::nullopt after reporting an invalid argument.
+     */
+    std::optional<int> idArgument(const std::string& argument) {
+        try {
+            return parseId(argument);
+        } catch (const std::invalid_argument&) {
+            CLI::err() << "Invalid id: " << argument << std::endl;
+            return std::nullopt;
+        }
+    }
+
+    /**
+     * @brief Parses a --since/--until argument.
+     * @param argument Unix epoch seconds, or a local date "YYYY-MM-DD" with an optional "THH:MM[:SS]".
+     * @return The timestamp, or std::nullopt if the argument is not a time.
+     */
+    std::optional<std::time_t> parseTime(const std::string& argument) {
+        if (!argument.empty() && argument.find_first_not_of("0123456789") == std::string::npos) {
+            return static_cast<std::time_t>(std::stoll(argument));
+        }
+
+        std::tm time{};
+        std::istringstream in(argument);
+        in >> std::get_time(&time, "%Y-%m-%d");
+        if (in.fail()) return std::nullopt;
+        if (in.peek() == 'T') {
+            in.get();
+            in >> std::get_time(&time, "%H:%M");
+            if (in.fail()) return std::nullopt;
+            if (in.peek() == ':') {
+                in.get();
+                in >> std::get_time(&time, "%S");
+                if (in.fail()) return std::nullopt;
+            }
+        }
+        if (in.peek() != std::char_traits<char>::eof()) return std::nullopt;
+        time.tm_isdst = -1;
+        return std::mktime(&time);
+    }
+
+    /**
+     * @brief Parses a status as written on the command line.
+     * @param argument A status key, with '-' accepted in place of '_' (e.g. "in-progress").
+     * @return The status, or TaskStatus::UNKNOWN if the argument names no status.
+     */
+    TaskStatus parseStatusArgument(std::string argument) {
+        std::replace(argument.begin(), argument.end(), '-', '_');
+        return TaskUtils::keyToStatus(argument);
+    }
+
+    /**
+     * @brief Writes a status as on the command line, the inverse of parseStatusArgument().
+     * @param status The status to write.
+     * @return The status key with '-' in place of '_' (e.g. "in-progress").
+     */
+    std::string statusArgument(TaskStatus status) {
+        std::string argument(TaskUtils::statusToKey(status));
+        std::replace(argument.begin(), argument.end(), '_', '-');
+        return argument;
+    }
+
+    /**
+     * @brief Checks whether a task exists and is not soft-deleted.
+     * @param manager The TaskManager instance to query.
+     * @param id The ID of the task.
+     * @return False for missing tasks and tombstones, which commands treat alike.
+     */
+    bool isLive(const TaskManager& manager, int id) {
+        auto task = manager.findTaskView(id);
+        return task && task->getStatus() != TaskStatus::DELETED;
+    }
+
+    /**
+     * @brief Prints per-status task counts and their total.
+     * @param counts Task counts indexed by TaskStatus value.
+     * @note TaskStatus::UNKNOWN is only listed when some task has it.
+     */
+    void printStatusCounts(const std::array<std::size_t, TaskUtils::STATUS_COUNT>& counts) {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < counts.size(); ++i) {
+            total += counts[i];
+            if (static_cast<TaskStatus>(i) == TaskStatus::UNKNOWN && counts[i] == 0) continue;
+            CLI::out() << TaskUtils::STATUS_LABELS[i] << ": " << counts[i] << "\n";
+        }
+        CLI::out() << "Total: " << total << std::endl;
+    }
+
+    /**
+     * @brief Encodes the position of a task as a --after cursor.
+     * @param task The last task of a page.
+     * @param order The order of the page.
+     * @return "i<id>" in ID order, or "u<updatedAt>.<id>" in the updatedAt orders.
+     */
+    std::string formatCursor(const TaskView& task, TaskOrder order) {
+        std::string cursor(1, order == TaskOrder::ID ? 'i' : 'u');
+        if (order != TaskOrder::ID) cursor += std::to_string(static_cast<long long>(task.getUpdatedAt())) + ".";
+        cursor += std::to_string(task.getId());
+        return cursor;
+    }
+
+    /**
+     * @brief Decodes a --after cursor written by formatCursor().
+     * @param argument The cursor.
+     * @param order The order of the query, which must be the one the cursor was written for.
+     * @return The position, or std::nullopt if the argument is not a cursor for this order.
+     */
+    std::optional<TaskCursor> parseCursor(const std::string& argument, TaskOrder order) {
+        const bool byId = order == TaskOrder::ID;
+        if (argument.empty() || argument.front() != (byId ? 'i' : 'u')) return std::nullopt;
+        TaskCursor cursor;
+        std::string_view rest = std::string_view(argument).substr(1);
+        if (!byId) {
+            std::size_t dot = rest.find('.');
+            if (dot == std::string_view::npos) return std::nullopt;
+            long long updatedAt = 0;
+            auto [end, error] = std::from_chars(rest.data(), rest.data() + dot, updatedAt);
+            if (error != std::errc() || end != rest.data() + dot) return std::nullopt;
+            cursor.updatedAt = static_cast<std::time_t>(updatedAt);
+            rest.remove_prefix(dot + 1);
+        }
+        auto [end, error] = std::from_chars(rest.data(), rest.data() + rest.size(), cursor.id);
+        if (rest.empty() || error != std::errc() || end != rest.data() + rest.size()) return std::nullopt;
+        return cursor;
+    }
+
+    /**
+     * @brief Tells how to fetch the next page after printing a full one.
+     * @param query The query that was printed.
+     * @param count The number of tasks printed.
+     * @param last The last task printed.
+     * @note Written to the error stream, so piped output only contains tasks.
+     */
+    void printNextCursor(const TaskQuery& query, std::size_t count, const TaskView& last) {
+        if (query.limit == SIZE_MAX || count == 0 || count < query.limit) return;
+        CLI::err() << "Next page: --after " << formatCursor(last, query.order) << std::endl;
+    }
+
+    /**
+     * @brief Parses the arguments of list into a query.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (optional status filter at argv[2], then options).
+     * @param query Receives the filter, order and page.
+     * @param format Receives the output format.
+     * @return False after printing an error if an argument is invalid.
+     */
+    bool parseListQuery(int argc, char* argv[], TaskQuery& query, CLI::OutputFormat& format) {
+        std::optional<std::string> after;
+        for (int i = 2; i < argc; ++i) {
+            std::string argument = argv[i];
+            if (!argument.starts_with("--")) {
+                if (i != 2) {
+                    CLI::err() << "Unexpected argument: " << argument << std::endl;
+                    return false;
+                }
+                query.filter.status = parseStatusArgument(argument);
+                if (query.filter.status == TaskStatus::UNKNOWN) {
+                    CLI::err() << "Unknown task status, supported: [done, todo, in-progress, deleted]" << std::endl;
+                    return false;
+                }
+                continue;
+            }
+
+            if (i + 1 >= argc) {
+                CLI::err() << "Missing value for " << argument << std::endl;
+                return false;
+            }
+            std::string value = argv[++i];
+            if (argument == "--since" || argument == "--until") {
+                auto time = parseTime(value);
+                if (!time) {
+                    CLI::err() << "Invalid time for " << argument << ": " << value
+                               << " (expected epoch seconds or YYYY-MM-DD[THH:MM[:SS]])" << std::endl;
+                    return false;
+                }
+                (argument == "--since" ? query.filter.updatedFrom : query.filter.updatedUntil) = *time;
+            } else if (argument == "--sort") {
+                if (value == "id") query.order = TaskOrder::ID;
+                else if (value == "updated") query.order = TaskOrder::UPDATED;
+                else if (value == "recent") query.order = TaskOrder::RECENT;
+                else {
+                    CLI::err() << "Unknown sort order, supported: [id, updated, recent]" << std::endl;
+                    return false;
+                }
+            } else if (argument == "--limit" || argument == "--offset") {
+                if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos) {
+                    CLI::err() << "Invalid " << argument.substr(2) << ": " << value << std::endl;
+                    return false;
+                }
+                (argument == "--limit" ? query.limit : query.offset) = std::stoull(value);
+            } else if (argument == "--after") {
+                after = value;
+            } else if (argument == "--format") {
+                auto parsed = CLI::parseOutputFormat(value);
+                if (!parsed) {
+                    CLI::err() << "Unknown output format, supported: [human, jsonl, tsv]" << std::endl;
+                    return false;
+                }
+                format = *parsed;
+            } else {
+                CLI::err() << "Unknown option: " << argument << std::endl;
+                return false;
+            }
+        }
+        // Checked last, since the cursor depends on --sort
+        if (after) {
+            query.after = parseCursor(*after, query.order);
+            if (!query.after) {
+                CLI::err() << "Invalid cursor for this --sort: " << *after << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+}
 
 /**
  * @namespace CLI
@@ -7,6 +291,25 @@
  */
 namespace CLI {
 
+    namespace {
+        thread_local std::ostream* currentOut = &std::cout; ///< Where commands on this thread print results.
+        thread_local std::ostream* currentErr = &std::cerr; ///< Where commands on this thread print errors.
+    }
+
+    OutputScope::OutputScope(std::ostream& out, std::ostream& err) : previousOut(currentOut), previousErr(currentErr) {
+        currentOut = &out;
+        currentErr = &err;
+    }
+
+    OutputScope::~OutputScope() {
+        currentOut = previousOut;
+        currentErr = previousErr;
+    }
+
+    std::ostream& out() { return *currentOut; }
+
+    std::ostream& err() { return *currentErr; }
+
     /**
      * @brief Adds a new task to the TaskManager.
      * @param manager The TaskManager instance to modify.
@@ -14,20 +317,27 @@ namespace CLI {
      * @param argv The array of command-line arguments (expects description at argv[2]).
      * @return 0 on success, 1 on failure (e.g., insufficient arguments).
      * @note Assigns the next available ID based on the highest existing ID or 1 if empty.
-     * @note Saves changes to the store file after adding the task.
+     * @note Saves changes to the store file after adding the task. A deferred save (see
+     *       TaskManager::setDeferredSaving()) is flushed first, because saving may renumber the task.
      */
     int add(TaskManager& manager, int argc, char* argv[]) {
         if (argc < 3) {
-            std::cerr << "Usage: ./task-cli add <description>" << std::endl;
+            err() << "Usage: ./task-cli add <description>" << std::endl;
             return 1;
         }
 
-        int id = manager.getTasks().empty() ? 1 : manager.getTasks().rbegin()->first + 1;
-        Task task(id, argv[2], TaskStatus::TODO, std::time(nullptr), std::time(nullptr));
-        manager.addTask(task);
+        std::time_t now = std::time(nullptr);
+        auto task = manager.emplaceTask(manager.nextId(), argv[2], TaskStatus::TODO, now, now);
+        if (!task) {
+            err() << "Task could not be created" << std::endl;
+            return 1;
+        }
 
-        std::cout << "Task Created: " << task.toString() << std::endl;
+        // Another process may have taken the ID in the meantime; report the one that was saved
+        int id = task->getId();
         manager.saveTasksToStore();
+        manager.flushPendingSave();
+        out() << "Task Created: " << manager.findTaskView(manager.resolveId(id))->toString() << std::endl;
         return 0;
     }
 
@@ -42,22 +352,19 @@ namespace CLI {
      */
     int update(TaskManager& manager, int argc, char* argv[]) {
         if (argc < 4) {
-            std::cerr << "Usage: ./task-cli update <id> <description>" << std::endl;
+            err() << "Usage: ./task-cli update <id> <description>" << std::endl;
             return 1;
         }
 
-        int id = std::stoi(argv[2]);
-        auto taskOpt = manager.findTaskById(id);
-        if (!taskOpt) {
-            std::cerr << "Task not found" << std::endl;
+        auto parsedId = idArgument(argv[2]);
+        if (!parsedId) return 1;
+        int id = *parsedId;
+        if (!isLive(manager, id) || !manager.updateDescription(id, argv[3], std::time(nullptr))) {
+            err() << "Task not found" << std::endl;
             return 1;
         }
 
-        Task& task = taskOpt.value();
-        task.setDescription(argv[3]);
-        task.setUpdatedAt(std::time(nullptr));
-
-        std::cout << "Task Updated: " << task.toString() << std::endl;
+        out() << "Task Updated: " << manager.findTaskView(id)->toString() << std::endl;
         manager.saveTasksToStore();
         return 0;
     }
@@ -68,23 +375,58 @@ namespace CLI {
      * @param argc The number of command-line arguments.
      * @param argv The array of command-line arguments (expects ID at argv[2]).
      * @return 0 on success, 1 on failure (e.g., insufficient arguments or task not found).
+     * @note Only marks the task as deleted, so it can be restored until the store is compacted.
      * @note Saves changes to the store file after deleting the task.
      */
     int deleteTask(TaskManager& manager, int argc, char* argv[]) {
         if (argc < 3) {
-            std::cerr << "Usage: ./task-cli delete <id>" << std::endl;
+            err() << "Usage: ./task-cli delete <id>" << std::endl;
             return 1;
         }
 
-        int id = std::stoi(argv[2]);
-        auto taskOpt = manager.findTaskById(id);
-        if (!taskOpt) {
-            std::cerr << "Task not found" << std::endl;
+        auto parsedId = idArgument(argv[2]);
+        if (!parsedId) return 1;
+        int id = *parsedId;
+        if (!manager.deleteTask(id, std::time(nullptr))) {
+            err() << "Task not found" << std::endl;
             return 1;
         }
 
-        manager.removeTask(id);
-        std::cout << "Task Deleted: ID " << id << std::endl;
+        out() << "Task Deleted: ID " << id << std::endl;
+        manager.saveTasksToStore();
+        return 0;
+    }
+
+    /**
+     * @brief Brings back a deleted task.
+     * @param manager The TaskManager instance to modify.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (expects ID at argv[2], optionally followed
+     *             by the status to restore, todo by default).
+     * @return 0 on success, 1 on failure (e.g., invalid status, or no deleted task with that ID).
+     * @note Deleted tasks can be restored until the store is compacted.
+     */
+    int restore(TaskManager& manager, int argc, char* argv[]) {
+        if (argc < 3) {
+            err() << "Usage: ./task-cli restore <id> [todo|in-progress|done]" << std::endl;
+            return 1;
+        }
+
+        TaskStatus status = argc > 3 ? parseStatusArgument(argv[3]) : TaskStatus::TODO;
+        if (status == TaskStatus::DELETED || status == TaskStatus::UNKNOWN) {
+            err() << "Unknown task status, supported: [todo, in-progress, done]" << std::endl;
+            return 1;
+        }
+
+        auto parsedId = idArgument(argv[2]);
+        if (!parsedId) return 1;
+        int id = *parsedId;
+        if (!manager.restoreTask(id, status, std::time(nullptr))) {
+            err() << "Deleted task not found" << std::endl;
+            return 1;
+        }
+
+        out() << "Task Restored: " << manager.findTaskView(id)->toString() << std::endl;
         manager.saveTasksToStore();
         return 0;
     }
@@ -101,23 +443,21 @@ namespace CLI {
      */
     int changeStatus(TaskManager& manager, int argc, char* argv[], TaskStatus newStatus) {
         if (argc < 3) {
-            std::cerr << "Usage: ./task-cli mark-" << TaskUtils::statusToKey(newStatus) << " <id>" << std::endl;
+            err() << "Usage: ./task-cli mark-" << statusArgument(newStatus) << " <id>" << std::endl;
             return 1;
         }
 
-        int id = std::stoi(argv[2]);
-        auto taskOpt = manager.findTaskById(id);
-        if (!taskOpt) {
-            std::cerr << "Task not found" << std::endl;
+        auto parsedId = idArgument(argv[2]);
+        if (!parsedId) return 1;
+        int id = *parsedId;
+        if (!isLive(manager, id) || !manager.setStatus(id, newStatus, std::time(nullptr))) {
+            err() << "Task not found" << std::endl;
             return 1;
         }
 
-        Task& task = taskOpt.value();
-        task.setStatus(newStatus);
-        task.setUpdatedAt(std::time(nullptr));
-
-        std::cout << "Task Changed to: " << task.getStatusLabel() << std::endl;
-        std::cout << task.toString() << std::endl;
+        TaskView task = manager.findTaskView(id).value();
+        out() << "Task Changed to: " << TaskUtils::statusToLabel(task.getStatus()) << std::endl;
+        out() << task.toString() << std::endl;
         manager.saveTasksToStore();
         return 0;
     }
@@ -126,25 +466,391 @@ namespace CLI {
      * @brief Lists tasks from the TaskManager, optionally filtered by status.
      * @param manager The TaskManager instance to query.
      * @param argc The number of command-line arguments.
-     * @param argv The array of command-line arguments (optional status filter at argv[2]).
-     * @return 0 on success, 1 on failure (e.g., invalid status filter).
-     * @note If no status filter is provided, lists all tasks.
-     * @note Supports status filters: "done", "todo", "in_progress"; others result in an error.
+     * @param argv The array of command-line arguments (optional status filter at argv[2], then
+     *             --since <time>, --until <time>, --sort id|updated|recent, --limit <n>,
+     *             --offset <n>, --after <cursor> and --format human|jsonl|tsv).
+     * @return 0 on success, 1 on failure (e.g., invalid status filter or option).
+     * @note Answered from the manager's secondary indexes, so only the listed tasks are visited.
+     * @note When --limit fills the page, the cursor of the next page is printed to the error stream.
+     * @note Printed through a TaskPrinter, which writes large chunks instead of one flush per line.
      */
     int list(TaskManager& manager, int argc, char* argv[]) {
-        std::optional<TaskStatus> statusFilter = std::nullopt;
-        if (argc > 2) {
-            statusFilter = TaskUtils::keyToStatus(argv[2]);
-            if (statusFilter == TaskStatus::UNKNOWN) {
-                std::cerr << "Unknown task status, supported: [done, todo, in-progress]" << std::endl;
+        TaskQuery query;
+        OutputFormat format = OutputFormat::HUMAN;
+        if (!parseListQuery(argc, argv, query, format)) return 1;
+
+        std::vector<TaskView> tasks;
+        {
+            TASK_STATS_SCOPE("query");
+            tasks = manager.queryTasks(query);
+        }
+        TASK_STATS_SCOPE("print");
+        TaskPrinter printer(out(), format);
+        for (const TaskView& task : tasks) printer.print(task);
+        TASK_STATS_ADD("tasks printed", printer.count());
+        printer.flush();
+        if (!tasks.empty()) printNextCursor(query, tasks.size(), tasks.back());
+        return 0;
+    }
+
+    /**
+     * @brief Lists tasks from a table, with the same arguments as list() on a TaskManager.
+     * @param table The tasks to query.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (optional status filter at argv[2], then options).
+     * @return 0 on success, 1 on failure (e.g., invalid status filter or option).
+     * @note Only reads the table, so the daemon can run it on an immutable snapshot. Scans the
+     *       table instead of using indexes, and prints the same tasks in the same order.
+     */
+    int list(const TaskTable& table, int argc, char* argv[]) {
+        TaskQuery query;
+        OutputFormat format = OutputFormat::HUMAN;
+        if (!parseListQuery(argc, argv, query, format)) return 1;
+
+        std::vector<std::size_t> rows;
+        {
+            TASK_STATS_SCOPE("query");
+            rows = table.query(query);
+        }
+        TASK_STATS_SCOPE("print");
+        TaskPrinter printer(out(), format);
+        for (std::size_t row : rows) printer.print(table.row(row));
+        TASK_STATS_ADD("tasks printed", printer.count());
+        printer.flush();
+        if (!rows.empty()) printNextCursor(query, rows.size(), table.row(rows.back()));
+        return 0;
+    }
+
+    /**
+     * @brief Prints the tasks whose descriptions match a full-text query.
+     * @param manager The TaskManager instance to query.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (query words from argv[2] on).
+     * @return 0 on success, 1 on failure (e.g., missing query).
+     * @note Words must all match, "OR" separates alternatives and a trailing '*' matches a prefix;
+     *       see TextIndex::search(). Matches are printed in ascending ID order; deleted tasks are skipped.
+     */
+    int search(TaskManager& manager, int argc, char* argv[]) {
+        if (argc < 3) {
+            err() << "Usage: ./task-cli search <terms>" << std::endl;
+            return 1;
+        }
+
+        std::string query;
+        for (int i = 2; i < argc; ++i) {
+            if (i > 2) query += ' ';
+            query += argv[i];
+        }
+        std::vector<TaskView> tasks;
+        {
+            TASK_STATS_SCOPE("search");
+            tasks = manager.searchTasks(query);
+        }
+        TASK_STATS_SCOPE("print");
+        TaskPrinter printer(out(), OutputFormat::HUMAN);
+        for (const TaskView& task : tasks) {
+            if (task.getStatus() != TaskStatus::DELETED) printer.print(task);
+        }
+        TASK_STATS_ADD("tasks printed", printer.count());
+        return 0;
+    }
+
+    /**
+     * @brief Converts a task store between the JSON and binary formats.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (expects source at argv[2], destination at argv[3]).
+     * @return 0 on success, 1 on failure (e.g., insufficient arguments or unreadable source).
+     * @note The destination is written in the opposite format of the source.
+     * @note Any journal next to the source is replayed before converting.
+     */
+    int convert(int argc, char* argv[]) {
+        if (argc < 4) {
+            err() << "Usage: ./task-cli convert <source> <destination>" << std::endl;
+            return 1;
+        }
+
+        TaskManager source(argv[2]);
+        try {
+            source.loadTasksFromStore();
+            StoreFormat target = source.getStoreFormat() == StoreFormat::JSON ? StoreFormat::BINARY : StoreFormat::JSON;
+            source.exportStore(argv[3], target);
+            out() << "Store Converted: " << argv[2] << " -> " << argv[3]
+                      << (target == StoreFormat::BINARY ? " (binary)" : " (json)") << std::endl;
+        } catch (const std::exception& e) {
+            err() << "Error converting store: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Prints the task counts and the memory used by the arena holding the tasks.
+     * @param manager The TaskManager instance to inspect.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (no arguments expected).
+     * @return 0 on success.
+     * @note Deleted tasks are counted on their own line, since they still take arena memory until
+     *       the store is compacted.
+     * @note Reports used, reserved and peak reserved arena bytes; see ArenaStats.
+     */
+    int stats(TaskManager& manager, int argc, char* argv[]) {
+        (void)argc;
+        (void)argv;
+
+        const TaskMap& tasks = manager.getTasks();
+        std::size_t deleted = std::count_if(tasks.begin(), tasks.end(), [](const auto& entry) {
+            return entry.second.getStatus() == TaskStatus::DELETED;
+        });
+        ArenaStats arena = manager.getArenaStats();
+        out() << "Tasks: " << tasks.size() - deleted << "\n"
+                  << "Deleted: " << deleted << "\n"
+                  << "Arena Used: " << arena.usedBytes << " bytes in " << arena.allocations << " allocations\n"
+                  << "Arena Reserved: " << arena.reservedBytes << " bytes\n"
+                  << "Arena Peak: " << arena.peakReservedBytes << " bytes" << std::endl;
+        return 0;
+    }
+
+    /**
+     * @brief Prints how many tasks have each status.
+     * @param manager The TaskManager instance to query.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (no arguments expected).
+     * @return 0 on success.
+     * @note Counts through forEachTask(), so binary stores are not materialized.
+     */
+    int statusStats(TaskManager& manager, int argc, char* argv[]) {
+        (void)argc;
+        (void)argv;
+
+        std::array<std::size_t, TaskUtils::STATUS_COUNT> counts{};
+        manager.forEachTask([&counts](const TaskView& task) {
+            ++counts[std::min(static_cast<std::size_t>(task.getStatus()), counts.size() - 1)];
+        });
+        printStatusCounts(counts);
+        return 0;
+    }
+
+    /**
+     * @brief Prints how many tasks of a table have each status, like statusStats() on a TaskManager.
+     * @param table The tasks to count.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (no arguments expected).
+     * @return 0 on success.
+     * @note Reads only the one-byte status column.
+     */
+    int statusStats(const TaskTable& table, int argc, char* argv[]) {
+        (void)argc;
+        (void)argv;
+
+        std::array<std::size_t, TaskUtils::STATUS_COUNT> counts{};
+        for (std::size_t chunk = 0; chunk < table.chunkCount(); ++chunk) {
+            for (std::uint8_t status : table.statusColumn(chunk)) ++counts[std::min<std::size_t>(status, counts.size() - 1)];
+        }
+        printStatusCounts(counts);
+        return 0;
+    }
+
+    /**
+     * @brief Removes deleted tasks for good and rewrites the store without them.
+     * @param manager The TaskManager instance to compact.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (optionally --min-ratio <r>).
+     * @return 0 on success, 1 on failure (e.g., invalid ratio).
+     * @note With --min-ratio, nothing is written unless deleted tasks make up at least that share
+     *       (0 to 1) of the store, so the command can run periodically and only compact when it pays off.
+     * @note Also folds the journal into the store, like any full snapshot.
+     */
+    int compact(TaskManager& manager, int argc, char* argv[]) {
+        double minRatio = 0;
+        for (int i = 2; i < argc; ++i) {
+            std::string argument = argv[i];
+            if (argument == "--min-ratio" && i + 1 < argc) {
+                char* end = nullptr;
+                minRatio = std::strtod(argv[++i], &end);
+                if (*end != '\0' || !(minRatio >= 0 && minRatio <= 1)) {
+                    err() << "Invalid ratio: " << argv[i] << " (expected a number from 0 to 1)" << std::endl;
+                    return 1;
+                }
+            } else {
+                err() << "Usage: ./task-cli compact [--min-ratio <r>]" << std::endl;
                 return 1;
             }
         }
 
-        for (const auto& [id, task] : manager.getTasks()) {
-            if (statusFilter && task.getStatus() != statusFilter) continue;
-            std::cout << task.toString() << std::endl;
+        std::size_t total = 0, deleted = 0;
+        manager.forEachTask([&](const TaskView& task) {
+            ++total;
+            if (task.getStatus() == TaskStatus::DELETED) ++deleted;
+        });
+        if (minRatio > 0 && static_cast<double>(deleted) < minRatio * static_cast<double>(total)) {
+            out() << "Store Not Compacted: " << deleted << " of " << total << " tasks deleted" << std::endl;
+            return 0;
         }
+
+        manager.purgeDeletedTasks();
+        manager.compactStore();
+        out() << "Store Compacted: " << deleted << " deleted tasks removed, " << total - deleted << " kept" << std::endl;
         return 0;
     }
+
+    /**
+     * @brief Applies newline-delimited commands from a file or stdin in one load/save cycle.
+     * @param manager The TaskManager instance to modify.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (optional file at argv[2], "-" for stdin,
+     *             optionally followed by --save-every <n>; or the commands themselves in one or
+     *             more --lines <text> arguments, which are concatenated).
+     * @return 0 if every command succeeded, 1 otherwise.
+     * @note Supports add, update, delete, mark-in-progress and mark-done with the same arguments as
+     *       on the command line; descriptions containing spaces must be double-quoted. Blank lines
+     *       and lines starting with '#' are skipped.
+     * @note Prints one result line per command ("<line>: ok <action> <id>" or "<line>: error <message>")
+     *       followed by a throughput summary.
+     * @note --lines is how a batch is forwarded to the daemon, which cannot read the caller's files or stdin.
+     * @note Saves once at the end, or after every n successful commands with --save-every. Deferred
+     *       saves are flushed right away, so renumbered adds are reported with their saved IDs.
+     */
+    int batch(TaskManager& manager, int argc, char* argv[]) {
+        std::string source = "-";
+        std::size_t saveEvery = 0;
+        std::optional<std::string> lines;
+        for (int i = 2; i < argc; ++i) {
+            std::string argument = argv[i];
+            if (argument == "--save-every") {
+                std::string value = i + 1 < argc ? argv[++i] : "";
+                if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos) {
+                    err() << "Invalid save-every: " << value << std::endl;
+                    return 1;
+                }
+                saveEvery = std::stoul(value);
+            } else if (argument == "--lines" && i + 1 < argc) {
+                lines = lines.value_or("") + argv[++i];
+            } else {
+                source = argument;
+            }
+        }
+
+        std::ifstream file;
+        if (source != "-" && !lines) {
+            file.open(source);
+            if (!file) {
+                err() << "Failed to open batch file: " << source << std::endl;
+                return 1;
+            }
+        }
+        std::istringstream text(lines.value_or(""));
+        std::istream& in = lines ? text : source == "-" ? std::cin : file;
+
+        auto start = std::chrono::steady_clock::now();
+        std::size_t succeeded = 0, failed = 0, unsaved = 0, saves = 0, lineNumber = 0;
+        std::vector<std::pair<std::size_t, int>> addedIds; // line and ID of every add since the last save
+
+        auto save = [&] {
+            manager.saveTasksToStore();
+            manager.flushPendingSave();
+            ++saves;
+            unsaved = 0;
+            for (const auto& [line, id] : addedIds) {
+                if (int saved = manager.resolveId(id); saved != id) {
+                    out() << line << ": renumbered " << id << " -> " << saved << "\n";
+                }
+            }
+            addedIds.clear();
+        };
+
+        std::string line;
+        while (std::getline(in, line)) {
+            ++lineNumber;
+            std::size_t first = line.find_first_not_of(" \t\r");
+            if (first == std::string::npos || line[first] == '#') continue;
+
+            try {
+                std::vector<std::string> arguments = splitArguments(line);
+                const std::string& action = arguments[0];
+                std::time_t now = std::time(nullptr);
+                int id = 0;
+
+                if (action == "add" && arguments.size() == 2) {
+                    auto task = manager.emplaceTask(manager.nextId(), arguments[1], TaskStatus::TODO, now, now);
+                    if (!task) throw std::runtime_error("task could not be created");
+                    id = task->getId();
+                    addedIds.emplace_back(lineNumber, id);
+                } else if (action == "update" && arguments.size() == 3) {
+                    id = parseId(arguments[1]);
+                    if (!isLive(manager, id) || !manager.updateDescription(id, arguments[2], now)) {
+                        throw std::runtime_error("task not found");
+                    }
+                } else if (action == "delete" && arguments.size() == 2) {
+                    id = parseId(arguments[1]);
+                    if (!manager.deleteTask(id, now)) throw std::runtime_error("task not found");
+                } else if ((action == "mark-in-progress" || action == "mark-done") && arguments.size() == 2) {
+                    id = parseId(arguments[1]);
+                    TaskStatus status = action == "mark-done" ? TaskStatus::DONE : TaskStatus::IN_PROGRESS;
+                    if (!isLive(manager, id) || !manager.setStatus(id, status, now)) throw std::runtime_error("task not found");
+                } else {
+                    throw std::invalid_argument("unsupported command: " + line);
+                }
+
+                out() << lineNumber << ": ok " << action << " " << id << "\n";
+                ++succeeded;
+                if (++unsaved == saveEvery) save();
+            } catch (const std::exception& e) {
+                out() << lineNumber << ": error " << e.what() << "\n";
+                ++failed;
+            }
+        }
+        if (unsaved > 0) save();
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        out() << "Batch: " << succeeded + failed << " commands (" << succeeded << " ok, " << failed << " failed), "
+                  << saves << (saves == 1 ? " save, " : " saves, ") << seconds << " s, "
+                  << static_cast<std::size_t>((succeeded + failed) / (seconds > 0 ? seconds : 1)) << " commands/s" << std::endl;
+        return failed == 0 ? 0 : 1;
+    }
+
+    /**
+     * @brief Runs the command named by argv[1] against a loaded TaskManager.
+     * @param manager The TaskManager instance to operate on.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (action at argv[1]).
+     * @return The command's exit code, or 1 for an unknown action.
+     * @note Shared by main() and the daemon, so both accept exactly the same commands.
+     */
+    int run(TaskManager& manager, int argc, char* argv[]) {
+        TASK_STATS_SCOPE("command");
+        std::string action = argv[1];
+        if (action == "add") return add(manager, argc, argv);
+        if (action == "update") return update(manager, argc, argv);
+        if (action == "delete") return deleteTask(manager, argc, argv);
+        if (action == "restore") return restore(manager, argc, argv);
+        if (action == "mark-in-progress") return changeStatus(manager, argc, argv, TaskStatus::IN_PROGRESS);
+        if (action == "mark-done") return changeStatus(manager, argc, argv, TaskStatus::DONE);
+        if (action == "list") return list(manager, argc, argv);
+        if (action == "search") return search(manager, argc, argv);
+        if (action == "stats") return stats(manager, argc, argv);
+        if (action == "status-stats") return statusStats(manager, argc, argv);
+        if (action == "compact") return compact(manager, argc, argv);
+        if (action == "batch") return batch(manager, argc, argv);
+
+        err() << "Unknown action: " << action << std::endl;
+        return 1;
+    }
+
+    /**
+     * @brief Runs a read-only command (list or status-stats) against a table.
+     * @param table The tasks to read.
+     * @param argc The number of command-line arguments.
+     * @param argv The array of command-line arguments (action at argv[1]).
+     * @return The command's exit code, or 1 for an action that is not read-only.
+     * @note Used by the daemon's workers, which run on immutable snapshots.
+     */
+    int run(const TaskTable& table, int argc, char* argv[]) {
+        TASK_STATS_SCOPE("command");
+        std::string action = argv[1];
+        if (action == "list") return list(table, argc, argv);
+        if (action == "status-stats") return statusStats(table, argc, argv);
+
+        err() << "Unknown read-only action: " << action << std::endl;
+        return 1;
+    }
 }
\ No newline at end of file
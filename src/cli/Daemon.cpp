@@ -0,0 +1,599 @@
+#include "cli/Daemon.h"
+#include "cli/Commands.h"
+#include "cli/DaemonProtocol.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <span>
+#include <sstream>
+#include <string_view>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#endif
+
+#if defined(_WIN32)
+
+int Daemon::serve(TaskManager& manager, const std::string& socketPath, int argc, char* argv[]) {
+    (void)manager;
+    (void)socketPath;
+    (void)argc;
+    (void)argv;
+    std::cerr << "serve is not supported on this platform" << std::endl;
+    return 1;
+}
+
+std::optional<int> Daemon::forward(const std::string& socketPath, int argc, char* argv[]) {
+    (void)socketPath;
+    (void)argc;
+    (void)argv;
+    return std::nullopt;
+}
+
+bool Daemon::serving(const std::string& socketPath) {
+    (void)socketPath;
+    return false;
+}
+
+#else
+
+namespace {
+
+    constexpr auto REFRESH_INTERVAL = std::chrono::milliseconds(100); ///< How often an idle daemon checks for outside saves.
+    constexpr int WRITE_TIMEOUT_MS = 5000; ///< How long a client may leave responses unread before it is dropped.
+
+    volatile std::sig_atomic_t stopRequested = 0;
+    int signalPipe = -1; ///< Write end of the pipe that wakes the poller from a signal handler.
+
+    void requestStop(int) {
+        stopRequested = 1;
+        char byte = 0;
+        if (::write(signalPipe, &byte, 1) < 0) {
+            // The pipe is full, so the poller is about to wake anyway
+        }
+    }
+
+    /**
+     * @brief Checks whether a command only reads tasks and can run on a snapshot.
+     */
+    bool isReadOnly(const std::vector<std::string>& arguments) {
+        return arguments[1] == "list" || arguments[1] == "status-stats";
+    }
+
+    /**
+     * @brief Checks whether a command would read a file or stdin of the daemon instead of the client's.
+     * @note Daemon::forward() sends batches with their commands inline (--lines).
+     */
+    bool readsLocalInput(const std::vector<std::string>& arguments) {
+        return arguments[1] == "batch" && std::find(arguments.begin(), arguments.end(), "--lines") == arguments.end();
+    }
+
+    /**
+     * @brief Reads the commands of a batch and rewrites its arguments to carry them inline.
+     * @param argc The number of command-line arguments of the batch.
+     * @param argv The command-line arguments (optional file or "-" for stdin, and --save-every <n>).
+     * @param arguments Receives the request: --save-every as given, then the commands in --lines chunks.
+     * @param lines Receives the commands; the chunks in arguments point into it.
+     * @return False if the batch file cannot be opened.
+     */
+    bool readBatch(int argc, char* argv[], std::vector<std::string_view>& arguments, std::string& lines) {
+        constexpr std::size_t CHUNK_SIZE = 1u << 20; ///< The daemon's limit on one argument.
+
+        arguments.assign(argv, argv + 2);
+        std::string source = "-";
+        for (int i = 2; i < argc; ++i) {
+            std::string_view argument = argv[i];
+            if (argument == "--save-every" && i + 1 < argc) {
+                arguments.insert(arguments.end(), {argv[i], argv[i + 1]});
+                ++i;
+            } else {
+                source = argument;
+            }
+        }
+
+        std::ifstream file;
+        if (source != "-") {
+            file.open(source, std::ios::binary);
+            if (!file) {
+                std::cerr << "Failed to open batch file: " << source << std::endl;
+                return false;
+            }
+        }
+        std::istream& in = source == "-" ? std::cin : file;
+        lines.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+
+        std::string_view rest = lines;
+        do {
+            arguments.insert(arguments.end(), {"--lines", rest.substr(0, CHUNK_SIZE)});
+            rest.remove_prefix(std::min(rest.size(), CHUNK_SIZE));
+        } while (!rest.empty());
+        return true;
+    }
+
+    /**
+     * @brief Writes all bytes to a non-blocking socket.
+     * @return False if the socket failed or the client stopped reading.
+     */
+    bool writeAll(int fd, std::string_view data) {
+        while (!data.empty()) {
+            ssize_t n = ::write(fd, data.data(), data.size());
+            if (n > 0) {
+                data.remove_prefix(static_cast<std::size_t>(n));
+                continue;
+            }
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                pollfd writable{fd, POLLOUT, 0};
+                if (::poll(&writable, 1, WRITE_TIMEOUT_MS) > 0) continue;
+            }
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Runs one command with its output captured, and appends the encoded response.
+     * @param arguments The command-line arguments of the request.
+     * @param responses The buffer of responses for the connection.
+     * @param command Runs the command for (argc, argv).
+     */
+    template <typename Command>
+    void runCommand(std::vector<std::string>& arguments, std::string& responses, Command&& command) {
+        std::vector<char*> argv;
+        for (std::string& argument : arguments) argv.push_back(argument.data());
+        argv.push_back(nullptr);
+
+        std::ostringstream out, err;
+        std::int32_t code = 1;
+        {
+            CLI::OutputScope scope(out, err);
+            try {
+                code = command(static_cast<int>(arguments.size()), argv.data());
+            } catch (const std::exception& e) {
+                err << "Error: " << e.what() << std::endl;
+            }
+        }
+        Daemon::appendResponse(responses, code, out.view(), err.view());
+    }
+
+    /**
+     * @struct FlushResult
+     * @brief The outcome of a deferred save.
+     */
+    struct FlushResult {
+        bool saved = false;  ///< Whether nothing is left to save.
+        bool merged = false; ///< Whether another process's save was merged in, possibly renumbering added tasks.
+    };
+
+    /**
+     * @brief Saves pending changes, reporting instead of propagating failures.
+     */
+    FlushResult flush(TaskManager& manager) {
+        try {
+            bool merged = manager.flushPendingSave();
+            return {true, merged};
+        } catch (const std::exception& e) {
+            std::cerr << "Error saving tasks: " << e.what() << std::endl;
+            return {};
+        }
+    }
+
+    /**
+     * @struct Connection
+     * @brief A client connection and the request bytes received from it so far.
+     */
+    struct Connection {
+        int fd;             ///< Non-blocking client socket.
+        std::string input;  ///< Received bytes not yet decoded into requests.
+        bool closed = false; ///< Whether the client hung up or broke the protocol.
+
+        explicit Connection(int fd) : fd(fd) {}
+        ~Connection() { ::close(fd); }
+    };
+
+    /**
+     * @struct WriteJob
+     * @brief Consecutive mutating requests from one connection, run together by the writer.
+     */
+    struct WriteJob {
+        std::span<std::vector<std::string>> requests; ///< The requests, in order.
+        std::string& responses;                       ///< Buffer the encoded responses are appended to.
+        std::promise<void> done;                      ///< Fulfilled once a snapshot with the changes is published.
+    };
+
+    /**
+     * @class Server
+     * @brief Serves a TaskManager with a pool of reader threads and a single writer thread.
+     *
+     * The poller thread accepts connections and hands every connection with pending input to
+     * a worker. Workers answer read-only commands (list) from an immutable snapshot of the
+     * tasks, which they pin with a shared_ptr, so reads never wait for writes or for each other.
+     * Every other command is queued to the writer thread, the only thread touching the
+     * TaskManager. The writer applies all queued commands, publishes a fresh snapshot once per
+     * batch and saves in the background. A snapshot is freed when its last reader drops it.
+     * Each connection is served by one worker at a time, and its responses keep request order.
+     */
+    class Server {
+    private:
+        TaskManager& manager;
+        std::chrono::milliseconds flushInterval;
+        int listener;
+        int wakeRead;
+        int wakeWrite;
+        std::atomic<std::shared_ptr<const TaskTable>> snapshot; ///< What read-only commands run on.
+
+        std::mutex connectionMutex;
+        std::condition_variable connectionReady;
+        std::deque<std::unique_ptr<Connection>> readyConnections;    ///< Connections with input for a worker.
+        std::vector<std::unique_ptr<Connection>> returnedConnections; ///< Served connections to poll again.
+        bool stopping = false;
+
+        std::mutex writeMutex;
+        std::condition_variable writeReady;
+        std::vector<WriteJob*> writeQueue;
+        bool writerStopping = false;
+
+    public:
+        Server(TaskManager& manager, std::chrono::milliseconds flushInterval, int listener, int wakeRead, int wakeWrite) :
+            manager(manager), flushInterval(flushInterval), listener(listener), wakeRead(wakeRead), wakeWrite(wakeWrite) {}
+
+        /**
+         * @brief Serves until a stop signal arrives, then saves pending changes.
+         * @param workerCount The number of worker threads.
+         * @return True if the final save succeeded.
+         */
+        bool run(unsigned workerCount) {
+            publish();
+            std::thread writer([this] { writerLoop(); });
+            std::vector<std::thread> workers;
+            for (unsigned i = 0; i < workerCount; ++i) workers.emplace_back([this] { workerLoop(); });
+
+            pollLoop();
+
+            {
+                std::lock_guard lock(connectionMutex);
+                stopping = true;
+            }
+            connectionReady.notify_all();
+            for (std::thread& worker : workers) worker.join();
+            {
+                std::lock_guard lock(writeMutex);
+                writerStopping = true;
+            }
+            writeReady.notify_one();
+            writer.join();
+            return flush(manager).saved;
+        }
+
+    private:
+
+        void wake() {
+            char byte = 0;
+            if (::write(wakeWrite, &byte, 1) < 0) {
+                // The pipe is full, so the poller is about to wake anyway
+            }
+        }
+
+        /**
+         * @brief Waits for new connections, readable connections and served connections.
+         */
+        void pollLoop() {
+            std::vector<std::unique_ptr<Connection>> idle;
+            std::vector<pollfd> fds;
+            while (!stopRequested) {
+                fds.assign({{wakeRead, POLLIN, 0}, {listener, POLLIN, 0}});
+                for (const auto& connection : idle) fds.push_back({connection->fd, POLLIN, 0});
+                if (::poll(fds.data(), fds.size(), -1) < 0) {
+                    if (errno == EINTR) continue;
+                    std::cerr << "poll failed: " << std::strerror(errno) << std::endl;
+                    return;
+                }
+
+                std::size_t handedOff = 0;
+                {
+                    std::lock_guard lock(connectionMutex);
+                    for (std::size_t i = idle.size(); i-- > 0;) {
+                        if (fds[i + 2].revents == 0) continue;
+                        readyConnections.push_back(std::move(idle[i]));
+                        idle.erase(idle.begin() + static_cast<std::ptrdiff_t>(i));
+                        ++handedOff;
+                    }
+                    for (auto& connection : returnedConnections) idle.push_back(std::move(connection));
+                    returnedConnections.clear();
+                }
+                for (; handedOff > 0; --handedOff) connectionReady.notify_one();
+
+                if (fds[0].revents != 0) {
+                    char buffer[256];
+                    while (::read(wakeRead, buffer, sizeof(buffer)) > 0) {}
+                }
+                if (fds[1].revents != 0) {
+                    int client = ::accept(listener, nullptr, nullptr);
+                    if (client >= 0) {
+                        ::fcntl(client, F_SETFL, ::fcntl(client, F_GETFL) | O_NONBLOCK);
+                        idle.push_back(std::make_unique<Connection>(client));
+                    }
+                }
+            }
+        }
+
+        void workerLoop() {
+            while (true) {
+                std::unique_ptr<Connection> connection;
+                {
+                    std::unique_lock lock(connectionMutex);
+                    connectionReady.wait(lock, [this] { return !readyConnections.empty() || stopping; });
+                    if (readyConnections.empty()) return;
+                    connection = std::move(readyConnections.front());
+                    readyConnections.pop_front();
+                }
+
+                serveConnection(*connection);
+                if (connection->closed) continue;
+                {
+                    std::lock_guard lock(connectionMutex);
+                    returnedConnections.push_back(std::move(connection));
+                }
+                wake();
+            }
+        }
+
+        /**
+         * @brief Answers every complete request a connection has sent, in order.
+         * @note All responses go out in one write, which is what makes pipelining cheap.
+         */
+        void serveConnection(Connection& connection) {
+            char chunk[64 * 1024];
+            while (true) {
+                ssize_t n = ::read(connection.fd, chunk, sizeof(chunk));
+                if (n > 0) {
+                    connection.input.append(chunk, static_cast<std::size_t>(n));
+                    continue;
+                }
+                if (n < 0 && errno == EINTR) continue;
+                if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) connection.closed = true;
+                break;
+            }
+
+            std::vector<std::vector<std::string>> requests;
+            std::size_t pos = 0;
+            try {
+                std::vector<std::string> arguments;
+                while (std::size_t used = Daemon::decodeRequest(std::string_view(connection.input).substr(pos), arguments)) {
+                    requests.push_back(std::move(arguments));
+                    pos += used;
+                }
+            } catch (const std::exception&) {
+                connection.closed = true;
+            }
+            connection.input.erase(0, pos);
+
+            std::string responses;
+            for (std::size_t i = 0; i < requests.size();) {
+                if (isReadOnly(requests[i])) {
+                    std::shared_ptr<const TaskTable> table = snapshot.load();
+                    runCommand(requests[i], responses, [&](int argc, char* argv[]) { return CLI::run(*table, argc, argv); });
+                    ++i;
+                    continue;
+                }
+
+                std::size_t end = i;
+                while (end < requests.size() && !isReadOnly(requests[end])) ++end;
+                WriteJob job{std::span(requests).subspan(i, end - i), responses, {}};
+                std::future<void> done = job.done.get_future();
+                {
+                    std::lock_guard lock(writeMutex);
+                    writeQueue.push_back(&job);
+                }
+                writeReady.notify_one();
+                done.wait();
+                i = end;
+            }
+
+            if (!responses.empty() && !writeAll(connection.fd, responses)) connection.closed = true;
+        }
+
+        /**
+         * @brief Applies queued commands, publishes snapshots and saves after the flush interval.
+         */
+        void writerLoop() {
+            using Clock = std::chrono::steady_clock;
+            Clock::time_point flushDeadline = Clock::time_point::max(); // max while nothing is pending
+            Clock::time_point nextRefresh = Clock::now() + REFRESH_INTERVAL;
+            while (true) {
+                std::vector<WriteJob*> jobs;
+                {
+                    std::unique_lock lock(writeMutex);
+                    writeReady.wait_until(lock, std::min(flushDeadline, nextRefresh), [this] { return !writeQueue.empty() || writerStopping; });
+                    jobs.swap(writeQueue);
+                    if (jobs.empty() && writerStopping) return;
+                }
+
+                bool changed = !jobs.empty();
+                if (changed || Clock::now() >= nextRefresh) {
+                    // Pick up saves made by processes that bypassed the daemon
+                    try {
+                        changed = manager.refresh() || changed;
+                    } catch (const std::exception& e) {
+                        std::cerr << "Error reloading tasks: " << e.what() << std::endl;
+                    }
+                    nextRefresh = Clock::now() + REFRESH_INTERVAL;
+                }
+                for (WriteJob* job : jobs) {
+                    for (std::vector<std::string>& arguments : job->requests) {
+                        if (readsLocalInput(arguments)) {
+                            Daemon::appendResponse(job->responses, 1, "", "batch commands must be sent with --lines\n");
+                            continue;
+                        }
+                        runCommand(arguments, job->responses, [this](int argc, char* argv[]) { return CLI::run(manager, argc, argv); });
+                    }
+                }
+                if (changed) publish();
+                for (WriteJob* job : jobs) job->done.set_value();
+
+                if (!manager.hasPendingSave()) {
+                    flushDeadline = Clock::time_point::max();
+                } else if (flushDeadline == Clock::time_point::max()) {
+                    flushDeadline = Clock::now() + flushInterval;
+                } else if (Clock::now() >= flushDeadline) {
+                    // Retry a failed save one interval later instead of spinning
+                    FlushResult result = flush(manager);
+                    flushDeadline = result.saved ? Clock::time_point::max() : Clock::now() + flushInterval;
+                    // The save rebased onto another process's, so readers must see the merged tasks
+                    if (result.merged) publish();
+                }
+            }
+        }
+
+        /**
+         * @brief Replaces the snapshot read-only commands run on with a copy of the current tasks.
+         */
+        void publish() {
+            try {
+                snapshot.store(std::make_shared<const TaskTable>(manager.getTable()));
+            } catch (const std::exception& e) {
+                std::cerr << "Error publishing tasks: " << e.what() << std::endl;
+            }
+        }
+    };
+}
+
+/**
+ * @brief Serves commands for a loaded TaskManager until interrupted.
+ * @param manager The TaskManager to keep resident; it must already be loaded.
+ * @param socketPath The socket to listen on.
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments (optionally --flush-interval <ms> and
+ *             --workers <n> from argv[2]).
+ * @return 0 after a clean shutdown, 1 if the socket cannot be set up or the final save fails.
+ * @note Saves are deferred: the first change after a save starts the flush interval (10 ms by
+ *       default), and everything changed until it expires is written together in one save.
+ *       add and batch save before answering, since a save may still renumber the tasks they added.
+ * @note Defaults to one worker per hardware thread.
+ * @note Pending changes are saved on SIGINT and SIGTERM before the socket is removed.
+ */
+int Daemon::serve(TaskManager& manager, const std::string& socketPath, int argc, char* argv[]) {
+    std::chrono::milliseconds flushInterval{10};
+    unsigned workers = std::max(1u, std::thread::hardware_concurrency());
+    for (int i = 2; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--flush-interval" && i + 1 < argc) {
+            flushInterval = std::chrono::milliseconds(std::stoul(argv[++i]));
+        } else if (argument == "--workers" && i + 1 < argc) {
+            workers = std::max(1u, static_cast<unsigned>(std::stoul(argv[++i])));
+        } else {
+            std::cerr << "Usage: ./task-cli serve [--flush-interval <ms>] [--workers <n>]" << std::endl;
+            return 1;
+        }
+    }
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Socket path is too long: " << socketPath << std::endl;
+        return 1;
+    }
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+    if (Client(socketPath).connected()) {
+        std::cerr << "A daemon is already serving " << socketPath << std::endl;
+        return 1;
+    }
+    ::unlink(socketPath.c_str()); // left behind by a daemon that did not shut down cleanly
+
+    int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0 || ::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listener, SOMAXCONN) != 0) {
+        std::cerr << "Failed to listen on " << socketPath << ": " << std::strerror(errno) << std::endl;
+        if (listener >= 0) ::close(listener);
+        return 1;
+    }
+    int wake[2];
+    if (::pipe(wake) != 0) {
+        std::cerr << "Failed to create wake pipe: " << std::strerror(errno) << std::endl;
+        ::close(listener);
+        ::unlink(socketPath.c_str());
+        return 1;
+    }
+    for (int fd : wake) ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    // Signals may land on any thread, so the handler wakes the poller through the pipe
+    signalPipe = wake[1];
+    struct sigaction action{};
+    action.sa_handler = requestStop;
+    sigemptyset(&action.sa_mask);
+    ::sigaction(SIGINT, &action, nullptr);
+    ::sigaction(SIGTERM, &action, nullptr);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    manager.setDeferredSaving(true);
+    std::cout << "Serving " << socketPath << " (" << workers << " workers, flush interval "
+              << flushInterval.count() << " ms)" << std::endl;
+
+    bool saved = Server(manager, flushInterval, listener, wake[0], wake[1]).run(workers);
+
+    ::close(listener);
+    ::unlink(socketPath.c_str());
+    return saved ? 0 : 1;
+}
+
+/**
+ * @brief Runs a command through the daemon listening on the given socket, if there is one.
+ * @param socketPath The socket of the daemon.
+ * @param argc The number of command-line arguments.
+ * @param argv The array of command-line arguments to forward.
+ * @return The command's exit code after printing its output, or std::nullopt if no daemon is
+ *         listening and the command should run locally.
+ * @note A socket that nobody listens on (left behind by a crashed daemon) counts as no daemon.
+ * @note A batch is read here and sent as --lines arguments of at most 1 MiB each, since the
+ *       daemon cannot read the caller's files or stdin.
+ */
+std::optional<int> Daemon::forward(const std::string& socketPath, int argc, char* argv[]) {
+    if (::access(socketPath.c_str(), F_OK) != 0) return std::nullopt;
+    Client client(socketPath);
+    if (!client.connected()) return std::nullopt;
+
+    std::vector<std::string_view> arguments(argv, argv + argc);
+    std::string lines;
+    if (argc >= 2 && std::string_view(argv[1]) == "batch") {
+        if (!readBatch(argc, argv, arguments, lines)) return 1;
+    }
+    client.send(arguments);
+    Response response;
+    if (!client.flush() || !client.receive(response)) {
+        // The command may or may not have been applied, so it must not be retried locally
+        std::cerr << "Lost connection to the task daemon at " << socketPath << std::endl;
+        return 1;
+    }
+
+    std::cout << response.out << std::flush;
+    std::cerr << response.err << std::flush;
+    return response.code;
+}
+
+/**
+ * @brief Checks whether a daemon is listening on the given socket.
+ * @param socketPath The socket of the daemon.
+ * @return False if nothing listens there, including a socket left behind by a crashed daemon.
+ */
+bool Daemon::serving(const std::string& socketPath) {
+    return ::access(socketPath.c_str(), F_OK) == 0 && Client(socketPath).connected();
+}
+
+#endif
@@ -0,0 +1,178 @@
+#include "cli/DaemonProtocol.h"
+#include <cstring>
+#include <stdexcept>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+    constexpr std::uint32_t MAX_ARGUMENTS = 4096;          ///< Largest argument count accepted in a request.
+    constexpr std::uint32_t MAX_ARGUMENT_SIZE = 1u << 20;  ///< Largest argument accepted in a request.
+
+    template <typename T>
+    void appendInteger(std::string& out, T value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void appendString(std::string& out, std::string_view value) {
+        appendInteger(out, static_cast<std::uint32_t>(value.size()));
+        out.append(value);
+    }
+
+    /**
+     * @brief Reads a fixed-size integer at a position, advancing past it.
+     * @return False if the input ends first.
+     */
+    template <typename T>
+    bool readInteger(std::string_view in, std::size_t& pos, T& value) {
+        if (in.size() - pos < sizeof(value)) return false;
+        std::memcpy(&value, in.data() + pos, sizeof(value));
+        pos += sizeof(value);
+        return true;
+    }
+
+    /**
+     * @brief Reads a length-prefixed string at a position, advancing past it.
+     * @return False if the input ends first.
+     */
+    bool readString(std::string_view in, std::size_t& pos, std::string& value, std::uint32_t maxSize) {
+        std::uint32_t size = 0;
+        if (!readInteger(in, pos, size)) return false;
+        if (size > maxSize) throw std::runtime_error("Request argument too large");
+        if (in.size() - pos < size) return false;
+        value.assign(in.substr(pos, size));
+        pos += size;
+        return true;
+    }
+}
+
+std::string Daemon::socketPath(const std::string& storeName) { return storeName + ".sock"; }
+
+void Daemon::appendRequest(std::string& out, std::span<const std::string_view> arguments) {
+    appendInteger(out, static_cast<std::uint32_t>(arguments.size()));
+    for (std::string_view argument : arguments) appendString(out, argument);
+}
+
+/**
+ * @brief Decodes the request at the start of a buffer.
+ * @param in The received bytes.
+ * @param arguments Receives the command-line arguments.
+ * @return The number of bytes consumed, or 0 if the request is not complete yet.
+ * @throws std::runtime_error If the request exceeds the argument count or size limits.
+ * @note Limits are checked before anything is allocated, so a broken client cannot make the
+ *       daemon reserve gigabytes.
+ */
+std::size_t Daemon::decodeRequest(std::string_view in, std::vector<std::string>& arguments) {
+    std::size_t pos = 0;
+    std::uint32_t count = 0;
+    if (!readInteger(in, pos, count)) return 0;
+    if (count < 2 || count > MAX_ARGUMENTS) throw std::runtime_error("Malformed request");
+
+    arguments.resize(count);
+    for (std::string& argument : arguments) {
+        if (!readString(in, pos, argument, MAX_ARGUMENT_SIZE)) return 0;
+    }
+    return pos;
+}
+
+void Daemon::appendResponse(std::string& out, std::int32_t code, std::string_view stdoutText, std::string_view stderrText) {
+    appendInteger(out, code);
+    appendString(out, stdoutText);
+    appendString(out, stderrText);
+}
+
+std::size_t Daemon::decodeResponse(std::string_view in, Response& response) {
+    std::size_t pos = 0;
+    if (!readInteger(in, pos, response.code) || !readString(in, pos, response.out, UINT32_MAX) ||
+        !readString(in, pos, response.err, UINT32_MAX)) {
+        return 0;
+    }
+    return pos;
+}
+
+#if defined(_WIN32)
+
+Daemon::Client::Client(const std::string& socketPath) { (void)socketPath; }
+
+Daemon::Client::~Client() = default;
+
+bool Daemon::Client::connected() const { return false; }
+
+void Daemon::Client::send(std::span<const std::string_view> arguments) { appendRequest(output, arguments); }
+
+bool Daemon::Client::flush() { return false; }
+
+bool Daemon::Client::receive(Response& response) {
+    (void)response;
+    return false;
+}
+
+#else
+
+/**
+ * @brief Connects to the daemon listening on a socket.
+ * @param socketPath The socket of the daemon.
+ * @note Check connected() afterwards; nothing listening is not an error.
+ * @note Ignores SIGPIPE, so a daemon going away surfaces as a failed flush() instead of killing the client.
+ */
+Daemon::Client::Client(const std::string& socketPath) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) return;
+    std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+    fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return;
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        fd = -1;
+        return;
+    }
+    std::signal(SIGPIPE, SIG_IGN);
+}
+
+Daemon::Client::~Client() {
+    if (fd >= 0) ::close(fd);
+}
+
+bool Daemon::Client::connected() const { return fd >= 0; }
+
+void Daemon::Client::send(std::span<const std::string_view> arguments) { appendRequest(output, arguments); }
+
+bool Daemon::Client::flush() {
+    std::string_view pending = output;
+    while (!pending.empty()) {
+        ssize_t n = ::write(fd, pending.data(), pending.size());
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        pending.remove_prefix(static_cast<std::size_t>(n));
+    }
+    output.clear();
+    return true;
+}
+
+bool Daemon::Client::receive(Response& response) {
+    while (true) {
+        if (std::size_t used = decodeResponse(std::string_view(input).substr(inputPos), response)) {
+            inputPos += used;
+            return true;
+        }
+
+        // Drop consumed bytes before reading more, so the buffer only holds unanswered responses
+        input.erase(0, inputPos);
+        inputPos = 0;
+        char chunk[64 * 1024];
+        ssize_t n = ::read(fd, chunk, sizeof(chunk));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        input.append(chunk, static_cast<std::size_t>(n));
+    }
+}
+
+#endif
@@ -0,0 +1,91 @@
+#include "cli/TaskPrinter.h"
+#include "core/Task.h"
+
+namespace CLI {
+
+    /**
+     * @brief Parses the value of a --format option.
+     * @param name "human", "jsonl" or "tsv".
+     * @return The format, or std::nullopt for any other name.
+     */
+    std::optional<OutputFormat> parseOutputFormat(std::string_view name) {
+        if (name == "human") return OutputFormat::HUMAN;
+        if (name == "jsonl") return OutputFormat::JSONL;
+        if (name == "tsv") return OutputFormat::TSV;
+        return std::nullopt;
+    }
+
+    TaskPrinter::TaskPrinter(std::ostream& out, OutputFormat format) : out(out), format(format) {
+        if (format == OutputFormat::TSV) buffer.appendRaw("id\tstatus\tdescription\tcreatedAt\tupdatedAt\n");
+    }
+
+    TaskPrinter::~TaskPrinter() { flush(); }
+
+    /**
+     * @brief Prints one task.
+     * @param task The task to print.
+     * @note OutputFormat::HUMAN matches TaskView::toString() byte for byte. In OutputFormat::TSV,
+     *       backslashes, tabs, carriage returns and newlines in descriptions are escaped as
+     *       \\\\, \\t, \\r and \\n so every task stays on one line.
+     */
+    void TaskPrinter::print(const TaskView& task) {
+        switch (format) {
+            case OutputFormat::HUMAN: {
+                char time[Task::TIME_BUFFER_SIZE];
+                buffer.appendRaw("Task: ( id: ");
+                buffer.appendInteger(task.getId());
+                buffer.appendRaw(", status: ");
+                buffer.appendRaw(TaskUtils::statusToLabel(task.getStatus()));
+                buffer.appendRaw(", description: ");
+                buffer.appendRaw(task.getDescription());
+                buffer.appendRaw(", createdAt: ");
+                buffer.appendRaw(std::string_view(time, Task::formatTime(task.getCreatedAt(), time)));
+                buffer.appendRaw(", updatedAt: ");
+                buffer.appendRaw(std::string_view(time, Task::formatTime(task.getUpdatedAt(), time)));
+                buffer.appendRaw(" )\n");
+                break;
+            }
+            case OutputFormat::JSONL:
+                buffer.appendTask(task);
+                buffer.appendRaw("\n");
+                break;
+            case OutputFormat::TSV: {
+                buffer.appendInteger(task.getId());
+                buffer.appendRaw("\t");
+                buffer.appendRaw(TaskUtils::statusToKey(task.getStatus()));
+                buffer.appendRaw("\t");
+                std::string_view description = task.getDescription();
+                std::size_t runStart = 0;
+                for (std::size_t i = 0; i < description.size(); ++i) {
+                    std::string_view escape;
+                    switch (description[i]) {
+                        case '\\': escape = "\\\\"; break;
+                        case '\t': escape = "\\t"; break;
+                        case '\r': escape = "\\r"; break;
+                        case '\n': escape = "\\n"; break;
+                        default: continue;
+                    }
+                    buffer.appendRaw(description.substr(runStart, i - runStart));
+                    buffer.appendRaw(escape);
+                    runStart = i + 1;
+                }
+                buffer.appendRaw(description.substr(runStart));
+                buffer.appendRaw("\t");
+                buffer.appendInteger(static_cast<long long>(task.getCreatedAt()));
+                buffer.appendRaw("\t");
+                buffer.appendInteger(static_cast<long long>(task.getUpdatedAt()));
+                buffer.appendRaw("\n");
+                break;
+            }
+        }
+        ++printed;
+        if (buffer.size() >= TaskSerializer::FLUSH_THRESHOLD) buffer.flush(out);
+    }
+
+    void TaskPrinter::flush() {
+        if (!buffer.empty()) buffer.flush(out);
+        out.flush();
+    }
+
+    std::size_t TaskPrinter::count() const { return printed; }
+}
@@ -0,0 +1,287 @@
+#include "core/AtomicFile.h"
+#include "core/Stats.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#include <process.h>
+#include <sys/stat.h>
+#else
+#include <climits>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#if defined(_WIN32)
+    int processId() { return ::_getpid(); }
+
+    int openFile(const std::string& path, int flags) {
+      return ::_open(path.c_str(), flags | _O_BINARY, _S_IREAD | _S_IWRITE);
+    }
+
+    bool writeAll(int fd, std::string_view bytes) {
+      while(!bytes.empty()) {
+        int written = ::_write(fd, bytes.data(), static_cast<unsigned>(bytes.size()));
+        if(written < 0) return false;
+        bytes.remove_prefix(static_cast<std::size_t>(written));
+      }
+      return true;
+    }
+
+    bool writeAll(int fd, const std::vector<std::string_view>& parts) {
+      for(std::string_view part : parts) {
+        if(!writeAll(fd, part)) return false;
+      }
+      return true;
+    }
+
+    bool flushFile(int fd, Durability durability) {
+      return durability == Durability::NONE || ::_commit(fd) == 0;
+    }
+
+    void closeFile(int fd) { ::_close(fd); }
+
+    /// Windows cannot open directories for flushing; MoveFileEx-based renames are journaled by NTFS.
+    bool flushDirectory(const std::filesystem::path&) { return true; }
+#else
+    int processId() { return static_cast<int>(::getpid()); }
+
+    int openFile(const std::string& path, int flags) {
+      return ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+    }
+
+    bool writeAll(int fd, std::string_view bytes) {
+      while(!bytes.empty()) {
+        ssize_t written = ::write(fd, bytes.data(), bytes.size());
+        if(written < 0) {
+          if(errno == EINTR) continue;
+          return false;
+        }
+        bytes.remove_prefix(static_cast<std::size_t>(written));
+      }
+      return true;
+    }
+
+    /**
+     * @brief Writes several buffers in order with as few writev calls as possible.
+     * @note Each call takes up to IOV_MAX buffers; a short write resumes inside the buffer it stopped in.
+     */
+    bool writeAll(int fd, const std::vector<std::string_view>& parts) {
+      std::vector<iovec> vectors;
+      vectors.reserve(parts.size());
+      for(std::string_view part : parts) {
+        if(!part.empty()) vectors.push_back({const_cast<char*>(part.data()), part.size()});
+      }
+
+      std::size_t next = 0;
+      while(next < vectors.size()) {
+        int count = static_cast<int>(std::min<std::size_t>(vectors.size() - next, IOV_MAX));
+        ssize_t written = ::writev(fd, vectors.data() + next, count);
+        if(written < 0) {
+          if(errno == EINTR) continue;
+          return false;
+        }
+        auto remaining = static_cast<std::size_t>(written);
+        while(next < vectors.size() && remaining >= vectors[next].iov_len) {
+          remaining -= vectors[next].iov_len;
+          ++next;
+        }
+        if(remaining > 0) {
+          vectors[next].iov_base = static_cast<char*>(vectors[next].iov_base) + remaining;
+          vectors[next].iov_len -= remaining;
+        }
+      }
+      return true;
+    }
+
+    /**
+     * @brief Flushes a file descriptor according to the durability.
+     * @note Durability::FSYNC_DATA skips metadata that is not needed to read the data back
+     *       (fdatasync); on macOS, Durability::FSYNC_FULL also flushes the drive cache.
+     */
+    bool flushFile(int fd, Durability durability) {
+      switch(durability) {
+        case Durability::NONE:
+          return true;
+        case Durability::FSYNC_DATA:
+#if defined(__APPLE__)
+          return ::fsync(fd) == 0;
+#else
+          return ::fdatasync(fd) == 0;
+#endif
+        case Durability::FSYNC_FULL:
+#if defined(__APPLE__)
+          return ::fcntl(fd, F_FULLFSYNC) == 0 || ::fsync(fd) == 0;
+#else
+          return ::fsync(fd) == 0;
+#endif
+      }
+      return true;
+    }
+
+    void closeFile(int fd) { ::close(fd); }
+
+    bool flushDirectory(const std::filesystem::path& directory) {
+      int fd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_CLOEXEC);
+      if(fd < 0) return false;
+      bool flushed = ::fsync(fd) == 0;
+      ::close(fd);
+      return flushed;
+    }
+#endif
+
+}
+
+/**
+ * @brief Creates the temporary file next to the target.
+ * @param path The file to replace.
+ * @param durability How the new contents are flushed on commit.
+ * @throws std::runtime_error If the temporary file cannot be created.
+ * @note The temporary file lives in the target's directory so the rename never crosses file systems.
+ *       Its name carries the process id, so concurrent writers never share a temporary file.
+ */
+AtomicFile::AtomicFile(std::string path, Durability durability) :
+           path(std::move(path)), tempPath(this->path + ".tmp." + std::to_string(processId())), durability(durability) {
+#if defined(_WIN32)
+  fd = openFile(tempPath, _O_WRONLY | _O_CREAT | _O_TRUNC);
+#else
+  fd = openFile(tempPath, O_WRONLY | O_CREAT | O_TRUNC);
+#endif
+  if(fd < 0){
+    throw std::runtime_error("Failed to open store file: " + tempPath);
+  }
+}
+
+/**
+ * @brief Discards the temporary file unless commit() succeeded.
+ */
+AtomicFile::~AtomicFile() {
+  if(fd < 0) return;
+  closeFile(fd);
+  std::remove(tempPath.c_str());
+}
+
+void AtomicFile::write(std::string_view bytes) {
+  if(!writeAll(fd, bytes)) {
+    throw std::runtime_error("Failed to write store file: " + tempPath);
+  }
+  TASK_STATS_ADD("bytes written", bytes.size());
+}
+
+/**
+ * @brief Appends several buffers to the temporary file, in order.
+ * @param parts The buffers to write.
+ * @throws std::runtime_error If the write fails.
+ * @note Uses writev on POSIX systems, so the buffers are written without being joined first.
+ */
+void AtomicFile::write(const std::vector<std::string_view>& parts) {
+  if(!writeAll(fd, parts)) {
+    throw std::runtime_error("Failed to write store file: " + tempPath);
+  }
+  for(std::string_view part : parts) TASK_STATS_ADD("bytes written", part.size());
+}
+
+/**
+ * @brief Flushes the temporary file according to the durability and renames it over the target.
+ * @throws std::runtime_error If flushing or renaming fails.
+ * @note With Durability::FSYNC_FULL the directory is flushed after the rename, which makes the
+ *       new directory entry itself durable.
+ */
+void AtomicFile::commit() {
+  TASK_STATS_SCOPE("flush");
+  if(!flushFile(fd, durability)) {
+    throw std::runtime_error("Failed to flush store file: " + tempPath);
+  }
+  closeFile(std::exchange(fd, -1));
+
+  std::error_code ec;
+  std::filesystem::rename(tempPath, path, ec);
+  if(ec) {
+    std::remove(tempPath.c_str());
+    throw std::runtime_error("Failed to replace store file: " + path + " (" + ec.message() + ")");
+  }
+
+  if(durability == Durability::FSYNC_FULL && !flushDirectory(std::filesystem::path(path).parent_path())) {
+    throw std::runtime_error("Failed to flush directory of store file: " + path);
+  }
+}
+
+/**
+ * @brief Appends bytes to a file, flushing them according to the durability.
+ * @param path The file to append to; created if missing.
+ * @param bytes The bytes to append, written with a single write.
+ * @param durability How the appended bytes are flushed.
+ * @throws std::runtime_error If the file cannot be opened or written.
+ * @note With Durability::FSYNC_FULL a newly created file's directory entry is flushed as well.
+ */
+void AtomicFile::append(const std::string& path, std::string_view bytes, Durability durability) {
+  bool created = durability == Durability::FSYNC_FULL && !std::filesystem::exists(path);
+#if defined(_WIN32)
+  int fd = openFile(path, _O_WRONLY | _O_CREAT | _O_APPEND);
+#else
+  int fd = openFile(path, O_WRONLY | O_CREAT | O_APPEND);
+#endif
+  if(fd < 0){
+    throw std::runtime_error("Failed to open file for appending: " + path);
+  }
+  bool written = writeAll(fd, bytes) && flushFile(fd, durability);
+  closeFile(fd);
+  TASK_STATS_ADD("bytes written", bytes.size());
+  if(!written) {
+    throw std::runtime_error("Failed to append to file: " + path);
+  }
+  if(created && !flushDirectory(std::filesystem::path(path).parent_path())) {
+    throw std::runtime_error("Failed to flush directory of file: " + path);
+  }
+}
+
+/**
+ * @brief Flushes the current contents of an existing file according to the durability.
+ * @param path The file to flush.
+ * @param durability How the contents are flushed; Durability::NONE does nothing.
+ * @throws std::runtime_error If the file cannot be opened or flushed.
+ * @note Used after patching a file in place.
+ */
+void AtomicFile::sync(const std::string& path, Durability durability) {
+  if(durability == Durability::NONE) return;
+#if defined(_WIN32)
+  int fd = openFile(path, _O_RDWR);
+#else
+  int fd = openFile(path, O_RDWR);
+#endif
+  if(fd < 0){
+    throw std::runtime_error("Failed to open file for flushing: " + path);
+  }
+  bool flushed = flushFile(fd, durability);
+  closeFile(fd);
+  if(!flushed) {
+    throw std::runtime_error("Failed to flush file: " + path);
+  }
+}
+
+/**
+ * @brief Removes a file, if it exists, flushing its directory according to the durability.
+ * @param path The file to remove.
+ * @param durability With Durability::FSYNC_FULL the removal itself is made durable.
+ * @throws std::runtime_error If the file cannot be removed or the directory cannot be flushed.
+ */
+void AtomicFile::remove(const std::string& path, Durability durability) {
+  std::error_code ec;
+  if(!std::filesystem::remove(path, ec)) {
+    if(ec) throw std::runtime_error("Failed to remove file: " + path + " (" + ec.message() + ")");
+    return;
+  }
+  if(durability == Durability::FSYNC_FULL && !flushDirectory(std::filesystem::path(path).parent_path())) {
+    throw std::runtime_error("Failed to flush directory of file: " + path);
+  }
+}
@@ -0,0 +1,208 @@
+#include "core/BinaryStore.h"
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+    /**
+     * @brief Magic bytes identifying a binary store file.
+     */
+    constexpr char storeMagic[8] = {'T', 'T', 'S', 'T', 'O', 'R', 'E', '1'};
+
+    /**
+     * @brief Current binary store format version.
+     */
+    constexpr std::uint32_t storeVersion = 1;
+
+    /**
+     * @brief On-disk header at the start of a binary store.
+     */
+    struct StoreHeader {
+        char magic[8];
+        std::uint32_t version;
+        std::uint32_t count;
+        std::uint64_t heapOffset;
+        std::uint64_t heapSize;
+    };
+
+    /**
+     * @brief On-disk fixed-width record describing one task.
+     */
+    struct StoreRecord {
+        std::int32_t id;
+        std::uint8_t status;
+        std::uint8_t reserved[3];
+        std::int64_t createdAt;
+        std::int64_t updatedAt;
+        std::uint64_t descriptionOffset;
+        std::uint32_t descriptionLength;
+        std::uint32_t reserved2;
+    };
+
+    static_assert(sizeof(StoreHeader) == 32, "StoreHeader must match the on-disk layout");
+    static_assert(sizeof(StoreRecord) == 40, "StoreRecord must match the on-disk layout");
+
+    /**
+     * @brief Reads a record from the mapped table without aliasing the mapping.
+     */
+    StoreRecord readRecord(const char* base, std::size_t index) {
+        StoreRecord record;
+        std::memcpy(&record, base + sizeof(StoreHeader) + index * sizeof(StoreRecord), sizeof(StoreRecord));
+        return record;
+    }
+
+}
+
+/**
+ * @brief Checks whether a file is a binary store.
+ * @param path The file to inspect.
+ * @return True if the file exists and starts with the binary store magic.
+ */
+bool BinaryStore::isBinaryStore(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  char magic[sizeof(storeMagic)];
+  return file.read(magic, sizeof(magic)) && std::memcmp(magic, storeMagic, sizeof(magic)) == 0;
+}
+
+/**
+ * @brief Writes tasks to a new binary store file.
+ * @param path The destination file; replaced if it exists.
+ * @param tasks The tasks to write.
+ * @param durability How the new file is flushed to disk before it replaces the old one.
+ * @throws std::runtime_error If the file cannot be written.
+ * @note Writes to a temporary file and renames it over the destination (see AtomicFile), so an
+ *       open mapping of the old file stays valid.
+ */
+void BinaryStore::write(const std::string& path, const TaskMap& tasks, Durability durability) {
+  std::vector<StoreRecord> records;
+  records.reserve(tasks.size());
+  std::string heap;
+  for(const auto& [id, task] : tasks) {
+    TaskView view(task);
+    StoreRecord record {};
+    record.id = id;
+    record.status = static_cast<std::uint8_t>(view.getStatus());
+    record.createdAt = view.getCreatedAt();
+    record.updatedAt = view.getUpdatedAt();
+    record.descriptionOffset = heap.size();
+    record.descriptionLength = static_cast<std::uint32_t>(view.getDescription().size());
+    heap += view.getDescription();
+    records.push_back(record);
+  }
+
+  StoreHeader header {};
+  std::memcpy(header.magic, storeMagic, sizeof(storeMagic));
+  header.version = storeVersion;
+  header.count = static_cast<std::uint32_t>(records.size());
+  header.heapOffset = sizeof(StoreHeader) + records.size() * sizeof(StoreRecord);
+  header.heapSize = heap.size();
+
+  AtomicFile file(path, durability);
+  file.write(std::string_view(reinterpret_cast<const char*>(&header), sizeof(header)));
+  file.write(std::string_view(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(StoreRecord)));
+  file.write(heap);
+  file.commit();
+}
+
+/**
+ * @brief Maps a binary store file for reading and in-place status updates.
+ * @param path The store file to open.
+ * @throws std::runtime_error If the file is missing, not a binary store, truncated, or corrupt.
+ * @note Every record is checked once here, so at() and find() can trust that descriptions lie
+ *       within the heap and that records are sorted for the binary search by id.
+ */
+void BinaryStore::open(const std::string& path) {
+  file = MappedFile(path, MappedFile::Access::READ_WRITE);
+
+  StoreHeader header {};
+  if(file.size() < sizeof(header)) {
+    throw std::runtime_error("Truncated binary store: " + path);
+  }
+  std::memcpy(&header, file.data(), sizeof(header));
+  if(std::memcmp(header.magic, storeMagic, sizeof(storeMagic)) != 0 || header.version != storeVersion) {
+    throw std::runtime_error("Unsupported binary store: " + path);
+  }
+  if(header.heapOffset != sizeof(StoreHeader) + std::uint64_t(header.count) * sizeof(StoreRecord)
+     || header.heapOffset > file.size() || header.heapSize > file.size() - header.heapOffset) {
+    throw std::runtime_error("Truncated binary store: " + path);
+  }
+  for(std::size_t i = 0; i < header.count; ++i) {
+    StoreRecord record = readRecord(file.data(), i);
+    if(record.descriptionOffset > header.heapSize || record.descriptionLength > header.heapSize - record.descriptionOffset) {
+      throw std::runtime_error("Corrupt binary store: " + path + ": description of task " + std::to_string(record.id) +
+                               " lies outside the heap");
+    }
+    if(i > 0 && record.id <= readRecord(file.data(), i - 1).id) {
+      throw std::runtime_error("Corrupt binary store: " + path + ": records are not in ascending id order");
+    }
+  }
+  count = header.count;
+}
+
+std::size_t BinaryStore::size() const { return count; }
+
+/**
+ * @brief Gets a view of the record at the given position.
+ * @param index The record index, in ascending id order.
+ * @return A view into the mapped record and its description.
+ */
+TaskView BinaryStore::at(std::size_t index) const {
+  StoreRecord record = readRecord(file.data(), index);
+  const char* heap = file.data() + sizeof(StoreHeader) + count * sizeof(StoreRecord);
+  return TaskView(record.id, std::string_view(heap + record.descriptionOffset, record.descriptionLength),
+                  static_cast<TaskStatus>(record.status), record.createdAt, record.updatedAt);
+}
+
+/**
+ * @brief Finds a record by task ID using binary search over the record table.
+ * @param id The ID of the task to find.
+ * @return A view of the task if found, or std::nullopt if not.
+ */
+std::optional<TaskView> BinaryStore::find(int id) const {
+  if(auto index = indexOf(id)) return at(*index);
+  return std::nullopt;
+}
+
+/**
+ * @brief Overwrites the status and updatedAt fields of a record in place.
+ * @param id The ID of the task to update.
+ * @param status The new status.
+ * @param updatedAt The new last updated timestamp.
+ * @return True if the task exists and was patched.
+ */
+bool BinaryStore::patchStatus(int id, TaskStatus status, std::time_t updatedAt) {
+  auto index = indexOf(id);
+  if(!index) return false;
+
+  char* record = file.data() + sizeof(StoreHeader) + *index * sizeof(StoreRecord);
+  std::uint8_t statusByte = static_cast<std::uint8_t>(status);
+  std::int64_t updated = updatedAt;
+  std::memcpy(record + offsetof(StoreRecord, status), &statusByte, sizeof(statusByte));
+  std::memcpy(record + offsetof(StoreRecord, updatedAt), &updated, sizeof(updated));
+  return true;
+}
+
+void BinaryStore::sync() { file.sync(); }
+
+void BinaryStore::close() {
+  file.close();
+  count = 0;
+}
+
+std::optional<std::size_t> BinaryStore::indexOf(int id) const {
+  std::size_t low = 0, high = count;
+  while(low < high) {
+    std::size_t mid = low + (high - low) / 2;
+    std::int32_t midId;
+    std::memcpy(&midId, file.data() + sizeof(StoreHeader) + mid * sizeof(StoreRecord), sizeof(midId));
+    if(midId < id) low = mid + 1;
+    else high = mid;
+  }
+  if(low < count && readRecord(file.data(), low).id == id) return low;
+  return std::nullopt;
+}
@@ -0,0 +1,216 @@
+#include "core/FilterKernels.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define TASK_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define TASK_TARGET_AVX2
+#else
+#define TASK_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace {
+
+    /**
+     * @brief Active instruction set, or -1 until first use.
+     */
+    std::atomic<int> activeIsaValue{-1};
+
+    /**
+     * @brief Scalar status comparison for bitmap words [firstWord, bitmapWords(n)).
+     */
+    void statusEqualsFrom(const std::uint8_t* statuses, std::size_t n, std::uint8_t status, std::uint64_t* out,
+                          std::size_t firstWord) {
+        for(std::size_t w = firstWord; w < FilterKernels::bitmapWords(n); ++w) {
+            std::size_t base = w * 64;
+            std::size_t count = std::min<std::size_t>(64, n - base);
+            std::uint64_t bits = 0;
+            for(std::size_t j = 0; j < count; ++j) {
+                bits |= std::uint64_t(statuses[base + j] == status) << j;
+            }
+            out[w] = bits;
+        }
+    }
+
+    /**
+     * @brief Scalar range comparison for bitmap words [firstWord, bitmapWords(n)).
+     */
+    void inRangeFrom(const std::int64_t* values, std::size_t n, std::int64_t from, std::int64_t until,
+                     std::uint64_t* out, std::size_t firstWord) {
+        for(std::size_t w = firstWord; w < FilterKernels::bitmapWords(n); ++w) {
+            std::size_t base = w * 64;
+            std::size_t count = std::min<std::size_t>(64, n - base);
+            std::uint64_t bits = 0;
+            for(std::size_t j = 0; j < count; ++j) {
+                std::int64_t v = values[base + j];
+                bits |= std::uint64_t((v >= from) & (v < until)) << j;
+            }
+            out[w] = bits;
+        }
+    }
+
+    void statusEqualsScalar(const std::uint8_t* statuses, std::size_t n, std::uint8_t status, std::uint64_t* out) {
+        statusEqualsFrom(statuses, n, status, out, 0);
+    }
+
+    void inRangeScalar(const std::int64_t* values, std::size_t n, std::int64_t from, std::int64_t until, std::uint64_t* out) {
+        inRangeFrom(values, n, from, until, out, 0);
+    }
+
+#if defined(TASK_KERNELS_X86)
+
+    /**
+     * @brief SSE2 status comparison: four 16-byte compares per bitmap word.
+     */
+    void statusEqualsSse2(const std::uint8_t* statuses, std::size_t n, std::uint8_t status, std::uint64_t* out) {
+        const __m128i needle = _mm_set1_epi8(static_cast<char>(status));
+        const std::size_t fullWords = n / 64;
+        for(std::size_t w = 0; w < fullWords; ++w) {
+            const std::uint8_t* block = statuses + w * 64;
+            std::uint64_t bits = 0;
+            for(int k = 0; k < 4; ++k) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * k));
+                auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle)));
+                bits |= std::uint64_t(mask) << (16 * k);
+            }
+            out[w] = bits;
+        }
+        statusEqualsFrom(statuses, n, status, out, fullWords);
+    }
+
+    /**
+     * @brief AVX2 status comparison: two 32-byte compares per bitmap word.
+     */
+    TASK_TARGET_AVX2 void statusEqualsAvx2(const std::uint8_t* statuses, std::size_t n, std::uint8_t status, std::uint64_t* out) {
+        const __m256i needle = _mm256_set1_epi8(static_cast<char>(status));
+        const std::size_t fullWords = n / 64;
+        for(std::size_t w = 0; w < fullWords; ++w) {
+            const std::uint8_t* block = statuses + w * 64;
+            __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+            __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+            auto lowMask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(low, needle)));
+            auto highMask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(high, needle)));
+            out[w] = std::uint64_t(lowMask) | (std::uint64_t(highMask) << 32);
+        }
+        statusEqualsFrom(statuses, n, status, out, fullWords);
+    }
+
+    /**
+     * @brief AVX2 range comparison: sixteen 4-lane 64-bit compares per bitmap word.
+     * @note SSE2 has no 64-bit signed compare, so the SSE2 level uses the scalar range kernel.
+     */
+    TASK_TARGET_AVX2 void inRangeAvx2(const std::int64_t* values, std::size_t n, std::int64_t from, std::int64_t until,
+                                      std::uint64_t* out) {
+        const __m256i lower = _mm256_set1_epi64x(from);
+        const __m256i upper = _mm256_set1_epi64x(until);
+        const std::size_t fullWords = n / 64;
+        for(std::size_t w = 0; w < fullWords; ++w) {
+            const std::int64_t* block = values + w * 64;
+            std::uint64_t bits = 0;
+            for(int k = 0; k < 16; ++k) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 4 * k));
+                __m256i below = _mm256_cmpgt_epi64(lower, v);
+                __m256i inside = _mm256_andnot_si256(below, _mm256_cmpgt_epi64(upper, v));
+                auto mask = static_cast<std::uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(inside)));
+                bits |= std::uint64_t(mask) << (4 * k);
+            }
+            out[w] = bits;
+        }
+        inRangeFrom(values, n, from, until, out, fullWords);
+    }
+
+#endif
+
+}
+
+namespace FilterKernels {
+
+    /**
+     * @brief Gets the widest instruction set supported by the running CPU.
+     * @return The best supported instruction set.
+     */
+    Isa bestSupportedIsa() {
+#if defined(TASK_KERNELS_X86) && defined(_MSC_VER) && !defined(__clang__)
+      int info[4];
+      __cpuid(info, 1);
+      bool osSavesYmm = (info[2] & (1 << 27)) && (_xgetbv(0) & 0x6) == 0x6;
+      __cpuidex(info, 7, 0);
+      return osSavesYmm && (info[1] & (1 << 5)) ? Isa::AVX2 : Isa::SSE2;
+#elif defined(TASK_KERNELS_X86)
+      return __builtin_cpu_supports("avx2") ? Isa::AVX2 : Isa::SSE2;
+#else
+      return Isa::SCALAR;
+#endif
+    }
+
+    Isa activeIsa() {
+      int isa = activeIsaValue.load(std::memory_order_relaxed);
+      if(isa < 0) {
+        isa = static_cast<int>(bestSupportedIsa());
+        activeIsaValue.store(isa, std::memory_order_relaxed);
+      }
+      return static_cast<Isa>(isa);
+    }
+
+    void setIsa(Isa isa) {
+      activeIsaValue.store(static_cast<int>(std::min(isa, bestSupportedIsa())), std::memory_order_relaxed);
+    }
+
+    const char* isaName(Isa isa) {
+      switch(isa) {
+        case Isa::AVX2: return "avx2";
+        case Isa::SSE2: return "sse2";
+        default: return "scalar";
+      }
+    }
+
+    std::size_t bitmapWords(std::size_t n) { return (n + 63) / 64; }
+
+    void statusEquals(const std::uint8_t* statuses, std::size_t n, std::uint8_t status, std::uint64_t* out) {
+#if defined(TASK_KERNELS_X86)
+      switch(activeIsa()) {
+        case Isa::AVX2: return statusEqualsAvx2(statuses, n, status, out);
+        case Isa::SSE2: return statusEqualsSse2(statuses, n, status, out);
+        default: break;
+      }
+#endif
+      statusEqualsScalar(statuses, n, status, out);
+    }
+
+    void inRange(const std::int64_t* values, std::size_t n, std::int64_t from, std::int64_t until, std::uint64_t* out) {
+#if defined(TASK_KERNELS_X86)
+      if(activeIsa() == Isa::AVX2) return inRangeAvx2(values, n, from, until, out);
+#endif
+      inRangeScalar(values, n, from, until, out);
+    }
+
+    void andBitmaps(std::uint64_t* dst, const std::uint64_t* src, std::size_t words) {
+      for(std::size_t w = 0; w < words; ++w) dst[w] &= src[w];
+    }
+
+    void orBitmaps(std::uint64_t* dst, const std::uint64_t* src, std::size_t words) {
+      for(std::size_t w = 0; w < words; ++w) dst[w] |= src[w];
+    }
+
+    /**
+     * @brief Appends the positions of all set bits to a vector.
+     * @param bitmap The bitmap to read.
+     * @param n The number of elements the bitmap covers.
+     * @param rows The vector receiving the positions, ascending.
+     * @note Skips empty words entirely and visits only set bits within a word.
+     */
+    void collect(const std::uint64_t* bitmap, std::size_t n, std::vector<std::size_t>& rows) {
+      for(std::size_t w = 0; w < bitmapWords(n); ++w) {
+        std::uint64_t bits = bitmap[w];
+        while(bits) {
+          rows.push_back(w * 64 + static_cast<std::size_t>(std::countr_zero(bits)));
+          bits &= bits - 1;
+        }
+      }
+    }
+}
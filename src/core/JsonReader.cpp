@@ -0,0 +1,180 @@
+#include "core/JsonReader.h"
+#include <charconv>
+#include <stdexcept>
+
+/**
+ * @brief Constructs a reader over the given JSON text.
+ * @param input The JSON document; must outlive the reader.
+ */
+JsonReader::JsonReader(std::string_view input) : input(input) {}
+
+std::size_t JsonReader::position() const { return pos; }
+
+bool JsonReader::atEnd() {
+  skipWhitespace();
+  return pos >= input.size();
+}
+
+char JsonReader::peek() {
+  skipWhitespace();
+  return pos < input.size() ? input[pos] : '\0';
+}
+
+bool JsonReader::consume(char c) {
+  if(peek() != c || pos >= input.size()) return false;
+  ++pos;
+  return true;
+}
+
+void JsonReader::expect(char c) {
+  if(!consume(c)) {
+    fail(std::string("expected '") + c + "'");
+  }
+}
+
+/**
+ * @brief Reads a JSON string, unescaping it into the output buffer.
+ * @param out The buffer receiving the decoded string; cleared first.
+ * @throws std::runtime_error If the string is malformed or unterminated.
+ * @note Unescaped runs are appended in bulk; only escape sequences are decoded character by character.
+ * @note \\u escapes (including surrogate pairs) are re-encoded as UTF-8.
+ */
+void JsonReader::readString(std::string& out) {
+  expect('"');
+  out.clear();
+  while(true) {
+    std::size_t runEnd = input.find_first_of("\"\\", pos);
+    if(runEnd == std::string_view::npos) fail("unterminated string");
+    out.append(input.data() + pos, runEnd - pos);
+    pos = runEnd + 1;
+    if(input[runEnd] == '"') return;
+
+    if(pos >= input.size()) fail("unterminated escape sequence");
+    char escaped = input[pos++];
+    switch(escaped) {
+      case '"': out += '"'; break;
+      case '\\': out += '\\'; break;
+      case '/': out += '/'; break;
+      case 'b': out += '\b'; break;
+      case 'f': out += '\f'; break;
+      case 'n': out += '\n'; break;
+      case 'r': out += '\r'; break;
+      case 't': out += '\t'; break;
+      case 'u': {
+        unsigned codePoint = readHex4();
+        if(codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+          if(input.substr(pos, 2) != "\\u") fail("unpaired surrogate");
+          pos += 2;
+          unsigned low = readHex4();
+          if(low < 0xDC00 || low > 0xDFFF) fail("invalid low surrogate");
+          codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+        }
+        if(codePoint < 0x80) {
+          out += static_cast<char>(codePoint);
+        } else if(codePoint < 0x800) {
+          out += static_cast<char>(0xC0 | (codePoint >> 6));
+          out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else if(codePoint < 0x10000) {
+          out += static_cast<char>(0xE0 | (codePoint >> 12));
+          out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+          out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else {
+          out += static_cast<char>(0xF0 | (codePoint >> 18));
+          out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+          out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+          out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        break;
+      }
+      default:
+        fail("invalid escape sequence");
+    }
+  }
+}
+
+/**
+ * @brief Reads a JSON integer.
+ * @return The parsed integer value.
+ * @throws std::runtime_error If no valid integer is present.
+ * @note Parses in place with std::from_chars; no temporary strings are created.
+ */
+long long JsonReader::readInteger() {
+  skipWhitespace();
+  long long value = 0;
+  const char* begin = input.data() + pos;
+  auto [end, ec] = std::from_chars(begin, input.data() + input.size(), value);
+  if(ec != std::errc()) fail("expected integer");
+  pos += end - begin;
+  return value;
+}
+
+/**
+ * @brief Skips over a complete JSON value of any type.
+ * @throws std::runtime_error If the value is malformed.
+ * @note Used to ignore unknown keys so that newer store files remain readable.
+ */
+void JsonReader::skipValue() {
+  char c = peek();
+  if(c == '"') {
+    skipString();
+  } else if(c == '{' || c == '[') {
+    char close = c == '{' ? '}' : ']';
+    ++pos;
+    if(consume(close)) return;
+    do {
+      if(close == '}') {
+        skipString();
+        expect(':');
+      }
+      skipValue();
+    } while(consume(','));
+    expect(close);
+  } else {
+    std::size_t start = pos;
+    while(pos < input.size() && input[pos] != ',' && input[pos] != '}' && input[pos] != ']'
+          && input[pos] != ' ' && input[pos] != '\t' && input[pos] != '\n' && input[pos] != '\r') {
+      ++pos;
+    }
+    if(pos == start) fail("expected value");
+  }
+}
+
+/**
+ * @brief Skips over a JSON string without decoding it.
+ * @throws std::runtime_error If the string is unterminated.
+ */
+void JsonReader::skipString() {
+  expect('"');
+  while(true) {
+    std::size_t runEnd = input.find_first_of("\"\\", pos);
+    if(runEnd == std::string_view::npos) fail("unterminated string");
+    pos = runEnd + 1;
+    if(input[runEnd] == '"') return;
+    if(pos >= input.size()) fail("unterminated escape sequence");
+    ++pos;
+  }
+}
+
+void JsonReader::skipWhitespace() {
+  while(pos < input.size() && (input[pos] == ' ' || input[pos] == '\t' || input[pos] == '\n' || input[pos] == '\r')) {
+    ++pos;
+  }
+}
+
+unsigned JsonReader::readHex4() {
+  if(pos + 4 > input.size()) fail("truncated \\u escape");
+  unsigned value = 0;
+  for(int i = 0; i < 4; ++i) {
+    char c = input[pos++];
+    value <<= 4;
+    if(c >= '0' && c <= '9') value |= c - '0';
+    else if(c >= 'a' && c <= 'f') value |= c - 'a' + 10;
+    else if(c >= 'A' && c <= 'F') value |= c - 'A' + 10;
+    else fail("invalid hex digit in \\u escape");
+  }
+  return value;
+}
+
+void JsonReader::fail(const std::string& message) const {
+  throw std::runtime_error("Malformed JSON at offset " + std::to_string(pos) + ": " + message);
+}
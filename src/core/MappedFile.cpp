@@ -0,0 +1,109 @@
+#include "core/MappedFile.h"
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Maps the given file.
+ * @param path The file to map.
+ * @param access Whether the mapping may be written to.
+ * @throws std::runtime_error If the file cannot be opened or mapped.
+ * @note Empty files are valid and produce an empty mapping.
+ */
+MappedFile::MappedFile(const std::string& path, Access access) : path(path), access(access) {
+#if defined(_WIN32)
+  std::ifstream file(path, std::ios::binary);
+  if(!file){
+    throw std::runtime_error("Failed to open file for mapping: " + path);
+  }
+  file.seekg(0, std::ios::end);
+  fallback.resize(static_cast<std::size_t>(file.tellg()));
+  file.seekg(0, std::ios::beg);
+  file.read(fallback.data(), static_cast<std::streamsize>(fallback.size()));
+  bytes = fallback.empty() ? nullptr : fallback.data();
+  length = fallback.size();
+#else
+  int fd = ::open(path.c_str(), access == Access::READ_WRITE ? O_RDWR : O_RDONLY);
+  if(fd < 0){
+    throw std::runtime_error("Failed to open file for mapping: " + path);
+  }
+
+  struct stat info {};
+  if(::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Failed to stat file for mapping: " + path);
+  }
+
+  length = static_cast<std::size_t>(info.st_size);
+  if(length > 0) {
+    int protection = access == Access::READ_WRITE ? PROT_READ | PROT_WRITE : PROT_READ;
+    void* mapping = ::mmap(nullptr, length, protection, MAP_SHARED, fd, 0);
+    if(mapping == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Failed to map file: " + path);
+    }
+    bytes = static_cast<char*>(mapping);
+  }
+  ::close(fd);
+#endif
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept { *this = std::move(other); }
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if(this != &other) {
+    close();
+    path = std::move(other.path);
+    fallback = std::move(other.fallback);
+    bytes = std::exchange(other.bytes, nullptr);
+    length = std::exchange(other.length, 0);
+    access = other.access;
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile() { close(); }
+
+const char* MappedFile::data() const { return bytes; }
+
+char* MappedFile::data() { return bytes; }
+
+std::size_t MappedFile::size() const { return length; }
+
+/**
+ * @brief Flushes writes made through a read-write mapping to the file.
+ * @throws std::runtime_error If the data cannot be written back.
+ */
+void MappedFile::sync() {
+  if(!bytes || access != Access::READ_WRITE) return;
+#if defined(_WIN32)
+  std::ofstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+  if(!file.write(bytes, static_cast<std::streamsize>(length))) {
+    throw std::runtime_error("Failed to write back mapped file: " + path);
+  }
+#else
+  if(::msync(bytes, length, MS_SYNC) != 0) {
+    throw std::runtime_error("Failed to sync mapped file: " + path);
+  }
+#endif
+}
+
+/**
+ * @brief Unmaps the file, leaving this object empty.
+ */
+void MappedFile::close() {
+#if !defined(_WIN32)
+  if(bytes) ::munmap(bytes, length);
+#endif
+  fallback.clear();
+  bytes = nullptr;
+  length = 0;
+}
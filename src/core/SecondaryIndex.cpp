@@ -0,0 +1,171 @@
+#include "core/SecondaryIndex.h"
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+namespace {
+
+  /**
+   * @brief Merges sorted ranges of index entries, taking entries until the limit is reached.
+   * @param ranges Per-status [begin, end) ranges, each sorted so that before() holds for consecutive keys.
+   * @param limit The maximum number of tasks to take.
+   * @param result Receives the tasks in merge order.
+   * @param before Orders two keys.
+   * @note There is one range per status, so picking the first head by a linear scan is cheap.
+   */
+  template <typename Iterator, typename Before>
+  void mergeRanges(std::vector<std::pair<Iterator, Iterator>>& ranges, std::size_t limit,
+                   std::vector<const Task*>& result, Before before) {
+    while(result.size() < limit) {
+      std::pair<Iterator, Iterator>* next = nullptr;
+      for(auto& range : ranges) {
+        if(range.first == range.second) continue;
+        if(!next || before(range.first->first, next->first->first)) next = &range;
+      }
+      if(!next) return;
+      result.push_back(next->first->second);
+      ++next->first;
+    }
+  }
+
+}
+
+SecondaryIndex::SecondaryIndex() {
+  byId.reserve(STATUS_COUNT);
+  byUpdatedAt.reserve(STATUS_COUNT);
+  for(std::size_t i = 0; i < STATUS_COUNT; ++i) {
+    byId.emplace_back(&pool);
+    byUpdatedAt.emplace_back(&pool);
+  }
+}
+
+std::size_t SecondaryIndex::slot(TaskStatus status) { return static_cast<std::size_t>(status); }
+
+/**
+ * @brief Removes every entry and returns the node memory to the system.
+ * @note The maps are rebuilt by the next query that needs them.
+ */
+void SecondaryIndex::clear() {
+  for(auto& tasks : byId) tasks.clear();
+  for(auto& tasks : byUpdatedAt) tasks.clear();
+  pool.release();
+  byIdBuilt = false;
+  byUpdatedAtBuilt = false;
+}
+
+bool SecondaryIndex::isBuilt() const { return byIdBuilt || byUpdatedAtBuilt; }
+
+/**
+ * @brief Fills the ID maps.
+ * @note Tasks arrive in ID order, so every insert is an end hint and the build is linear.
+ */
+void SecondaryIndex::buildById(const TaskMap& tasks) {
+  for(const auto& [id, task] : tasks) {
+    auto& statusTasks = byId[slot(task.getStatus())];
+    statusTasks.emplace_hint(statusTasks.end(), id, &task);
+  }
+  byIdBuilt = true;
+}
+
+/**
+ * @brief Fills the update time maps.
+ * @note Sorts the keys once, so every insert is an end hint.
+ */
+void SecondaryIndex::buildByUpdatedAt(const TaskMap& tasks) {
+  std::vector<std::pair<UpdatedKey, const Task*>> updated;
+  updated.reserve(tasks.size());
+  for(const auto& [id, task] : tasks) updated.emplace_back(UpdatedKey(task.getUpdatedAt(), id), &task);
+
+  std::sort(updated.begin(), updated.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+  for(const auto& [key, task] : updated) {
+    auto& statusTasks = byUpdatedAt[slot(task->getStatus())];
+    statusTasks.emplace_hint(statusTasks.end(), key, task);
+  }
+  byUpdatedAtBuilt = true;
+}
+
+void SecondaryIndex::insert(const Task& task) {
+  if(byIdBuilt) byId[slot(task.getStatus())].emplace(task.getId(), &task);
+  if(byUpdatedAtBuilt) byUpdatedAt[slot(task.getStatus())].emplace(UpdatedKey(task.getUpdatedAt(), task.getId()), &task);
+}
+
+void SecondaryIndex::erase(int id, const Key& key) {
+  if(byIdBuilt) byId[slot(key.status)].erase(id);
+  if(byUpdatedAtBuilt) byUpdatedAt[slot(key.status)].erase(UpdatedKey(key.updatedAt, id));
+}
+
+/**
+ * @brief Answers a query.
+ * @param query The filter, order and page.
+ * @param tasks The tasks to build missing maps from; they must stay in place while indexed.
+ * @return The matching tasks in the requested order, at most query.limit of them.
+ * @note Queries with a status read that status's maps only; other queries merge the per-status
+ *       maps, which are each already in the requested order. A cursor narrows the ranges before
+ *       the merge, so a page starts with a lookup rather than a walk over the earlier pages.
+ */
+std::vector<const Task*> SecondaryIndex::query(const TaskQuery& query, const TaskMap& tasks) {
+  const TaskFilter& filter = query.filter;
+  const std::size_t wanted = query.end();
+  std::vector<const Task*> result;
+  std::vector<std::size_t> slots;
+  if(filter.status) {
+    slots.push_back(slot(*filter.status));
+  } else {
+    // Tombstones are only listed when asked for by status
+    for(std::size_t i = 0; i < STATUS_COUNT; ++i) {
+      if(i != slot(TaskStatus::DELETED)) slots.push_back(i);
+    }
+  }
+
+  if(filter.status && !filter.updatedFrom && !filter.updatedUntil && query.order == TaskOrder::ID) {
+    if(!byIdBuilt) buildById(tasks);
+    const auto& statusTasks = byId[slots.front()];
+    auto it = query.after ? statusTasks.upper_bound(query.after->id) : statusTasks.begin();
+    for(; it != statusTasks.end() && result.size() < wanted; ++it) result.push_back(it->second);
+    result.erase(result.begin(), result.begin() + static_cast<std::ptrdiff_t>(std::min(query.offset, result.size())));
+    return result;
+  }
+
+  // [updatedFrom, updatedUntil) in (updatedAt, ID) order, cut at the cursor in UPDATED and RECENT order
+  if(!byUpdatedAtBuilt) buildByUpdatedAt(tasks);
+  using Iterator = std::pmr::map<UpdatedKey, const Task*>::const_iterator;
+  UpdatedKey from(filter.updatedFrom.value_or(std::numeric_limits<std::time_t>::min()), std::numeric_limits<int>::min());
+  UpdatedKey until(filter.updatedUntil.value_or(std::numeric_limits<std::time_t>::max()), std::numeric_limits<int>::min());
+  bool bounded = filter.updatedUntil.has_value();
+  if(query.after && query.order == TaskOrder::UPDATED) {
+    const TaskCursor& cursor = *query.after;
+    from = std::max(from, cursor.id == std::numeric_limits<int>::max()
+                              ? UpdatedKey(cursor.updatedAt + 1, std::numeric_limits<int>::min())
+                              : UpdatedKey(cursor.updatedAt, cursor.id + 1));
+  } else if(query.after && query.order == TaskOrder::RECENT) {
+    until = bounded ? std::min(until, UpdatedKey(query.after->updatedAt, query.after->id))
+                    : UpdatedKey(query.after->updatedAt, query.after->id);
+    bounded = true;
+  }
+  until = std::max(from, until);
+  std::vector<std::pair<Iterator, Iterator>> ranges;
+  for(std::size_t i : slots) {
+    Iterator begin = byUpdatedAt[i].lower_bound(from);
+    Iterator end = bounded ? byUpdatedAt[i].lower_bound(until) : byUpdatedAt[i].end();
+    ranges.emplace_back(begin, end);
+  }
+
+  auto ascending = [](const UpdatedKey& a, const UpdatedKey& b) { return a < b; };
+  if(query.order == TaskOrder::UPDATED) {
+    mergeRanges(ranges, wanted, result, ascending);
+  } else if(query.order == TaskOrder::RECENT) {
+    using Reverse = std::reverse_iterator<Iterator>;
+    std::vector<std::pair<Reverse, Reverse>> reversed;
+    for(const auto& [begin, end] : ranges) reversed.emplace_back(Reverse(end), Reverse(begin));
+    mergeRanges(reversed, wanted, result, [](const UpdatedKey& a, const UpdatedKey& b) { return b < a; });
+  } else {
+    mergeRanges(ranges, SIZE_MAX, result, ascending);
+    if(query.after) std::erase_if(result, [after = query.after->id](const Task* task) { return task->getId() <= after; });
+    const std::size_t count = std::min(wanted, result.size());
+    auto byTaskId = [](const Task* a, const Task* b) { return a->getId() < b->getId(); };
+    std::partial_sort(result.begin(), result.begin() + static_cast<std::ptrdiff_t>(count), result.end(), byTaskId);
+    result.resize(count);
+  }
+  result.erase(result.begin(), result.begin() + static_cast<std::ptrdiff_t>(std::min(query.offset, result.size())));
+  return result;
+}
@@ -0,0 +1,125 @@
+#include "core/StoreLock.h"
+#include <stdexcept>
+#include <utility>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+StoreLock::Scope::Scope(StoreLock& lock, Mode mode) : lock(lock) { lock.lock(mode); }
+
+StoreLock::Scope::~Scope() { lock.unlock(); }
+
+StoreLock::StoreLock(std::string path) : path(std::move(path)) {}
+
+StoreLock::~StoreLock() {
+  if(fd < 0) return;
+#if defined(_WIN32)
+  ::_close(fd);
+#else
+  ::close(fd);
+#endif
+}
+
+/**
+ * @brief Blocks until the lock is acquired.
+ * @param mode The kind of lock.
+ * @throws std::runtime_error If an exclusive lock is requested and the lock file cannot be created.
+ * @throws std::logic_error If an exclusive lock is requested while only a shared one is held.
+ * @note If the lock file cannot be created (e.g. a read-only directory), shared locks proceed unlocked.
+ */
+void StoreLock::lock(Mode mode) {
+  if(depth > 0) {
+    if(mode == Mode::EXCLUSIVE && held == Mode::SHARED) {
+      throw std::logic_error("Cannot upgrade a shared store lock: " + path);
+    }
+    ++depth;
+    return;
+  }
+
+  if(fd < 0) {
+#if defined(_WIN32)
+    fd = ::_open(path.c_str(), _O_RDWR | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+#endif
+  }
+  if(fd < 0) {
+    if(mode == Mode::EXCLUSIVE) {
+      throw std::runtime_error("Failed to open lock file: " + path);
+    }
+    held = mode;
+    depth = 1;
+    return;
+  }
+
+#if defined(_WIN32)
+  OVERLAPPED overlapped {};
+  DWORD flags = mode == Mode::EXCLUSIVE ? LOCKFILE_EXCLUSIVE_LOCK : 0;
+  if(!::LockFileEx(reinterpret_cast<HANDLE>(::_get_osfhandle(fd)), flags, 0, MAXDWORD, MAXDWORD, &overlapped)) {
+    throw std::runtime_error("Failed to lock file: " + path);
+  }
+#else
+  int operation = mode == Mode::EXCLUSIVE ? LOCK_EX : LOCK_SH;
+  while(::flock(fd, operation) != 0) {
+    if(errno != EINTR) throw std::runtime_error("Failed to lock file: " + path);
+  }
+#endif
+  held = mode;
+  depth = 1;
+}
+
+void StoreLock::unlock() {
+  if(depth == 0 || --depth > 0 || fd < 0) return;
+#if defined(_WIN32)
+  OVERLAPPED overlapped {};
+  ::UnlockFileEx(reinterpret_cast<HANDLE>(::_get_osfhandle(fd)), 0, MAXDWORD, MAXDWORD, &overlapped);
+#else
+  ::flock(fd, LOCK_UN);
+#endif
+}
+
+/**
+ * @brief Reads the version counter.
+ * @return The number of saves committed under this lock file, or 0 if there is none.
+ * @note The counter is stored as 8 native-endian bytes at the start of the lock file.
+ */
+std::uint64_t StoreLock::version() const {
+  std::uint64_t version = 0;
+  if(fd < 0) return version;
+#if defined(_WIN32)
+  ::_lseeki64(fd, 0, SEEK_SET);
+  if(::_read(fd, &version, sizeof(version)) != sizeof(version)) version = 0;
+#else
+  if(::pread(fd, &version, sizeof(version), 0) != sizeof(version)) version = 0;
+#endif
+  return version;
+}
+
+/**
+ * @brief Increments the version counter.
+ * @return The new version.
+ * @throws std::runtime_error If the counter cannot be written.
+ * @note Requires the exclusive lock.
+ */
+std::uint64_t StoreLock::bumpVersion() {
+  std::uint64_t next = version() + 1;
+#if defined(_WIN32)
+  ::_lseeki64(fd, 0, SEEK_SET);
+  bool written = ::_write(fd, &next, sizeof(next)) == sizeof(next);
+#else
+  bool written = ::pwrite(fd, &next, sizeof(next), 0) == sizeof(next);
+#endif
+  if(!written) {
+    throw std::runtime_error("Failed to write lock file: " + path);
+  }
+  return next;
+}
@@ -1,18 +1,39 @@
 #include "core/Task.h"
-#include <format>
-#include <iomanip>
-#include <sstream>
+#include "core/TaskSerializer.h"
+#include "core/TaskView.h"
+#include <algorithm>
+#include <ctime>
 
-Task::Task(int id, std::string description, TaskStatus status, std::time_t createdAt, std::time_t updatedAt) :
-           id(id), description(description), status(status), createdAt(createdAt), updatedAt(updatedAt) {}
+Task::Task(int id, std::string_view description, TaskStatus status, std::time_t createdAt, std::time_t updatedAt,
+           const allocator_type& allocator) :
+           id(id), description(description, allocator), status(status), createdAt(createdAt), updatedAt(updatedAt) {}
+
+Task::Task(const Task& other, const allocator_type& allocator) :
+           id(other.id), description(other.description, allocator), status(other.status),
+           createdAt(other.createdAt), updatedAt(other.updatedAt) {}
+
+/**
+ * @brief Moves a task, storing the description with the given allocator.
+ * @param other The task to move from.
+ * @param allocator The allocator the new description is stored with.
+ * @note The description buffer is only stolen when both allocators share a memory resource.
+ */
+Task::Task(Task&& other, const allocator_type& allocator) :
+           id(other.id), description(std::move(other.description), allocator), status(other.status),
+           createdAt(other.createdAt), updatedAt(other.updatedAt) {}
 
 int Task::getId() const { return id; }
 
 void Task::setId(int id) { this->id = id; }
 
-std::string Task::getDescription() const { return description; }
+std::string_view Task::getDescription() const { return description; }
 
-void Task::setDescription(std::string description) { this->description = description; }
+/**
+ * @brief Sets the task's description.
+ * @param description The new task description.
+ * @note Reuses the existing buffer when the new description fits in it.
+ */
+void Task::setDescription(std::string_view description) { this->description.assign(description); }
 
 TaskStatus Task::getStatus() const { return status; }
 
@@ -21,14 +42,14 @@ TaskStatus Task::getStatus() const { return status; }
  * @return The status label (e.g., "To Do", "In Progress", "Done").
  * @note Relies on TaskUtils::statusToLabel() from "core/TaskStatus.h".
  */
-std::string Task::getStatusLabel() const { return TaskUtils::statusToLabel(status); }
+std::string Task::getStatusLabel() const { return std::string(TaskUtils::statusToLabel(status)); }
 
 /**
  * @brief Gets the key representation of the task's status.
  * @return The status key (e.g., "TODO", "IN_PROGRESS", "DONE").
  * @note Relies on TaskUtils::statusToKey() from "core/TaskStatus.h".
  */
-std::string Task::getStatusKey() const { return TaskUtils::statusToKey(status); }
+std::string Task::getStatusKey() const { return std::string(TaskUtils::statusToKey(status)); }
 
 void Task::setStatus(TaskStatus status) { this->status = status; }
 
@@ -49,22 +70,97 @@ std::string Task::getUpdatedAtFormatted() const { return formatTime(updatedAt);
  * @param time The timestamp to format.
  * @return The formatted time string (e.g., "2025/03/04 12:00:00").
  * @note Uses local time and the format "YYYY/MM/DD HH:MM:SS".
+ * @note Thread-safe; see formatTime(std::time_t, char*).
+ */
+std::string Task::formatTime(std::time_t time) {
+  char buffer[TIME_BUFFER_SIZE];
+  return std::string(buffer, formatTime(time, buffer));
+}
+
+/**
+ * @brief Formats a timestamp into a caller-provided buffer.
+ * @param time The timestamp to format.
+ * @param out The buffer receiving the text, at least TIME_BUFFER_SIZE bytes; not null-terminated.
+ * @return The number of characters written (19 for years 0 to 9999).
+ * @note Produces the same text as std::put_time with "%Y/%m/%d %H:%M:%S" in local time.
+ * @note Each thread caches the "YYYY/MM/DD " prefix of recently formatted local days, so a hit
+ *       costs no localtime_r call: the time of day is the offset from the cached midnight. Days
+ *       with a UTC offset change (daylight saving transitions) are never cached.
  */
-std::string Task::formatTime(std::time_t time) const {
-  std::tm* localTime = std::localtime(&time);
-  std::ostringstream oss;
-  oss << std::put_time(localTime, "%Y/%m/%d %H:%M:%S");
-  return oss.str();
+std::size_t Task::formatTime(std::time_t time, char* out) {
+  auto toLocal = [](std::time_t value) {
+    std::tm local{};
+#if defined(_WIN32)
+    localtime_s(&local, &value);
+#else
+    localtime_r(&value, &local);
+#endif
+    return local;
+  };
+  auto writeTwo = [](char* at, int value) {
+    at[0] = static_cast<char>('0' + value / 10);
+    at[1] = static_cast<char>('0' + value % 10);
+  };
+
+  // Direct-mapped by local day: shift is the UTC offset of the last cached day, which turns
+  // local midnights into multiples of DAY as long as the offset does not change
+  constexpr std::time_t DAY = 24 * 3600;
+  constexpr std::size_t SLOTS = 1024;
+  struct CachedDay {
+    std::time_t start = 1; ///< Local midnight, as a timestamp.
+    std::time_t end = 0;   ///< The next local midnight; start > end marks an empty slot.
+    char date[11];         ///< "YYYY/MM/DD ".
+  };
+  thread_local CachedDay cache[SLOTS];
+  thread_local std::time_t shift = 0;
+
+  std::time_t shifted = time + shift;
+  std::time_t localDay = shifted / DAY - (shifted % DAY < 0 ? 1 : 0);
+  CachedDay day = cache[static_cast<std::size_t>(localDay) % SLOTS];
+  if(time < day.start || time >= day.end) {
+    std::tm local = toLocal(time);
+    int year = local.tm_year + 1900;
+    if(year < 0 || year > 9999) {
+      return std::strftime(out, TIME_BUFFER_SIZE, "%Y/%m/%d %H:%M:%S", &local);
+    }
+
+    writeTwo(day.date, year / 100);
+    writeTwo(day.date + 2, year % 100);
+    day.date[4] = '/';
+    writeTwo(day.date + 5, local.tm_mon + 1);
+    day.date[7] = '/';
+    writeTwo(day.date + 8, local.tm_mday);
+    day.date[10] = ' ';
+    day.start = time - (local.tm_hour * 3600 + local.tm_min * 60 + local.tm_sec);
+    day.end = day.start + DAY;
+
+    // Only cache days whose midnights are 24 hours apart in local time, i.e. without a transition
+    std::tm first = toLocal(day.start), last = toLocal(day.end - 1);
+    if(first.tm_hour == 0 && first.tm_min == 0 && first.tm_sec == 0 && first.tm_mday == local.tm_mday
+       && last.tm_hour == 23 && last.tm_min == 59 && last.tm_sec == 59 && last.tm_mday == local.tm_mday) {
+      shift = ((-day.start) % DAY + DAY) % DAY;
+      cache[static_cast<std::size_t>((day.start + shift) / DAY) % SLOTS] = day;
+    }
+  }
+
+  auto seconds = static_cast<int>(time - day.start);
+  std::copy(day.date, day.date + sizeof(day.date), out);
+  writeTwo(out + 11, seconds / 3600);
+  out[13] = ':';
+  writeTwo(out + 14, seconds / 60 % 60);
+  out[16] = ':';
+  writeTwo(out + 17, seconds % 60);
+  return 19;
 }
 
 /**
  * @brief Converts the task to a human-readable string representation.
  * @return A string describing the task's attributes in the format:
  *         "Task: ( id: <id>, status: <label>, description: <desc>, createdAt: <time>, updatedAt: <time> )".
+ * @note Delegates to TaskView::toString() so tasks and mapped records format identically.
  */
 std::string Task::toString() const {
-    return std::format("Task: ( id: {}, status: {}, description: {}, createdAt: {}, updatedAt: {} )",
-                       getId(), getStatusLabel(), getDescription(), getCreatedAtFormatted(), getUpdatedAtFormatted());
+    return TaskView(*this).toString();
 }
 
 /**
@@ -72,8 +168,10 @@ std::string Task::toString() const {
  * @return A JSON string in the format:
  *         {"id":<id>,"description":"<desc>","status":"<key>","createdAt":<time>,"updatedAt":<time>}.
  * @note Uses raw timestamps (std::time_t) for createdAt and updatedAt fields.
+ * @note Delegates to TaskSerializer, which escapes the description.
  */
 std::string Task::toJSON() const {
-    return std::format("{{\"id\":{},\"description\":\"{}\",\"status\":\"{}\",\"createdAt\":{},\"updatedAt\":{}}}",
-                       id, description, TaskUtils::statusToKey(status), createdAt, updatedAt);
+    TaskSerializer serializer;
+    serializer.appendTask(TaskView(*this));
+    return serializer.take();
 }
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include "core/TaskArena.h"
+#include <algorithm>
+
+void* TaskArena::CountingUpstream::do_allocate(std::size_t bytes, std::size_t alignment) {
+  void* p = std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  reservedBytes += bytes;
+  peakReservedBytes = std::max(peakReservedBytes, reservedBytes);
+  return p;
+}
+
+void TaskArena::CountingUpstream::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+  std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  reservedBytes -= bytes;
+}
+
+bool TaskArena::CountingUpstream::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+/**
+ * @brief Frees every block of the arena at once.
+ * @note Everything allocated from the arena must already be destroyed.
+ */
+void TaskArena::release() {
+  monotonic.release();
+  usedBytes = 0;
+  allocations = 0;
+}
+
+ArenaStats TaskArena::stats() const {
+  return {usedBytes, upstream.reservedBytes, upstream.peakReservedBytes, allocations};
+}
+
+void* TaskArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+  usedBytes += bytes;
+  ++allocations;
+  return monotonic.allocate(bytes, alignment);
+}
+
+void TaskArena::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+  monotonic.deallocate(p, bytes, alignment);
+}
+
+bool TaskArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
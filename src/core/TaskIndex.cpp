@@ -0,0 +1,192 @@
+#include "core/TaskIndex.h"
+#include "core/AtomicFile.h"
+#include "core/Stats.h"
+#include "core/TaskParser.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+    /**
+     * @brief Magic bytes identifying an index file.
+     */
+    constexpr char indexMagic[8] = {'T', 'T', 'I', 'N', 'D', 'E', 'X', '2'};
+
+    /**
+     * @brief On-disk header at the start of an index file.
+     */
+    struct IndexHeader {
+        char magic[8];
+        std::uint64_t storeSize;
+        std::int64_t storeMtime;
+        std::uint64_t storeVersion;
+        std::uint64_t count;
+    };
+
+    static_assert(sizeof(IndexHeader) == 40, "IndexHeader must match the on-disk layout");
+    static_assert(sizeof(TaskIndex::Entry) == 16, "TaskIndex::Entry must match the on-disk layout");
+
+    /**
+     * @brief Builds a header stamped with the store's current size, modification time and version.
+     * @note The version catches rewrites that the size and (coarse) mtime alone would miss.
+     */
+    IndexHeader stampFor(const std::string& storePath, std::uint64_t version, std::uint64_t count) {
+        IndexHeader header {};
+        std::memcpy(header.magic, indexMagic, sizeof(indexMagic));
+        header.storeSize = std::filesystem::file_size(storePath);
+        header.storeMtime = std::filesystem::last_write_time(storePath).time_since_epoch().count();
+        header.storeVersion = version;
+        header.count = count;
+        return header;
+    }
+
+}
+
+/**
+ * @brief Opens the index for a store, rebuilding it if missing or stale.
+ * @param storePath The JSON store to index.
+ * @param storeVersion The current StoreLock version of the store.
+ * @throws std::runtime_error If the store is malformed or the index cannot be written.
+ * @note The index is considered stale when the store's size, mtime or version differs from the
+ *       stamp recorded in the index header.
+ */
+void TaskIndex::open(const std::string& storePath, std::uint64_t storeVersion) {
+  this->storePath = storePath;
+  indexPath = storePath + ".idx";
+  version = storeVersion;
+  appended.clear();
+
+  std::error_code ec;
+  if(std::filesystem::exists(indexPath, ec)) {
+    file = MappedFile(indexPath, MappedFile::Access::READ_ONLY);
+    IndexHeader current = stampFor(storePath, version, 0);
+    IndexHeader header {};
+    if(file.size() >= sizeof(header)) {
+      std::memcpy(&header, file.data(), sizeof(header));
+      if(std::memcmp(header.magic, indexMagic, sizeof(indexMagic)) == 0
+         && header.storeSize == current.storeSize && header.storeMtime == current.storeMtime
+         && header.storeVersion == current.storeVersion
+         && file.size() == sizeof(IndexHeader) + header.count * sizeof(Entry)) {
+        count = header.count;
+        return;
+      }
+    }
+  }
+  rebuild();
+}
+
+/**
+ * @brief Finds the location of a task by ID.
+ * @param id The ID of the task to find.
+ * @return The index entry, or std::nullopt if the task is not in the store.
+ */
+std::optional<TaskIndex::Entry> TaskIndex::find(int id) const {
+  std::size_t low = 0, high = count;
+  while(low < high) {
+    std::size_t mid = low + (high - low) / 2;
+    if(entryAt(mid).id < id) low = mid + 1;
+    else high = mid;
+  }
+  if(low < count && entryAt(low).id == id) return entryAt(low);
+
+  for(const Entry& entry : appended) {
+    if(entry.id == id) return entry;
+  }
+  return std::nullopt;
+}
+
+std::size_t TaskIndex::size() const { return count + appended.size(); }
+
+int TaskIndex::maxId() const {
+  if(!appended.empty()) return appended.back().id;
+  return count == 0 ? 0 : entryAt(count - 1).id;
+}
+
+void TaskIndex::append(const Entry& entry) { appended.push_back(entry); }
+
+/**
+ * @brief Persists appended entries and re-stamps the index with the store's current size and mtime.
+ * @param storeVersion The StoreLock version the patched store is saved as.
+ * @throws std::runtime_error If the index file cannot be written.
+ * @note Appended entries go to the end of the file, so committing costs O(appended) I/O.
+ */
+void TaskIndex::commit(std::uint64_t storeVersion) {
+  version = storeVersion;
+  file.close();
+
+  std::fstream out(indexPath, std::ios::binary | std::ios::in | std::ios::out);
+  if(!out){
+    throw std::runtime_error("Failed to open index file: " + indexPath);
+  }
+  out.seekp(0, std::ios::end);
+  out.write(reinterpret_cast<const char*>(appended.data()), static_cast<std::streamsize>(appended.size() * sizeof(Entry)));
+  out.flush();
+
+  count += appended.size();
+  appended.clear();
+
+  IndexHeader header = stampFor(storePath, version, count);
+  out.seekp(0, std::ios::beg);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.close();
+  if(!out){
+    throw std::runtime_error("Failed to write index file: " + indexPath);
+  }
+
+  file = MappedFile(indexPath, MappedFile::Access::READ_ONLY);
+}
+
+void TaskIndex::close() {
+  file.close();
+  count = 0;
+  appended.clear();
+}
+
+TaskIndex::Entry TaskIndex::entryAt(std::size_t index) const {
+  Entry entry;
+  std::memcpy(&entry, file.data() + sizeof(IndexHeader) + index * sizeof(Entry), sizeof(Entry));
+  return entry;
+}
+
+/**
+ * @brief Scans the store and writes a fresh index file.
+ * @throws std::runtime_error If the store is malformed or the index cannot be written.
+ * @note Uses TaskParser::scanNext(), which decodes ids only and skips descriptions.
+ * @note The new index is renamed over the old one, so other processes mapping it are unaffected.
+ *       It is derived data and is not flushed to disk.
+ */
+void TaskIndex::rebuild() {
+  TASK_STATS_SCOPE("rebuild index");
+  file.close();
+
+  std::ifstream store(storePath, std::ios::binary);
+  std::string json;
+  store.seekg(0, std::ios::end);
+  json.resize(static_cast<std::size_t>(store.tellg()));
+  store.seekg(0, std::ios::beg);
+  store.read(json.data(), static_cast<std::streamsize>(json.size()));
+  store.close();
+  TASK_STATS_ADD("bytes read", json.size());
+
+  std::vector<Entry> entries;
+  TaskParser parser(json);
+  while(auto id = parser.scanNext()) {
+    entries.push_back({*id, static_cast<std::uint32_t>(parser.lastObjectLength()),
+                       static_cast<std::uint64_t>(parser.lastObjectOffset())});
+  }
+  std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.id < b.id; });
+  entries.erase(std::unique(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.id == b.id; }),
+                entries.end());
+
+  IndexHeader header = stampFor(storePath, version, entries.size());
+  AtomicFile out(indexPath, Durability::NONE);
+  out.write(std::string_view(reinterpret_cast<const char*>(&header), sizeof(header)));
+  out.write(std::string_view(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry)));
+  out.commit();
+
+  file = MappedFile(indexPath, MappedFile::Access::READ_ONLY);
+  count = entries.size();
+}
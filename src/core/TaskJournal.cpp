@@ -0,0 +1,123 @@
+#include "core/TaskJournal.h"
+#include "core/JsonReader.h"
+#include "core/TaskParser.h"
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+/**
+ * @brief Constructs a journal backed by the given log file.
+ * @param path The file path of the log.
+ */
+TaskJournal::TaskJournal(std::string path) : path(std::move(path)) {}
+
+const std::string& TaskJournal::getPath() const { return path; }
+
+/**
+ * @brief Records that a task was added or modified.
+ * @param op The operation name ("add", "update" or "status").
+ * @param task The task state after the mutation.
+ * @note Produces a line of the form {"op":"<op>","task":{...}}.
+ */
+void TaskJournal::recordPut(std::string_view op, const Task& task) {
+  buffer.appendRaw("{\"op\":\"");
+  buffer.appendRaw(op);
+  buffer.appendRaw("\",\"task\":");
+  buffer.appendTask(TaskView(task));
+  buffer.appendRaw("}\n");
+}
+
+/**
+ * @brief Records that a task was deleted.
+ * @param id The ID of the deleted task.
+ * @note Produces a line of the form {"op":"delete","id":<id>}.
+ */
+void TaskJournal::recordDelete(int id) {
+  buffer.appendRaw("{\"op\":\"delete\",\"id\":");
+  buffer.appendInteger(id);
+  buffer.appendRaw("}\n");
+}
+
+bool TaskJournal::hasPending() const { return !buffer.empty(); }
+
+void TaskJournal::discardPending() { buffer.clear(); }
+
+/**
+ * @brief Appends all buffered records to the log in a single write.
+ * @param durability How the appended records are flushed to disk.
+ * @throws std::runtime_error If the log cannot be opened for appending.
+ * @note A torn append (from a crash before the flush completes) is ignored by replay().
+ */
+void TaskJournal::flush(Durability durability) {
+  if(buffer.empty()) return;
+
+  AtomicFile::append(path, buffer.view(), durability);
+  buffer.clear();
+}
+
+std::uintmax_t TaskJournal::size() const {
+  std::error_code ec;
+  std::uintmax_t bytes = std::filesystem::file_size(path, ec);
+  return ec ? 0 : bytes;
+}
+
+/**
+ * @brief Applies every record in the log to the given tasks.
+ * @param tasks The tasks loaded from the last snapshot.
+ * @throws std::runtime_error If a record other than the last one is malformed.
+ * @note A malformed final record is treated as a torn append from an interrupted process and ignored.
+ */
+void TaskJournal::replay(TaskMap& tasks) const {
+  std::ifstream file(path, std::ios::binary);
+  if(!file) return;
+
+  std::string log;
+  file.seekg(0, std::ios::end);
+  log.resize(static_cast<std::size_t>(file.tellg()));
+  file.seekg(0, std::ios::beg);
+  file.read(log.data(), static_cast<std::streamsize>(log.size()));
+  file.close();
+
+  JsonReader reader(log);
+  std::string key, text, op;
+  Task::allocator_type allocator(tasks.get_allocator().resource());
+  while(!reader.atEnd()) {
+    std::size_t recordStart = reader.position();
+    try {
+      std::optional<Task> task;
+      int id = 0;
+
+      reader.expect('{');
+      do {
+        reader.readString(key);
+        reader.expect(':');
+        if(key == "op") reader.readString(op);
+        else if(key == "task") task = TaskParser::parseObject(reader, key, text, allocator);
+        else if(key == "id") id = static_cast<int>(reader.readInteger());
+        else reader.skipValue();
+      } while(reader.consume(','));
+      reader.expect('}');
+
+      if(op == "delete") {
+        tasks.erase(id);
+      } else if(task) {
+        id = task->getId();
+        tasks.insert_or_assign(id, std::move(*task));
+      } else {
+        throw std::runtime_error("Malformed journal record at offset " + std::to_string(recordStart));
+      }
+    } catch(const std::runtime_error&) {
+      if(log.find('\n', recordStart) == std::string::npos) return;
+      throw;
+    }
+  }
+}
+
+/**
+ * @brief Deletes the log file and discards any buffered records.
+ */
+void TaskJournal::clear() {
+  buffer.clear();
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+}
@@ -1,107 +1,735 @@
 #include "core/TaskManager.h"
+#include "core/TaskParser.h"
+#include "core/TaskSerializer.h"
+#include "core/Stats.h"
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <filesystem>
 #include <fstream>
-#include <sstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
 
 /**
  * @brief Constructs a TaskManager with an optional store file name.
  * @param storeName The name of the file to persist tasks (defaults to "tasks.json").
  */
-TaskManager::TaskManager(const std::string& storeName) : storeName(storeName) {}
+TaskManager::TaskManager(const std::string& storeName) :
+             storeName(storeName), journal(storeName + ".log"), storeLock(storeName + ".lock") {}
+
+void TaskManager::setStoreMode(StoreMode mode) { storeMode = mode; }
+
+void TaskManager::setJournalCompactionThreshold(std::uintmax_t bytes) { journalCompactionThreshold = bytes; }
+
+/**
+ * @brief Sets how store and journal writes are flushed to disk.
+ * @param level The durability level to use.
+ * @note Stores are always replaced atomically; the level only decides what survives a power loss.
+ */
+void TaskManager::setDurability(Durability level) { durability = level; }
+
+StoreFormat TaskManager::getStoreFormat() const { return storeFormat; }
+
+void TaskManager::setLazyLoading(bool enabled) { lazyLoading = enabled; }
+
+void TaskManager::setLoadThreads(std::size_t threads) { loadThreads = threads; }
+
+void TaskManager::setSaveThreads(std::size_t threads) { saveThreads = threads; }
 
 /**
- * @brief Saves all tasks to the store file in JSON format.
+ * @brief Persists the tasks according to the current store mode.
+ * @throws std::runtime_error If the store or journal file cannot be opened for writing.
+ * @note In StoreMode::SNAPSHOT, rewrites the store file and removes any leftover journal.
+ * @note In StoreMode::JOURNAL, appends pending mutations and compacts once the log passes the threshold.
+ * @note Binary stores that were only patched in place are synced instead of rewritten.
+ * @note Lazily loaded JSON stores are patched in place, falling back to a full rewrite when a
+ *       changed task no longer fits in its original slot.
+ * @note If another process saved since the tasks were loaded, its changes are merged first; see rebase().
+ * @note With deferred saving enabled, only records that a save is needed; see flushPendingSave().
+ */
+void TaskManager::saveTasksToStore() {
+  TASK_STATS_SCOPE("save");
+  if(deferredSaving) {
+    pendingSave = true;
+    return;
+  }
+  persist(false);
+}
+
+/**
+ * @brief Defers saves, so saveTasksToStore() only records that the tasks need saving.
+ * @param enabled Whether saves are deferred.
+ * @note Lets a long-running owner of the store batch many commands into one write with flushPendingSave().
+ */
+void TaskManager::setDeferredSaving(bool enabled) { deferredSaving = enabled; }
+
+bool TaskManager::hasPendingSave() const { return pendingSave; }
+
+/**
+ * @brief Performs the deferred save, if any.
+ * @return True if another process had saved in the meantime and its changes were merged in
+ *         (see rebase()), so the tasks now differ from what the deferred changes alone produced.
+ * @throws std::runtime_error If the store, journal or lock file cannot be written.
+ */
+bool TaskManager::flushPendingSave() {
+  if(!pendingSave) return false;
+  bool merged = persist(false);
+  pendingSave = false;
+  return merged;
+}
+
+/**
+ * @brief Reloads the store if another process saved since it was loaded.
+ * @return True if the tasks were reloaded.
+ * @throws std::runtime_error If the store or journal is malformed or cannot be written.
+ * @note Unsaved changes are saved first, merged with the other process's changes (see rebase()).
+ * @note Costs one shared lock and an 8-byte read when nothing changed.
+ */
+bool TaskManager::refresh() {
+  {
+    StoreLock::Scope scope(storeLock, StoreLock::Mode::SHARED);
+    if(storeLock.version() == loadedVersion) return false;
+  }
+
+  if(pendingChanges.empty()) {
+    loadTasksFromStore();
+  } else {
+    persist(false);
+  }
+  pendingSave = false;
+  return true;
+}
+
+/**
+ * @brief Writes a full snapshot of all tasks to the store and removes the journal.
  * @throws std::runtime_error If the store file cannot be opened for writing.
- * @note Writes tasks as a JSON array, with each task represented as a JSON object.
+ * @note The snapshot is written before the log is removed, so an interruption in between
+ *       only leaves records that replay idempotently over the new snapshot.
  */
-void TaskManager::saveTasksToStore() const {
-  std::ofstream file(storeName);
-  if(!file){
-    throw std::runtime_error("Failed to open store file: " + storeName);
+void TaskManager::compactStore() { persist(true); }
+
+/**
+ * @brief Gets the ID an added task ended up with after the last save.
+ * @param id The ID the task was added with.
+ * @return The task's current ID; differs from id if another process added a task with that ID first.
+ */
+int TaskManager::resolveId(int id) const {
+  auto it = remappedIds.find(id);
+  return it == remappedIds.end() ? id : it->second;
+}
+
+/**
+ * @brief Takes the exclusive store lock and writes pending changes or a full snapshot.
+ * @param compact Whether to write a full snapshot rather than only the pending changes.
+ * @throws std::runtime_error If the store, journal or lock file cannot be written.
+ * @note The version check, the version bump and the write happen under one exclusive lock, so
+ *       saves of concurrent processes are serialized and none of them overwrites another's changes.
+ *       The version is bumped before writing; a failed write only costs other processes a rebase.
+ * @note A text index is committed after the store, stamped with the new version, so a crash in
+ *       between leaves it stale rather than wrong.
+ * @return True if another process's save was merged in first (see rebase()).
+ */
+bool TaskManager::persist(bool compact) {
+  StoreLock::Scope scope(storeLock, StoreLock::Mode::EXCLUSIVE);
+  rollBackInterruptedPatch();
+  bool merged = storeLock.version() != loadedVersion;
+  if(merged) {
+    TASK_STATS_SCOPE("rebase");
+    rebase();
+  }
+  openTextIndex();
+
+  loadedVersion = storeLock.bumpVersion();
+  indexVersion = loadedVersion;
+  {
+    TASK_STATS_SCOPE("write");
+    if(compact) writeCompacted();
+    else writeChanges();
+  }
+  if(textIndex.isOpen()) {
+    TASK_STATS_SCOPE("text index");
+    textIndex.commit(loadedVersion);
+  }
+  pendingChanges.clear();
+  return merged;
+}
+
+void TaskManager::writeChanges() {
+  if(storeFormat == StoreFormat::BINARY && !materialized) {
+    for(int id : patchedIds) {
+      const Task& task = tasks.at(id);
+      binaryStore.patchStatus(id, task.getStatus(), task.getUpdatedAt());
+    }
+    binaryStore.sync();
+    patchedIds.clear();
+    return;
+  }
+
+  if(storeFormat == StoreFormat::JSON && !materialized && persistLazyChanges()) {
+    return;
+  }
+
+  if(!isJournaling()) {
+    writeCompacted();
+    return;
+  }
+
+  journal.flush(durability);
+  if(journal.size() > journalCompactionThreshold) {
+    writeCompacted();
+  }
+}
+
+void TaskManager::writeCompacted() {
+  materializeTasks();
+  writeSnapshot(storeName, storeFormat);
+  journal.clear();
+}
+
+/**
+ * @brief Reloads the tasks saved by another process and re-applies the pending changes.
+ * @note Requires the exclusive store lock.
+ * @note Added tasks whose ID was taken in the meantime get the next free ID (see resolveId()).
+ *       Description and status changes are applied field by field, so another process's change
+ *       to a different field of the same task is kept. Changes to tasks that another process
+ *       deleted are dropped.
+ * @note The merged tasks are materialized, so the following write is a full one.
+ */
+void TaskManager::rebase() {
+  // Capture this manager's state of every changed task before the old state is dropped
+  std::vector<std::pair<PendingChange, std::optional<Task>>> changes;
+  changes.reserve(pendingChanges.size());
+  for(const PendingChange& change : pendingChanges) {
+    std::optional<Task> state;
+    if(change.op != "delete") {
+      if(auto view = findTaskView(change.id)) state = view->toTask();
+    }
+    changes.emplace_back(change, std::move(state));
+  }
+
+  TaskMap fresh(tasks.get_allocator());
+  if(BinaryStore::isBinaryStore(storeName)) {
+    storeFormat = StoreFormat::BINARY;
+    binaryStore.open(storeName);
+    Task::allocator_type allocator(fresh.get_allocator().resource());
+    for(std::size_t i = 0; i < binaryStore.size(); ++i) {
+      TaskView view = binaryStore.at(i);
+      fresh.emplace_hint(fresh.end(), view.getId(), view.toTask(allocator));
+    }
+  } else {
+    storeFormat = StoreFormat::JSON;
+    readStore(fresh);
+    journal.replay(fresh);
+  }
+
+  journal.discardPending();
+  for(auto& [change, state] : changes) {
+    int id = resolveId(change.id);
+    if(change.op == "delete") {
+      if(fresh.erase(id) && isJournaling()) journal.recordDelete(id);
+      continue;
+    }
+    if(!state) continue;
+
+    if(change.op == "add") {
+      if(fresh.contains(id)) {
+        id = fresh.rbegin()->first + 1;
+        remappedIds[change.id] = id;
+      }
+      state->setId(id);
+      fresh.insert_or_assign(id, std::move(*state));
+    } else {
+      auto it = fresh.find(id);
+      if(it == fresh.end()) continue;
+      if(change.op == "update") it->second.setDescription(state->getDescription());
+      else it->second.setStatus(state->getStatus());
+      it->second.setUpdatedAt(state->getUpdatedAt());
+    }
+    if(isJournaling()) journal.recordPut(change.op, fresh.at(id));
+  }
+
+  tasks.swap(fresh);
+  materialized = true;
+  tableValid = false;
+  secondaryIndex.clear();
+  textIndex.close();
+  patchedIds.clear();
+  appendedIds.clear();
+}
+
+/**
+ * @brief Writes every task to another file in the given format.
+ * @param path The destination file.
+ * @param format The format to write.
+ * @throws std::runtime_error If the destination cannot be written.
+ */
+void TaskManager::exportStore(const std::string& path, StoreFormat format) const {
+  materializeTasks();
+  writeSnapshot(path, format);
+}
+
+/**
+ * @brief Writes every task to a file in the given format.
+ * @param path The destination file.
+ * @param format The format to write.
+ * @throws std::runtime_error If the destination cannot be opened for writing.
+ * @note JSON snapshots are written as a JSON array, with each task represented as a JSON object.
+ * @note Tasks are encoded by a TaskSerializer into one buffer that is written out in
+ *       FLUSH_THRESHOLD-sized chunks, one write per chunk.
+ * @note Snapshots of PARALLEL_SAVE_THRESHOLD tasks or more are split into batches of
+ *       PARALLEL_SAVE_BATCH tasks that worker threads encode into a ring of reusable buffers,
+ *       two per worker, while the calling thread writes the finished ones in order. Encoding and
+ *       writing overlap and memory stays bounded, and the file is byte-identical to the
+ *       sequential output.
+ * @note The file is replaced atomically through an AtomicFile, flushed according to the durability,
+ *       so an interrupted save leaves the previous store intact.
+ */
+void TaskManager::writeSnapshot(const std::string& path, StoreFormat format) const {
+  TASK_STATS_ADD("tasks written", tasks.size());
+  if(format == StoreFormat::BINARY) {
+    BinaryStore::write(path, tasks, durability);
+    return;
+  }
+
+  AtomicFile file(path, durability);
+  std::size_t threads = saveThreads != 0 ? saveThreads : std::max(1u, std::thread::hardware_concurrency());
+  threads = std::min(threads, tasks.size() / PARALLEL_SAVE_CHUNK);
+  if(tasks.size() >= PARALLEL_SAVE_THRESHOLD && threads > 1) {
+    // Batch b holds the tasks in [starts[b], starts[b + 1])
+    std::vector<TaskMap::const_iterator> starts;
+    starts.reserve(tasks.size() / PARALLEL_SAVE_BATCH + 2);
+    std::size_t position = 0;
+    for(auto task = tasks.cbegin(); task != tasks.cend(); ++task, ++position) {
+      if(position % PARALLEL_SAVE_BATCH == 0) starts.push_back(task);
+    }
+    starts.push_back(tasks.cend());
+    const std::size_t batches = starts.size() - 1;
+
+    // Worker t encodes batches t, t + threads, ... into slot batch % slots.size(), so each slot
+    // belongs to one worker; the slot's batch number hands it to the writer and back
+    constexpr std::size_t FREE = SIZE_MAX;
+    struct Slot {
+      TaskSerializer serializer;
+      std::size_t batch = FREE; ///< The encoded batch waiting to be written, or FREE.
+    };
+    std::vector<Slot> slots(2 * threads);
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool stop = false;
+    std::exception_ptr error;
+
+    auto encode = [&](std::size_t worker) {
+      for(std::size_t batch = worker; batch < batches; batch += threads) {
+        Slot& slot = slots[batch % slots.size()];
+        {
+          std::unique_lock lock(mutex);
+          changed.wait(lock, [&] { return stop || slot.batch == FREE; });
+          if(stop) return;
+        }
+        try {
+          // Every batch but the first continues the array, so the writer needs no separators
+          slot.serializer.appendRaw(batch == 0 ? "[" : ", ");
+          for(auto task = starts[batch]; task != starts[batch + 1]; ++task) {
+            if(task != starts[batch]) slot.serializer.appendRaw(", ");
+            slot.serializer.appendTask(TaskView(task->second));
+          }
+          if(batch + 1 == batches) slot.serializer.appendRaw("]");
+        } catch(...) {
+          std::lock_guard lock(mutex);
+          if(!error) error = std::current_exception();
+          stop = true;
+          changed.notify_all();
+          return;
+        }
+        {
+          std::lock_guard lock(mutex);
+          slot.batch = batch;
+        }
+        changed.notify_all();
+      }
+    };
+    {
+      TASK_STATS_SCOPE("encode");
+      std::vector<std::jthread> workers;
+      workers.reserve(threads);
+      for(std::size_t worker = 0; worker < threads; ++worker) workers.emplace_back(encode, worker);
+      try {
+        for(std::size_t batch = 0; batch < batches; ++batch) {
+          Slot& slot = slots[batch % slots.size()];
+          {
+            std::unique_lock lock(mutex);
+            changed.wait(lock, [&] { return stop || slot.batch == batch; });
+            if(stop) break;
+          }
+          file.write(slot.serializer.view());
+          slot.serializer.clear();
+          {
+            std::lock_guard lock(mutex);
+            slot.batch = FREE;
+          }
+          changed.notify_all();
+        }
+      } catch(...) {
+        std::lock_guard lock(mutex);
+        if(!error) error = std::current_exception();
+        stop = true;
+        changed.notify_all();
+      }
+    }
+    if(error) std::rethrow_exception(error);
+    file.commit();
+    return;
   }
 
-  file << "[";
+  TaskSerializer serializer;
+  serializer.appendRaw("[");
   bool first = true;
   for(const auto& [id, task] : tasks) {
-    if(!first) file << ", ";
-    file << task.toJSON();
+    if(!first) serializer.appendRaw(", ");
+    serializer.appendTask(TaskView(task));
+    if(serializer.size() >= TaskSerializer::FLUSH_THRESHOLD) {
+      file.write(serializer.view());
+      serializer.clear();
+    }
     first = false;
   }
-  file << "]";
-  file.close();
+  serializer.appendRaw("]");
+  file.write(serializer.view());
+  file.commit();
 }
 
 /**
  * @brief Loads tasks from the store file into the tasks map.
  * @note If the file does not exist, creates a default file with an initial task:
- *       {"id":1,"description":"Created Store","status":"todo","createdAt":0,"updatedAt":0}.
+ *       {"id":1,"description":"Created Store","status":"todo","createdAt":0,"updatedAt":0}
+ *       (see prepareStore()).
  * @note Overwrites any existing tasks in the map with the loaded data.
- * @note Assumes a simple JSON format and may not handle malformed JSON robustly.
+ * @note Reads the file in one go and decodes it with a single-pass TaskParser, so loading is
+ *       linear in the store size.
+ * @note Replays the journal, if present, over the loaded snapshot.
+ * @note Binary stores are mapped instead of parsed; see StoreFormat::BINARY.
+ * @note With lazy loading enabled (and no journal to replay), JSON stores are only indexed.
+ * @note Previously loaded tasks are dropped and the arena holding them is released in one go.
+ * @note Runs under the shared store lock and records the store version for saveTasksToStore().
+ * @throws std::runtime_error If the store or journal is malformed.
  */
 void TaskManager::loadTasksFromStore() {
-  std::ifstream file(storeName);
-  if(!file){
-    std::ofstream newFile(storeName);
-    newFile << "[{\"id\":1,\"description\":\"Created Store\",\"status\":\"todo\",\"createdAt\":0,\"updatedAt\":0}]";
-    newFile.close();
-    file.open(storeName);
+  TASK_STATS_SCOPE("load");
+  prepareStore();
+  StoreLock::Scope scope(storeLock, StoreLock::Mode::SHARED);
+  loadedVersion = storeLock.version();
+  indexVersion = loadedVersion;
+  pendingChanges.clear();
+  remappedIds.clear();
+  patchedIds.clear();
+  appendedIds.clear();
+  journal.discardPending();
+
+  tableValid = false;
+  secondaryIndex.clear();
+  textIndex.close();
+  tasks.clear();
+  arena.release();
+
+  if(BinaryStore::isBinaryStore(storeName)) {
+    TASK_STATS_SCOPE("map");
+    storeFormat = StoreFormat::BINARY;
+    binaryStore.open(storeName);
+    materialized = false;
+    return;
   }
 
-  std::string json, line;
-  while(std::getline(file, line)) {
-    json += line;
+  if(lazyLoading && !isJournaling() && journal.size() == 0) {
+    TASK_STATS_SCOPE("index");
+    index.open(storeName, loadedVersion);
+    materialized = false;
+    return;
   }
-  file.close();
 
-  size_t pos = 0;
-  while((pos = json.find("{")) != std::string::npos){
-    size_t endPos = json.find("}", pos);
-    if(endPos == std::string::npos) break;
-    std::string taskStr = json.substr(pos + 1, endPos - pos -1);
-    json.erase(0, endPos + 1);
+  readStore(tasks);
+  TASK_STATS_SCOPE("replay");
+  journal.replay(tasks);
+}
 
-    int id;
-    std::string description, statusStr;
-    std::time_t createdAt, updatedAt;
+/**
+ * @brief Parses the whole JSON store into the given map.
+ * @param into The map receiving the tasks; existing entries are kept.
+ * @throws std::runtime_error If the store contains malformed JSON.
+ * @note Reads the file in one go and decodes it with a single-pass TaskParser. Tasks are decoded
+ *       straight into the map's memory resource, so moving them into the map copies nothing.
+ * @note Stores of at least PARALLEL_LOAD_THRESHOLD bytes are parsed on several threads; see
+ *       readStoreParallel().
+ */
+void TaskManager::readStore(TaskMap& into) const {
+  std::error_code ec;
+  std::uintmax_t size = std::filesystem::file_size(storeName, ec);
+  std::size_t threads = loadThreads != 0 ? loadThreads : std::max(1u, std::thread::hardware_concurrency());
+  if(!ec && size >= PARALLEL_LOAD_THRESHOLD) {
+    threads = static_cast<std::size_t>(std::min<std::uintmax_t>(threads, size / PARALLEL_LOAD_CHUNK));
+    if(threads > 1) {
+      readStoreParallel(into, threads);
+      return;
+    }
+  }
+
+  std::string json;
+  {
+    TASK_STATS_SCOPE("read");
+    std::ifstream file(storeName, std::ios::binary);
+    file.seekg(0, std::ios::end);
+    json.resize(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0, std::ios::beg);
+    file.read(json.data(), static_cast<std::streamsize>(json.size()));
+    file.close();
+    TASK_STATS_ADD("bytes read", json.size());
+  }
+
+  TASK_STATS_SCOPE("parse");
+  TaskParser parser(json);
+  Task::allocator_type allocator(into.get_allocator().resource());
+  std::size_t parsed = 0;
+  while(auto task = parser.next(allocator)) {
+    int id = task->getId();
+    into.emplace(id, std::move(*task));
+    ++parsed;
+  }
+  TASK_STATS_ADD("tasks parsed", parsed);
+}
+
+/**
+ * @brief Parses a large JSON store on several threads into the given map.
+ * @param into The map receiving the tasks; existing entries are kept.
+ * @param threads The number of threads to parse with, including the calling one.
+ * @throws std::runtime_error If the store contains malformed JSON.
+ * @note The store is mapped and cut into runs of whole task objects by TaskParser::split().
+ *       Each worker parses one run into its own vector and memory resource, so workers share
+ *       nothing. The calling thread parses the first run straight into the map's arena, then
+ *       merges the other runs in file order as they finish; the map ends up exactly as the
+ *       sequential parser leaves it, including which of two duplicate ids wins.
+ * @note Falls back to the sequential parser if the store does not split, which also reports any
+ *       malformed JSON with its exact offset.
+ */
+void TaskManager::readStoreParallel(TaskMap& into, std::size_t threads) const {
+  MappedFile file;
+  std::vector<std::string_view> runs;
+  {
+    TASK_STATS_SCOPE("read");
+    file = MappedFile(storeName, MappedFile::Access::READ_ONLY);
+    TASK_STATS_ADD("bytes read", file.size());
+  }
+  std::string_view json(file.data(), file.size());
+  {
+    TASK_STATS_SCOPE("split");
+    runs = TaskParser::split(json, threads);
+  }
 
-    std::istringstream ss(taskStr);
-    std::string token;
-    while (std::getline(ss, token, ',')) {
-      size_t colonPos = token.find(":");
-      std::string key = token.substr(1, colonPos - 2);
-      std::string value = token.substr(colonPos + 1);
-      value.erase(0, value.find_first_not_of(" "));
-      value.erase(value.find_last_not_of(" ") + 1);
+  TASK_STATS_SCOPE("parse");
+  Task::allocator_type allocator(into.get_allocator().resource());
+  std::size_t parsed = 0;
+  if(runs.size() < 2) {
+    TaskParser parser(json);
+    while(auto task = parser.next(allocator)) {
+      int id = task->getId();
+      into.emplace(id, std::move(*task));
+      ++parsed;
+    }
+    TASK_STATS_ADD("tasks parsed", parsed);
+    return;
+  }
 
-      if (key == "id") id = std::stoi(value);
-      else if (key == "description") description = value.substr(1, value.size() - 2);
-      else if (key == "status") statusStr = value.substr(1, value.size() - 2);
-      else if (key == "createdAt") createdAt = std::stoll(value);
-      else if (key == "updatedAt") updatedAt = std::stoll(value);
+  // Declared before the workers so they outlive them, even when the calling thread throws, and
+  // the resources before the tasks allocated from them
+  std::vector<std::unique_ptr<std::pmr::monotonic_buffer_resource>> resources;
+  std::vector<std::vector<Task>> results(runs.size());
+  std::vector<std::exception_ptr> errors(runs.size());
+  std::vector<std::jthread> workers;
+  workers.reserve(runs.size() - 1);
+  for(std::size_t i = 1; i < runs.size(); ++i) {
+    resources.push_back(std::make_unique<std::pmr::monotonic_buffer_resource>(runs[i].size()));
+    workers.emplace_back([&, i, resource = resources.back().get()] {
+      try {
+        TaskParser::parseRun(runs[i], i + 1 == runs.size(), results[i], Task::allocator_type(resource));
+      } catch(...) {
+        errors[i] = std::current_exception();
+      }
+    });
+  }
+
+  // Moving a task into the map copies its description into the arena unless it is already there
+  TaskParser::parseRun(runs[0], false, results[0], allocator);
+  for(std::size_t i = 0; i < runs.size(); ++i) {
+    if(i > 0) workers[i - 1].join();
+    if(errors[i]) std::rethrow_exception(errors[i]);
+    for(Task& task : results[i]) {
+      int id = task.getId();
+      into.emplace_hint(into.end(), id, std::move(task));
     }
-    tasks.emplace(id, Task(id, description, TaskUtils::keyToStatus(statusStr), createdAt, updatedAt));
+    parsed += results[i].size();
+    results[i] = {};
   }
+  TASK_STATS_ADD("tasks parsed", parsed);
 }
 
 /**
  * @brief Finds a task by its ID.
  * @param id The ID of the task to find.
  * @return An optional reference to the Task if found, or std::nullopt if not.
+ * @note Changes made through the returned reference are not journaled; use
+ *       updateDescription() and setStatus() to mutate tasks.
  */
 std::optional<std::reference_wrapper<Task>> TaskManager::findTaskById(int id) {
+  materializeTasks();
   if (auto it = tasks.find(id); it != tasks.end()) {
     return it->second;
   }
   return std::nullopt;
 }
 
+/**
+ * @brief Finds a task by its ID without materializing it.
+ * @param id The ID of the task to find.
+ * @return A view of the task if found, or std::nullopt if not.
+ * @note The view is invalidated by any mutation of the manager.
+ */
+std::optional<TaskView> TaskManager::findTaskView(int id) const {
+  if(!materialized && storeFormat == StoreFormat::BINARY) {
+    if(auto it = tasks.find(id); it != tasks.end()) return TaskView(it->second);
+    return binaryStore.find(id);
+  }
+  if(!materialized) {
+    if(Task* task = loadLazyTask(id)) return TaskView(*task);
+    return std::nullopt;
+  }
+  if(auto it = tasks.find(id); it != tasks.end()) {
+    return TaskView(it->second);
+  }
+  return std::nullopt;
+}
+
+/**
+ * @brief Visits every task in ascending ID order.
+ * @param visit Called with a view of each task.
+ * @note Binary stores are read in place; no Task objects are built. Tasks changed since load
+ *       are visited as cached in the tasks map, which is walked alongside the records.
+ */
+void TaskManager::forEachTask(const std::function<void(const TaskView&)>& visit) const {
+  if(!materialized && storeFormat == StoreFormat::BINARY) {
+    auto cached = tasks.begin();
+    for(std::size_t i = 0; i < binaryStore.size(); ++i) {
+      TaskView view = binaryStore.at(i);
+      while(cached != tasks.end() && cached->first < view.getId()) ++cached;
+      visit(cached != tasks.end() && cached->first == view.getId() ? TaskView(cached->second) : view);
+    }
+    return;
+  }
+  materializeTasks();
+  for(const auto& [id, task] : tasks) {
+    visit(TaskView(task));
+  }
+}
+
+/**
+ * @brief Gets the ID that the next added task should use.
+ * @return One past the highest existing ID, or 1 if there are no tasks.
+ */
+int TaskManager::nextId() const {
+  if(!materialized && storeFormat == StoreFormat::BINARY) {
+    return binaryStore.size() == 0 ? 1 : binaryStore.at(binaryStore.size() - 1).getId() + 1;
+  }
+  if(!materialized) {
+    return std::max(index.maxId(), tasks.empty() ? 0 : tasks.rbegin()->first) + 1;
+  }
+  return tasks.empty() ? 1 : tasks.rbegin()->first + 1;
+}
+
 /**
  * @brief Adds a task to the manager.
  * @param task The Task object to add.
- * @note If a task with the same ID already exists, it will be overwritten.
+ * @note If a task with the same ID already exists, the existing task is kept.
  */
 void TaskManager::addTask(const Task& task) {
-  tasks.emplace(task.getId(), task);
+  int id = task.getId();
+  if(!prepareInsert(id)) return;
+
+  if(tasks.emplace(id, task).second) {
+    recordChange("add", id);
+  }
+}
+
+/**
+ * @brief Adds a task to the manager, moving it into the tasks map.
+ * @param task The Task object to add.
+ * @note If a task with the same ID already exists, the existing task is kept.
+ */
+void TaskManager::addTask(Task&& task) {
+  int id = task.getId();
+  if(!prepareInsert(id)) return;
+
+  if(tasks.emplace(id, std::move(task)).second) {
+    recordChange("add", id);
+  }
+}
+
+/**
+ * @brief Constructs a task directly inside the tasks map.
+ * @param id The unique identifier for the task.
+ * @param description A brief description of the task.
+ * @param status The initial status of the task.
+ * @param createdAt The creation timestamp of the task.
+ * @param updatedAt The last updated timestamp of the task.
+ * @return A view of the added task, or std::nullopt if a task with the same ID already exists.
+ * @note The description is copied once, straight into the tasks arena; no temporary Task is built.
+ */
+std::optional<TaskView> TaskManager::emplaceTask(int id, std::string_view description, TaskStatus status,
+                                                 std::time_t createdAt, std::time_t updatedAt) {
+  if(!prepareInsert(id)) return std::nullopt;
+
+  auto [it, inserted] = tasks.try_emplace(id, id, description, status, createdAt, updatedAt);
+  if(!inserted) return std::nullopt;
+  recordChange("add", id);
+  return TaskView(it->second);
+}
+
+/**
+ * @brief Replaces the description of a task.
+ * @param id The ID of the task to update.
+ * @param description The new description.
+ * @param updatedAt The new last updated timestamp.
+ * @return True if the task exists and was updated.
+ */
+bool TaskManager::updateDescription(int id, std::string_view description, std::time_t updatedAt) {
+  Task* task = mutableTask(id);
+  if(!task) return false;
+
+  SecondaryIndex::Key previous{task->getStatus(), task->getUpdatedAt()};
+  task->setDescription(description);
+  task->setUpdatedAt(updatedAt);
+  recordChange("update", id, previous);
+  return true;
+}
+
+/**
+ * @brief Changes the status of a task.
+ * @param id The ID of the task to update.
+ * @param status The new status.
+ * @param updatedAt The new last updated timestamp.
+ * @return True if the task exists and was updated.
+ * @note Mapped binary stores are not materialized: the changed task is cached in the tasks map
+ *       and patched into the mapping by the next save, under the exclusive store lock.
+ */
+bool TaskManager::setStatus(int id, TaskStatus status, std::time_t updatedAt) {
+  Task* task = !materialized && storeFormat == StoreFormat::BINARY ? cachedBinaryTask(id) : mutableTask(id);
+  if(!task) return false;
+
+  SecondaryIndex::Key previous{task->getStatus(), task->getUpdatedAt()};
+  task->setStatus(status);
+  task->setUpdatedAt(updatedAt);
+  recordChange("status", id, previous);
+  return true;
 }
 
 /**
@@ -110,13 +738,468 @@ void TaskManager::addTask(const Task& task) {
  * @note No effect if the ID does not exist in the tasks map.
  */
 void TaskManager::removeTask(int id) {
-  tasks.erase(id);
+  materializeTasks();
+  auto it = tasks.find(id);
+  if(it == tasks.end()) return;
+
+  SecondaryIndex::Key previous{it->second.getStatus(), it->second.getUpdatedAt()};
+  tasks.erase(it);
+  recordChange("delete", id, previous);
+}
+
+/**
+ * @brief Soft-deletes a task by turning it into a tombstone with TaskStatus::DELETED.
+ * @param id The ID of the task to delete.
+ * @param deletedAt The new last updated timestamp.
+ * @return True if the task exists and was not already deleted.
+ * @note Saved like any status change: appended to the journal, patched into a binary store, or
+ *       patched into a lazily loaded JSON store when the tombstone fits the task's slot.
+ */
+bool TaskManager::deleteTask(int id, std::time_t deletedAt) {
+  auto task = findTaskView(id);
+  if(!task || task->getStatus() == TaskStatus::DELETED) return false;
+  return setStatus(id, TaskStatus::DELETED, deletedAt);
+}
+
+/**
+ * @brief Brings a soft-deleted task back.
+ * @param id The ID of the deleted task.
+ * @param status The status to restore it with.
+ * @param restoredAt The new last updated timestamp.
+ * @return True if the task exists and was deleted.
+ */
+bool TaskManager::restoreTask(int id, TaskStatus status, std::time_t restoredAt) {
+  auto task = findTaskView(id);
+  if(!task || task->getStatus() != TaskStatus::DELETED) return false;
+  return setStatus(id, status, restoredAt);
+}
+
+/**
+ * @brief Removes every soft-deleted task for good.
+ * @return The number of tasks removed.
+ * @note Materializes the tasks; follow with compactStore() to reclaim the space in the store.
+ */
+std::size_t TaskManager::purgeDeletedTasks() {
+  materializeTasks();
+  std::vector<int> deleted;
+  for(const auto& [id, task] : tasks) {
+    if(task.getStatus() == TaskStatus::DELETED) deleted.push_back(id);
+  }
+  for(int id : deleted) removeTask(id);
+  return deleted.size();
 }
 
 /**
  * @brief Gets the collection of all tasks.
  * @return A const reference to the tasks map.
+ * @note Materializes binary stores; prefer forEachTask() for read-only iteration.
  */
-const std::map<int, Task>& TaskManager::getTasks() const {
+const TaskMap& TaskManager::getTasks() const {
+  materializeTasks();
   return tasks;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Gets the columnar table of all tasks, building it on first use.
+ * @return A const reference to the task table.
+ * @note Once built, the table is kept up to date by every mutation.
+ */
+const TaskTable& TaskManager::getTable() const {
+  if(!tableValid) {
+    table.clear();
+    forEachTask([this](const TaskView& task) { table.append(task); });
+    tableValid = true;
+  }
+  return table;
+}
+
+/**
+ * @brief Finds tasks by status and update time through the secondary indexes.
+ * @param query The filter, order and page.
+ * @return Views of the matching tasks in the requested order, at most query.limit of them.
+ * @note Builds the indexes on first use (materializing the tasks); every later mutation keeps
+ *       them up to date, so queries stay O(log n + offset + k) for k results from any cursor.
+ * @note The views are invalidated by any mutation of the manager.
+ */
+std::vector<TaskView> TaskManager::queryTasks(const TaskQuery& query) const {
+  materializeTasks();
+  std::vector<TaskView> views;
+  const TaskFilter& filter = query.filter;
+  if(!filter.status && !filter.updatedFrom && !filter.updatedUntil && query.order == TaskOrder::ID) {
+    // The tasks map is already the ID index; tombstones are skipped as they are met
+    auto it = query.after ? tasks.upper_bound(query.after->id) : tasks.begin();
+    for(std::size_t skipped = 0; it != tasks.end() && views.size() < query.limit; ++it) {
+      if(it->second.getStatus() == TaskStatus::DELETED) continue;
+      if(skipped < query.offset) ++skipped;
+      else views.emplace_back(it->second);
+    }
+    return views;
+  }
+
+  for(const Task* task : secondaryIndex.query(query, tasks)) views.emplace_back(*task);
+  return views;
+}
+
+/**
+ * @brief Finds tasks whose descriptions match a full-text query.
+ * @param query The query; see TextIndex::search().
+ * @return Views of the matching tasks in ascending ID order.
+ * @throws std::runtime_error If the text index cannot be written.
+ * @note Builds the persisted text index if it is missing or stale; otherwise only the matching
+ *       tasks are decoded. An index built over unsaved changes is written by the next save.
+ * @note Lazily loaded stores decode matches one by one, unless they are a large share of the
+ *       store, when parsing it in one go is cheaper.
+ * @note The views are invalidated by any mutation of the manager.
+ */
+std::vector<TaskView> TaskManager::searchTasks(std::string_view query) const {
+  if(!textIndex.isOpen()) {
+    TASK_STATS_SCOPE("text index");
+    StoreLock::Scope scope(storeLock, StoreLock::Mode::SHARED);
+    bool current = storeLock.version() == loadedVersion;
+    if(current && textIndex.open(storeName, loadedVersion)) {
+      for(const PendingChange& change : pendingChanges) applyTextChange(change.op, change.id);
+    } else {
+      std::vector<std::pair<int, std::string_view>> documents;
+      forEachTask([&](const TaskView& task) { documents.emplace_back(task.getId(), task.getDescription()); });
+      textIndex.build(storeName, documents);
+      if(current && pendingChanges.empty()) textIndex.commit(loadedVersion);
+    }
+  }
+
+  std::vector<int> ids = textIndex.search(query);
+  if(!materialized && storeFormat == StoreFormat::JSON && ids.size() > index.size() / 16) materializeTasks();
+  std::vector<TaskView> views;
+  views.reserve(ids.size());
+  for(int id : ids) {
+    if(auto view = findTaskView(id)) views.push_back(*view);
+  }
+  return views;
+}
+
+ArenaStats TaskManager::getArenaStats() const { return arena.stats(); }
+
+bool TaskManager::isJournaling() const {
+  return storeMode == StoreMode::JOURNAL && storeFormat == StoreFormat::JSON;
+}
+
+/**
+ * @brief Prepares the tasks map for inserting a task.
+ * @param id The ID of the task about to be inserted.
+ * @return False if a task with that ID already exists in a lazily loaded store.
+ * @note Lazily loaded JSON stores are checked against the index; other stores are materialized.
+ */
+bool TaskManager::prepareInsert(int id) {
+  if(!materialized && storeFormat == StoreFormat::JSON) return !index.find(id);
+
+  materializeTasks();
+  return true;
+}
+
+/**
+ * @brief Gets a modifiable task for a mutation.
+ * @param id The ID of the task.
+ * @return A pointer to the task, or nullptr if it does not exist.
+ * @note Lazily loaded JSON stores only decode the requested task; binary stores are materialized.
+ */
+Task* TaskManager::mutableTask(int id) {
+  if(!materialized && storeFormat == StoreFormat::JSON) return loadLazyTask(id);
+
+  materializeTasks();
+  auto it = tasks.find(id);
+  return it == tasks.end() ? nullptr : &it->second;
+}
+
+/**
+ * @brief Copies a task of a mapped binary store into the tasks map, so it can be changed before a save.
+ * @param id The ID of the task.
+ * @return A pointer to the cached task, or nullptr if it does not exist.
+ * @note The mapping itself is only patched by writeChanges(), under the exclusive store lock.
+ */
+Task* TaskManager::cachedBinaryTask(int id) {
+  if(auto it = tasks.find(id); it != tasks.end()) return &it->second;
+  auto view = binaryStore.find(id);
+  if(!view) return nullptr;
+  return &tasks.emplace(id, view->toTask(Task::allocator_type(tasks.get_allocator().resource()))).first->second;
+}
+
+/**
+ * @brief Propagates a completed mutation to the pending changes, the journal, the lazy write-back lists,
+ *        the table, the secondary indexes and the text index.
+ * @param op The operation ("add", "update", "status" or "delete").
+ * @param id The ID of the mutated task.
+ * @param previous The status and updatedAt of the task before the mutation, if it existed.
+ */
+void TaskManager::recordChange(std::string_view op, int id, std::optional<SecondaryIndex::Key> previous) {
+  pendingChanges.push_back({op, id});
+
+  if(!materialized) {
+    (op == "add" ? appendedIds : patchedIds).push_back(id);
+  }
+
+  if(isJournaling()) {
+    if(op == "delete") journal.recordDelete(id);
+    else journal.recordPut(op, tasks.at(id));
+  }
+
+  if(tableValid) {
+    if(auto task = findTaskView(id)) table.upsert(*task);
+    else table.erase(id);
+  }
+
+  if(secondaryIndex.isBuilt()) {
+    if(previous) secondaryIndex.erase(id, *previous);
+    if(op != "delete") secondaryIndex.insert(tasks.at(id));
+  }
+
+  if(textIndex.isOpen()) applyTextChange(op, id);
+}
+
+/**
+ * @brief Applies a mutation to the open text index.
+ * @param op The operation ("add", "update", "status" or "delete").
+ * @param id The ID of the mutated task.
+ * @note Status changes leave the description alone and are skipped. Other operations index the
+ *       task's current description, or remove it if it no longer exists, so applying the same
+ *       change twice is harmless.
+ */
+void TaskManager::applyTextChange(std::string_view op, int id) const {
+  if(op == "status") return;
+  if(auto task = findTaskView(id)) textIndex.put(id, task->getDescription());
+  else textIndex.remove(id);
+}
+
+/**
+ * @brief Opens the store's text index before a save, so the save keeps it up to date.
+ * @note Requires the exclusive store lock. No effect if the store has no text index, or if it
+ *       is stale and left for the next search to rebuild.
+ * @note Runs before the store is written, while the index stamp can still match it. Pending
+ *       changes made before the index was opened are applied to it here.
+ */
+void TaskManager::openTextIndex() {
+  if(textIndex.isOpen() || !TextIndex::exists(storeName)) return;
+  if(!textIndex.open(storeName, storeLock.version())) return;
+  for(const PendingChange& change : pendingChanges) applyTextChange(change.op, resolveId(change.id));
+}
+
+/**
+ * @brief Decodes a single task of a lazily loaded store, caching it in the tasks map.
+ * @param id The ID of the task to load.
+ * @return A pointer to the cached task, or nullptr if it does not exist.
+ * @note Reads only the bytes of the task's JSON object, located through the index.
+ * @note Reads under the shared store lock, revalidating the index if another process saved since
+ *       it was opened.
+ */
+Task* TaskManager::loadLazyTask(int id) const {
+  if(auto it = tasks.find(id); it != tasks.end()) return &it->second;
+
+  StoreLock::Scope scope(storeLock, StoreLock::Mode::SHARED);
+  if(storeLock.version() != indexVersion) {
+    indexVersion = storeLock.version();
+    index.open(storeName, indexVersion);
+  }
+  auto entry = index.find(id);
+  if(!entry) return nullptr;
+
+  std::ifstream file(storeName, std::ios::binary);
+  std::string json(entry->length, '\0');
+  TASK_STATS_ADD("bytes read", json.size());
+  file.seekg(static_cast<std::streamoff>(entry->offset));
+  if(!file.read(json.data(), static_cast<std::streamsize>(json.size()))) {
+    throw std::runtime_error("Failed to read task " + std::to_string(id) + " from store: " + storeName);
+  }
+
+  JsonReader reader(json);
+  std::string key, text;
+  Task task = TaskParser::parseObject(reader, key, text, Task::allocator_type(tasks.get_allocator().resource()));
+  if(task.getId() != id) {
+    throw std::runtime_error("Stale index for store: " + storeName);
+  }
+  return &tasks.emplace(id, std::move(task)).first->second;
+}
+
+/**
+ * @brief Writes lazily made changes back into the JSON store in place.
+ * @return True if every change was written, false if a patched task no longer fits its slot.
+ * @throws std::runtime_error If the store or index cannot be written.
+ * @note Patched objects are padded with spaces before their closing brace to their original
+ *       length, so every other offset stays valid and a rebuilt index keeps the same lengths.
+ *       An object that grew, such as a "todo" task turned into a "deleted" tombstone, does not
+ *       fit, and the caller falls back to a full snapshot. Added tasks overwrite the closing ']'
+ *       and re-append it.
+ * @note Patches are written in place rather than through an AtomicFile. The bytes they overwrite
+ *       and the old store size are first saved to an undo record (<store>.undo) through an
+ *       AtomicFile, and the record is removed once the patched store is flushed according to the
+ *       durability. A crash in between leaves the record, and rollBackInterruptedPatch() restores
+ *       the store as it was before the save.
+ */
+bool TaskManager::persistLazyChanges() {
+  std::vector<std::pair<std::uint64_t, std::string>> writes;
+  for(int id : patchedIds) {
+    auto entry = index.find(id);
+    if(!entry) continue; // added in this session; written with the appended tasks
+
+    TaskSerializer record;
+    record.appendTask(TaskView(tasks.at(id)));
+    std::string json = record.take();
+    if(json.size() > entry->length) return false;
+    json.insert(json.size() - 1, entry->length - json.size(), ' ');
+    writes.emplace_back(entry->offset, std::move(json));
+  }
+
+  std::fstream file(storeName, std::ios::binary | std::ios::in | std::ios::out);
+  if(!file){
+    throw std::runtime_error("Failed to open store file: " + storeName);
+  }
+  file.seekg(0, std::ios::end);
+  const std::uint64_t size = static_cast<std::uint64_t>(file.tellg());
+
+  if(!appendedIds.empty()) {
+    std::string tail(std::min<std::uint64_t>(size, 64), '\0');
+    file.seekg(static_cast<std::streamoff>(size - tail.size()));
+    file.read(tail.data(), static_cast<std::streamsize>(tail.size()));
+    std::size_t bracket = tail.rfind(']');
+    if(bracket == std::string::npos) return false;
+
+    std::uint64_t closeOffset = size - tail.size() + bracket;
+    TaskSerializer appended;
+    std::sort(appendedIds.begin(), appendedIds.end());
+    for(int id : appendedIds) {
+      if(index.size() > 0) appended.appendRaw(", ");
+      std::uint64_t offset = closeOffset + appended.size();
+      appended.appendTask(TaskView(tasks.at(id)));
+      index.append({id, static_cast<std::uint32_t>(closeOffset + appended.size() - offset), offset});
+    }
+    appended.appendRaw("]");
+    writes.emplace_back(closeOffset, appended.take());
+  }
+
+  // The undo record: the old store size, then the offset, length and old bytes of every region
+  std::string undo;
+  auto appendNumber = [&undo](std::uint64_t value) { undo.append(reinterpret_cast<const char*>(&value), sizeof(value)); };
+  appendNumber(size);
+  for(const auto& [offset, bytes] : writes) {
+    std::uint64_t length = std::min<std::uint64_t>(bytes.size(), size - offset);
+    appendNumber(offset);
+    appendNumber(length);
+    std::size_t start = undo.size();
+    undo.resize(start + length);
+    file.seekg(static_cast<std::streamoff>(offset));
+    file.read(undo.data() + start, static_cast<std::streamsize>(length));
+  }
+  if(!file){
+    throw std::runtime_error("Failed to read store file: " + storeName);
+  }
+  AtomicFile undoFile(storeName + ".undo", durability);
+  undoFile.write(undo);
+  undoFile.commit();
+
+  for(const auto& [offset, bytes] : writes) {
+    file.seekp(static_cast<std::streamoff>(offset));
+    file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    TASK_STATS_ADD("bytes written", bytes.size());
+  }
+  file.close();
+  if(!file){
+    throw std::runtime_error("Failed to write store file: " + storeName);
+  }
+  AtomicFile::sync(storeName, durability);
+  AtomicFile::remove(storeName + ".undo", durability);
+
+  index.commit(loadedVersion);
+  patchedIds.clear();
+  appendedIds.clear();
+  return true;
+}
+
+/**
+ * @brief Restores the JSON store from the undo record of an in-place patch interrupted by a crash.
+ * @throws std::runtime_error If the undo record is malformed or the store cannot be written.
+ * @note Requires the exclusive store lock. No effect if there is no undo record.
+ * @note The record is only renamed into place once complete, and removed once the patch is
+ *       flushed, so finding one means the store may hold part of a patch. Writing the old bytes
+ *       back and cutting the store to its old size undoes it; the index and text index are
+ *       stamped with the store's size and modification time, so they are rebuilt afterwards.
+ */
+void TaskManager::rollBackInterruptedPatch() {
+  const std::string undoPath = storeName + ".undo";
+  if(!std::filesystem::exists(undoPath)) return;
+
+  std::ifstream in(undoPath, std::ios::binary);
+  std::string undo((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  in.close();
+  std::size_t at = 0;
+  auto readNumber = [&](std::uint64_t& value) {
+    if(undo.size() - at < sizeof(value)) return false;
+    std::memcpy(&value, undo.data() + at, sizeof(value));
+    at += sizeof(value);
+    return true;
+  };
+
+  std::uint64_t size = 0;
+  if(!readNumber(size)) {
+    throw std::runtime_error("Malformed undo record: " + undoPath);
+  }
+  std::fstream file(storeName, std::ios::binary | std::ios::in | std::ios::out);
+  if(!file){
+    throw std::runtime_error("Failed to open store file: " + storeName);
+  }
+  while(at < undo.size()) {
+    std::uint64_t offset = 0, length = 0;
+    if(!readNumber(offset) || !readNumber(length) || length > undo.size() - at || offset > size || length > size - offset) {
+      throw std::runtime_error("Malformed undo record: " + undoPath);
+    }
+    file.seekp(static_cast<std::streamoff>(offset));
+    file.write(undo.data() + at, static_cast<std::streamsize>(length));
+    at += length;
+  }
+  file.close();
+  if(!file){
+    throw std::runtime_error("Failed to write store file: " + storeName);
+  }
+  std::filesystem::resize_file(storeName, size);
+  AtomicFile::sync(storeName, durability);
+  AtomicFile::remove(undoPath, durability);
+}
+
+/**
+ * @brief Makes the store ready to load: rolls back an interrupted patch and creates a missing store.
+ * @throws std::runtime_error If the store cannot be written.
+ * @note Both are checked again under the exclusive store lock, so concurrent processes neither
+ *       race to create the store nor roll back the same patch twice. The default store is
+ *       written through an AtomicFile with the configured durability, like every other store.
+ */
+void TaskManager::prepareStore() {
+  if(std::filesystem::exists(storeName) && !std::filesystem::exists(storeName + ".undo")) return;
+
+  StoreLock::Scope scope(storeLock, StoreLock::Mode::EXCLUSIVE);
+  rollBackInterruptedPatch();
+  if(std::filesystem::exists(storeName)) return;
+
+  TaskSerializer serializer;
+  serializer.appendRaw("[");
+  serializer.appendTask(TaskView(1, "Created Store", TaskStatus::TODO, 0, 0));
+  serializer.appendRaw("]");
+  AtomicFile file(storeName, durability);
+  file.write(serializer.view());
+  file.commit();
+}
+
+/**
+ * @brief Loads every task of a mapped binary or lazily loaded JSON store into the tasks map.
+ * @note No effect if the tasks are already materialized. Tasks changed since load are already
+ *       cached in the map, for binary and lazily loaded JSON stores alike, and are kept over the
+ *       stored versions, so their pending changes carry over.
+ */
+void TaskManager::materializeTasks() const {
+  if(materialized) return;
+
+  if(storeFormat == StoreFormat::BINARY) {
+    for(std::size_t i = 0; i < binaryStore.size(); ++i) {
+      TaskView view = binaryStore.at(i);
+      tasks.emplace_hint(tasks.end(), view.getId(), view.toTask(Task::allocator_type(tasks.get_allocator().resource())));
+    }
+  } else {
+    readStore(tasks);
+  }
+  materialized = true;
+}
@@ -0,0 +1,207 @@
+#include "core/TaskParser.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+/**
+ * @brief Constructs a parser over the given JSON array.
+ * @param json The store contents; must outlive the parser.
+ */
+TaskParser::TaskParser(std::string_view json) : reader(json) {}
+
+/**
+ * @brief Parses the next task in the array.
+ * @param allocator The allocator the task's description is stored with.
+ * @return The parsed Task, or std::nullopt once the array is exhausted.
+ * @throws std::runtime_error If the JSON is malformed or a task has no id.
+ * @note An empty (or whitespace-only) input is treated as an empty store.
+ */
+std::optional<Task> TaskParser::next(const Task::allocator_type& allocator) {
+  if(!advance()) return std::nullopt;
+
+  objectOffset = reader.position();
+  Task task = parseObject(reader, key, text, allocator);
+  objectLength = reader.position() - objectOffset;
+  return task;
+}
+
+/**
+ * @brief Scans the next task in the array, decoding only its id.
+ * @return The task id, or std::nullopt once the array is exhausted.
+ * @throws std::runtime_error If the JSON is malformed or a task has no id.
+ * @note Descriptions are skipped without being unescaped, which makes this much cheaper than next().
+ */
+std::optional<int> TaskParser::scanNext() {
+  if(!advance()) return std::nullopt;
+
+  objectOffset = reader.position();
+  std::optional<int> id;
+  reader.expect('{');
+  if(!reader.consume('}')) {
+    do {
+      reader.readString(key);
+      reader.expect(':');
+      if(key == "id") id = static_cast<int>(reader.readInteger());
+      else reader.skipValue();
+    } while(reader.consume(','));
+    reader.expect('}');
+  }
+  objectLength = reader.position() - objectOffset;
+
+  if(!id) {
+    throw std::runtime_error("Malformed task at offset " + std::to_string(objectOffset) + ": missing id");
+  }
+  return id;
+}
+
+std::size_t TaskParser::lastObjectOffset() const { return objectOffset; }
+
+std::size_t TaskParser::lastObjectLength() const { return objectLength; }
+
+bool TaskParser::advance() {
+  if(finished) return false;
+
+  if(!started) {
+    started = true;
+    if(reader.atEnd()) {
+      finished = true;
+      return false;
+    }
+    reader.expect('[');
+    if(reader.consume(']')) {
+      finished = true;
+      return false;
+    }
+  } else if(!reader.consume(',')) {
+    reader.expect(']');
+    finished = true;
+    return false;
+  }
+
+  reader.peek(); // skip whitespace so the object offset points at its '{'
+  return true;
+}
+
+/**
+ * @brief Parses a single task object at the reader's position.
+ * @param reader The reader positioned at a '{'.
+ * @param key Scratch buffer used for object keys.
+ * @param text Scratch buffer used for string values.
+ * @param allocator The allocator the task's description is stored with.
+ * @return The parsed Task.
+ * @throws std::runtime_error If the object is malformed or has no id.
+ * @note Missing timestamps default to 0 and a missing status decodes as TaskStatus::UNKNOWN.
+ * @note The description is unescaped into the reusable scratch buffer and copied once, straight
+ *       into storage from the given allocator; no per-task temporaries are allocated.
+ */
+Task TaskParser::parseObject(JsonReader& reader, std::string& key, std::string& text,
+                             const Task::allocator_type& allocator) {
+  std::optional<int> id;
+  TaskStatus status = TaskStatus::UNKNOWN;
+  std::time_t createdAt = 0, updatedAt = 0;
+
+  text.clear();
+  reader.expect('{');
+  if(!reader.consume('}')) {
+    do {
+      reader.readString(key);
+      reader.expect(':');
+      if(key == "id") id = static_cast<int>(reader.readInteger());
+      else if(key == "description") reader.readString(text);
+      else if(key == "status") {
+        reader.readString(key);
+        status = TaskUtils::keyToStatus(key);
+      }
+      else if(key == "createdAt") createdAt = static_cast<std::time_t>(reader.readInteger());
+      else if(key == "updatedAt") updatedAt = static_cast<std::time_t>(reader.readInteger());
+      else reader.skipValue();
+    } while(reader.consume(','));
+    reader.expect('}');
+  }
+
+  if(!id) {
+    throw std::runtime_error("Malformed task at offset " + std::to_string(reader.position()) + ": missing id");
+  }
+  return Task(*id, text, status, createdAt, updatedAt, allocator);
+}
+
+/**
+ * @brief Splits a JSON array of task objects into runs of whole objects.
+ * @param json The store contents.
+ * @param parts The number of runs wanted.
+ * @return At most `parts` runs of about equal size, in array order, or an empty vector if the
+ *         input does not look like a non-empty array.
+ * @note Strings are skipped with memchr, so the pre-scan runs much faster than parsing. It does
+ *       not validate the JSON; parseRun() reports any malformed run.
+ */
+std::vector<std::string_view> TaskParser::split(std::string_view json, std::size_t parts) {
+  static constexpr std::string_view whitespace = " \t\r\n";
+  std::size_t pos = json.find_first_not_of(whitespace);
+  if(pos == std::string_view::npos || json[pos] != '[') return {};
+
+  const std::size_t step = std::max<std::size_t>(1, json.size() / std::max<std::size_t>(1, parts));
+  std::vector<std::size_t> starts;
+  std::size_t target = 0;
+  std::size_t depth = 1;
+  std::size_t end = std::string_view::npos;
+  const char* data = json.data();
+  for(++pos; pos < json.size(); ++pos) {
+    char c = data[pos];
+    if(c == '"') {
+      // Skip to the closing quote, stepping over escaped characters
+      while(true) {
+        const void* quote = std::memchr(data + pos + 1, '"', json.size() - pos - 1);
+        if(!quote) return {};
+        std::size_t close = static_cast<std::size_t>(static_cast<const char*>(quote) - data);
+        std::size_t backslashes = 0;
+        while(data[close - 1 - backslashes] == '\\') ++backslashes;
+        pos = close;
+        if(backslashes % 2 == 0) break;
+      }
+    } else if(c == '{' || c == '[') {
+      if(depth == 1 && c == '{' && pos >= target) {
+        starts.push_back(pos);
+        target = pos + step;
+      }
+      ++depth;
+    } else if(c == '}' || c == ']') {
+      if(--depth == 0) {
+        end = pos;
+        break;
+      }
+    }
+  }
+  if(end == std::string_view::npos || starts.empty()) return {};
+  if(json.find_first_not_of(whitespace, end + 1) != std::string_view::npos) return {};
+
+  std::vector<std::string_view> runs;
+  runs.reserve(starts.size());
+  for(std::size_t i = 0; i < starts.size(); ++i) {
+    std::size_t stop = i + 1 < starts.size() ? starts[i + 1] : end;
+    runs.push_back(json.substr(starts[i], stop - starts[i]));
+  }
+  return runs;
+}
+
+/**
+ * @brief Parses every task object in a run returned by split().
+ * @param run The run to parse.
+ * @param last Whether this is the last run of the array, which must not end with a comma.
+ * @param into The vector the parsed tasks are appended to, in order.
+ * @param allocator The allocator the tasks' descriptions are stored with.
+ * @throws std::runtime_error If the run is malformed or a task has no id.
+ * @note Offsets in error messages are relative to the start of the run.
+ */
+void TaskParser::parseRun(std::string_view run, bool last, std::vector<Task>& into,
+                          const Task::allocator_type& allocator) {
+  JsonReader reader(run);
+  std::string key, text;
+  while(true) {
+    into.push_back(parseObject(reader, key, text, allocator));
+    if(!reader.consume(',')) break;
+    if(!last && reader.atEnd()) return;
+  }
+  if(!last || !reader.atEnd()) {
+    throw std::runtime_error("Malformed task array at offset " + std::to_string(reader.position()) + " of a run");
+  }
+}
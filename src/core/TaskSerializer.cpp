@@ -0,0 +1,109 @@
+#include "core/TaskSerializer.h"
+#include <array>
+#include <charconv>
+
+namespace {
+
+    /**
+     * @brief Flags the characters that must be escaped inside a JSON string.
+     */
+    constexpr std::array<bool, 256> needsEscape = [] {
+      std::array<bool, 256> table{};
+      for(int c = 0; c < 0x20; ++c) table[c] = true;
+      table['"'] = true;
+      table['\\'] = true;
+      return table;
+    }();
+
+}
+
+void TaskSerializer::appendRaw(std::string_view text) { buffer += text; }
+
+/**
+ * @brief Appends a JSON string literal, escaping it as needed.
+ * @param text The unescaped string.
+ * @note Runs of characters that need no escaping are appended in bulk. Control characters
+ *       without a short escape are written as \\u00XX; UTF-8 sequences pass through unchanged.
+ */
+void TaskSerializer::appendString(std::string_view text) {
+  buffer += '"';
+  std::size_t runStart = 0;
+  for(std::size_t i = 0; i < text.size(); ++i) {
+    unsigned char c = static_cast<unsigned char>(text[i]);
+    if(!needsEscape[c]) continue;
+
+    buffer.append(text.data() + runStart, i - runStart);
+    runStart = i + 1;
+    switch(c) {
+      case '"': buffer += "\\\""; break;
+      case '\\': buffer += "\\\\"; break;
+      case '\b': buffer += "\\b"; break;
+      case '\f': buffer += "\\f"; break;
+      case '\n': buffer += "\\n"; break;
+      case '\r': buffer += "\\r"; break;
+      case '\t': buffer += "\\t"; break;
+      default: {
+        constexpr char hex[] = "0123456789abcdef";
+        char escaped[] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+        buffer.append(escaped, sizeof(escaped));
+      }
+    }
+  }
+  buffer.append(text.data() + runStart, text.size() - runStart);
+  buffer += '"';
+}
+
+/**
+ * @brief Appends a JSON integer.
+ * @param value The value to append.
+ * @note Formats in place with std::to_chars; no temporary strings are created.
+ */
+void TaskSerializer::appendInteger(long long value) {
+  char digits[24];
+  auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), value);
+  buffer.append(digits, end);
+}
+
+/**
+ * @brief Appends a task as a JSON object.
+ * @param task The task to encode.
+ * @note Produces {"id":<id>,"description":"<desc>","status":"<key>","createdAt":<time>,"updatedAt":<time>}.
+ */
+void TaskSerializer::appendTask(const TaskView& task) {
+  buffer += "{\"id\":";
+  appendInteger(task.getId());
+  buffer += ",\"description\":";
+  appendString(task.getDescription());
+  buffer += ",\"status\":\"";
+  buffer += TaskUtils::statusToKey(task.getStatus());
+  buffer += "\",\"createdAt\":";
+  appendInteger(static_cast<long long>(task.getCreatedAt()));
+  buffer += ",\"updatedAt\":";
+  appendInteger(static_cast<long long>(task.getUpdatedAt()));
+  buffer += '}';
+}
+
+void TaskSerializer::reserve(std::size_t bytes) { buffer.reserve(bytes); }
+
+std::size_t TaskSerializer::size() const { return buffer.size(); }
+
+bool TaskSerializer::empty() const { return buffer.empty(); }
+
+std::string_view TaskSerializer::view() const { return buffer; }
+
+std::string TaskSerializer::take() {
+  std::string text = std::move(buffer);
+  buffer.clear();
+  return text;
+}
+
+void TaskSerializer::clear() { buffer.clear(); }
+
+/**
+ * @brief Writes the buffered output to a stream in a single write and clears it.
+ * @param out The destination stream.
+ */
+void TaskSerializer::flush(std::ostream& out) {
+  out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  buffer.clear();
+}
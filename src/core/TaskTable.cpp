@@ -0,0 +1,361 @@
+#include "core/TaskTable.h"
+#include "core/FilterKernels.h"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+TaskView TaskTable::Chunk::row(std::size_t row) const {
+  return TaskView(ids[row], std::string_view(arena).substr(descriptionOffsets[row], descriptionLengths[row]),
+                  static_cast<TaskStatus>(statuses[row]), createdAts[row], updatedAts[row]);
+}
+
+void TaskTable::Chunk::push(const TaskView& task) {
+  ids.push_back(task.getId());
+  statuses.push_back(static_cast<std::uint8_t>(task.getStatus()));
+  if(task.getStatus() == TaskStatus::DELETED) ++deletedRows;
+  createdAts.push_back(task.getCreatedAt());
+  updatedAts.push_back(task.getUpdatedAt());
+  descriptionOffsets.push_back(store(task.getDescription()));
+  descriptionLengths.push_back(static_cast<std::uint32_t>(task.getDescription().size()));
+}
+
+void TaskTable::Chunk::set(std::size_t r, const TaskView& task) {
+  if(statuses[r] == static_cast<std::uint8_t>(TaskStatus::DELETED)) --deletedRows;
+  statuses[r] = static_cast<std::uint8_t>(task.getStatus());
+  if(task.getStatus() == TaskStatus::DELETED) ++deletedRows;
+  createdAts[r] = task.getCreatedAt();
+  updatedAts[r] = task.getUpdatedAt();
+  if(row(r).getDescription() != task.getDescription()) {
+    garbageBytes += descriptionLengths[r];
+    descriptionOffsets[r] = store(task.getDescription());
+    descriptionLengths[r] = static_cast<std::uint32_t>(task.getDescription().size());
+    compactArena();
+  }
+}
+
+void TaskTable::Chunk::insert(std::size_t r, const TaskView& task) {
+  ids.insert(ids.begin() + static_cast<std::ptrdiff_t>(r), task.getId());
+  statuses.insert(statuses.begin() + static_cast<std::ptrdiff_t>(r), static_cast<std::uint8_t>(task.getStatus()));
+  if(task.getStatus() == TaskStatus::DELETED) ++deletedRows;
+  createdAts.insert(createdAts.begin() + static_cast<std::ptrdiff_t>(r), task.getCreatedAt());
+  updatedAts.insert(updatedAts.begin() + static_cast<std::ptrdiff_t>(r), task.getUpdatedAt());
+  descriptionOffsets.insert(descriptionOffsets.begin() + static_cast<std::ptrdiff_t>(r), store(task.getDescription()));
+  descriptionLengths.insert(descriptionLengths.begin() + static_cast<std::ptrdiff_t>(r),
+                            static_cast<std::uint32_t>(task.getDescription().size()));
+}
+
+void TaskTable::Chunk::erase(std::size_t r) {
+  garbageBytes += descriptionLengths[r];
+  if(statuses[r] == static_cast<std::uint8_t>(TaskStatus::DELETED)) --deletedRows;
+  const auto at = static_cast<std::ptrdiff_t>(r);
+  ids.erase(ids.begin() + at);
+  statuses.erase(statuses.begin() + at);
+  createdAts.erase(createdAts.begin() + at);
+  updatedAts.erase(updatedAts.begin() + at);
+  descriptionOffsets.erase(descriptionOffsets.begin() + at);
+  descriptionLengths.erase(descriptionLengths.begin() + at);
+  compactArena();
+}
+
+std::uint64_t TaskTable::Chunk::store(std::string_view description) {
+  std::uint64_t offset = arena.size();
+  arena.append(description);
+  return offset;
+}
+
+void TaskTable::Chunk::compactArena() {
+  if(garbageBytes * 2 <= arena.size()) return;
+
+  std::string packed;
+  packed.reserve(arena.size() - garbageBytes);
+  for(std::size_t r = 0; r < ids.size(); ++r) {
+    std::uint64_t offset = packed.size();
+    packed.append(arena, descriptionOffsets[r], descriptionLengths[r]);
+    descriptionOffsets[r] = offset;
+  }
+  arena = std::move(packed);
+  garbageBytes = 0;
+}
+
+void TaskTable::clear() {
+  chunks.clear();
+  chunkStarts.clear();
+  rowCount = 0;
+}
+
+void TaskTable::reserve(std::size_t rows) {
+  chunks.reserve(rows / CHUNK_ROWS + 1);
+  chunkStarts.reserve(rows / CHUNK_ROWS + 1);
+}
+
+/**
+ * @brief Appends a row; the task ID must be greater than every existing ID.
+ * @param task The task to append.
+ * @note Starts a new chunk once the last one holds CHUNK_ROWS rows.
+ */
+void TaskTable::append(const TaskView& task) {
+  if(chunks.empty() || chunks.back()->ids.size() >= CHUNK_ROWS) {
+    chunks.push_back(std::make_shared<Chunk>());
+    chunkStarts.push_back(rowCount);
+  }
+  writable(chunks.size() - 1).push(task);
+  ++rowCount;
+}
+
+/**
+ * @brief Inserts or replaces the row for a task, keeping rows ordered by ID.
+ * @param task The task to store.
+ * @note Appending past the highest ID is O(1); inserting in the middle shifts the columns of one
+ *       chunk, splitting it once it holds twice CHUNK_ROWS rows.
+ * @note A replaced description is only re-stored if it changed.
+ */
+void TaskTable::upsert(const TaskView& task) {
+  const std::size_t c = chunkFor(task.getId());
+  if(c == chunks.size()) {
+    append(task);
+    return;
+  }
+
+  const std::vector<std::int32_t>& ids = chunks[c]->ids;
+  const auto r = static_cast<std::size_t>(std::lower_bound(ids.begin(), ids.end(), task.getId()) - ids.begin());
+  const bool replace = ids[r] == task.getId();
+  Chunk& chunk = writable(c);
+  if(replace) {
+    chunk.set(r, task);
+  } else {
+    chunk.insert(r, task);
+    ++rowCount;
+    for(std::size_t next = c + 1; next < chunkStarts.size(); ++next) ++chunkStarts[next];
+  }
+  if(chunk.ids.size() >= 2 * CHUNK_ROWS) split(c);
+}
+
+/**
+ * @brief Removes the row for a task.
+ * @param id The ID of the task to remove.
+ * @note No effect if the ID is not in the table.
+ */
+void TaskTable::erase(int id) {
+  auto r = find(id);
+  if(!r) return;
+
+  const std::size_t c = chunkOf(*r);
+  Chunk& chunk = writable(c);
+  chunk.erase(*r - chunkStarts[c]);
+  --rowCount;
+  for(std::size_t next = c + 1; next < chunkStarts.size(); ++next) --chunkStarts[next];
+  if(chunk.ids.empty()) {
+    chunks.erase(chunks.begin() + static_cast<std::ptrdiff_t>(c));
+    chunkStarts.erase(chunkStarts.begin() + static_cast<std::ptrdiff_t>(c));
+  }
+}
+
+std::size_t TaskTable::size() const { return rowCount; }
+
+std::optional<std::size_t> TaskTable::find(int id) const {
+  const std::size_t c = chunkFor(id);
+  if(c == chunks.size()) return std::nullopt;
+  const std::vector<std::int32_t>& ids = chunks[c]->ids;
+  auto it = std::lower_bound(ids.begin(), ids.end(), id);
+  if(*it != id) return std::nullopt;
+  return chunkStarts[c] + static_cast<std::size_t>(it - ids.begin());
+}
+
+TaskView TaskTable::row(std::size_t row) const {
+  const std::size_t c = chunkOf(row);
+  return chunks[c]->row(row - chunkStarts[c]);
+}
+
+std::size_t TaskTable::chunkCount() const { return chunks.size(); }
+
+std::span<const std::int32_t> TaskTable::idColumn(std::size_t chunk) const { return chunks[chunk]->ids; }
+
+std::span<const std::uint8_t> TaskTable::statusColumn(std::size_t chunk) const { return chunks[chunk]->statuses; }
+
+std::span<const std::int64_t> TaskTable::updatedAtColumn(std::size_t chunk) const { return chunks[chunk]->updatedAts; }
+
+/**
+ * @brief Selects the rows matching a filter.
+ * @param filter The selection criteria.
+ * @return The matching row indexes, ascending.
+ * @note Each criterion runs a vectorized FilterKernels pass over one packed column of a chunk,
+ *       producing a selection bitmap; the bitmaps are intersected and only set bits are visited.
+ */
+std::vector<std::size_t> TaskTable::select(const TaskFilter& filter) const {
+  std::vector<std::size_t> rows;
+  selectRange(filter, 0, rowCount, rows);
+  return rows;
+}
+
+/**
+ * @brief Appends the rows of [begin, end) that match a filter.
+ * @param filter The selection criteria.
+ * @param begin The first row to test.
+ * @param end The row after the last one to test.
+ * @param rows Receives the matching row indexes, ascending.
+ * @note Filters chunk by chunk; chunks without tombstones skip the DELETED pass.
+ */
+void TaskTable::selectRange(const TaskFilter& filter, std::size_t begin, std::size_t end, std::vector<std::size_t>& rows) const {
+  if(begin >= end) return;
+  std::vector<std::uint64_t> selection;
+  std::vector<std::uint64_t> scratch;
+  for(std::size_t c = chunkOf(begin); c < chunks.size() && chunkStarts[c] < end; ++c) {
+    const Chunk& chunk = *chunks[c];
+    const std::size_t base = chunkStarts[c];
+    const std::size_t from = std::max(begin, base) - base;
+    const std::size_t n = std::min(end - base, chunk.ids.size()) - from;
+
+    if(!filter.status && !filter.updatedFrom && !filter.updatedUntil && chunk.deletedRows == 0) {
+      rows.reserve(rows.size() + n);
+      for(std::size_t i = 0; i < n; ++i) rows.push_back(base + from + i);
+      continue;
+    }
+
+    const std::size_t words = FilterKernels::bitmapWords(n);
+    selection.assign(words, ~std::uint64_t(0));
+    scratch.resize(words);
+
+    if(filter.status) {
+      FilterKernels::statusEquals(chunk.statuses.data() + from, n, static_cast<std::uint8_t>(*filter.status), scratch.data());
+      FilterKernels::andBitmaps(selection.data(), scratch.data(), words);
+    } else if(chunk.deletedRows > 0) {
+      // Drop tombstones: invert the DELETED bitmap, keeping the bits past n clear
+      FilterKernels::statusEquals(chunk.statuses.data() + from, n, static_cast<std::uint8_t>(TaskStatus::DELETED), scratch.data());
+      for(std::uint64_t& word : scratch) word = ~word;
+      if(n % 64 != 0) scratch.back() &= (std::uint64_t(1) << (n % 64)) - 1;
+      FilterKernels::andBitmaps(selection.data(), scratch.data(), words);
+    }
+    if(filter.updatedFrom || filter.updatedUntil) {
+      FilterKernels::inRange(chunk.updatedAts.data() + from, n,
+                             filter.updatedFrom.value_or(std::numeric_limits<std::int64_t>::min()),
+                             filter.updatedUntil.value_or(std::numeric_limits<std::int64_t>::max()),
+                             scratch.data());
+      FilterKernels::andBitmaps(selection.data(), scratch.data(), words);
+    }
+
+    const std::size_t first = rows.size();
+    FilterKernels::collect(selection.data(), n, rows);
+    for(std::size_t i = first; i < rows.size(); ++i) rows[i] += base + from;
+  }
+}
+
+/**
+ * @brief Selects, orders and pages rows.
+ * @param query The filter, order and page.
+ * @return The matching row indexes in the requested order, at most query.limit of them.
+ * @note Rows are in ID order, so an ID order page starts with a binary search for the cursor and
+ *       filters blocks of PAGE_BLOCK_ROWS rows until it is full. Other orders filter the whole
+ *       table, gather the sort keys of the matches and only fully sort the first
+ *       query.offset + query.limit of them.
+ */
+std::vector<std::size_t> TaskTable::query(const TaskQuery& query) const {
+  const std::size_t wanted = query.end();
+  std::vector<std::size_t> rows;
+
+  if(query.order == TaskOrder::ID) {
+    std::size_t begin = 0;
+    if(query.after) {
+      const std::size_t c = query.after->id == std::numeric_limits<int>::max() ? chunks.size() : chunkFor(query.after->id + 1);
+      if(c == chunks.size()) return rows;
+      const std::vector<std::int32_t>& ids = chunks[c]->ids;
+      begin = chunkStarts[c] + static_cast<std::size_t>(std::upper_bound(ids.begin(), ids.end(), query.after->id) - ids.begin());
+    }
+    // Grow the blocks so an unlimited query costs a few passes rather than one per block
+    std::size_t block = PAGE_BLOCK_ROWS;
+    while(begin < rowCount && rows.size() < wanted) {
+      const std::size_t end = rowCount - begin > block ? begin + block : rowCount;
+      selectRange(query.filter, begin, end, rows);
+      begin = end;
+      block *= 2;
+    }
+  } else {
+    // Sort key of a selected row; its ID breaks ties on updatedAt
+    struct Key {
+      std::int64_t updatedAt;
+      std::int32_t id;
+      std::size_t row;
+    };
+    std::vector<std::size_t> selected = select(query.filter);
+    std::vector<Key> keys;
+    keys.reserve(selected.size());
+    std::size_t c = 0;
+    for(std::size_t r : selected) {
+      while(c + 1 < chunks.size() && chunkStarts[c + 1] <= r) ++c;
+      const Chunk& chunk = *chunks[c];
+      keys.push_back({chunk.updatedAts[r - chunkStarts[c]], chunk.ids[r - chunkStarts[c]], r});
+    }
+
+    auto earlier = [](const Key& a, const Key& b) {
+      return a.updatedAt != b.updatedAt ? a.updatedAt < b.updatedAt : a.id < b.id;
+    };
+    auto later = [&earlier](const Key& a, const Key& b) { return earlier(b, a); };
+    if(query.after) {
+      const TaskCursor cursor = *query.after;
+      const bool ascending = query.order == TaskOrder::UPDATED;
+      std::erase_if(keys, [&](const Key& key) {
+        if(key.updatedAt != cursor.updatedAt) return (key.updatedAt > cursor.updatedAt) != ascending;
+        return ascending ? key.id <= cursor.id : key.id >= cursor.id;
+      });
+    }
+    const std::size_t count = std::min(wanted, keys.size());
+    if(query.order == TaskOrder::UPDATED) {
+      std::partial_sort(keys.begin(), keys.begin() + static_cast<std::ptrdiff_t>(count), keys.end(), earlier);
+    } else {
+      std::partial_sort(keys.begin(), keys.begin() + static_cast<std::ptrdiff_t>(count), keys.end(), later);
+    }
+    rows.reserve(count);
+    for(std::size_t i = 0; i < count; ++i) rows.push_back(keys[i].row);
+  }
+
+  rows.erase(rows.begin(), rows.begin() + static_cast<std::ptrdiff_t>(std::min(query.offset, rows.size())));
+  if(rows.size() > query.limit) rows.resize(query.limit);
+  return rows;
+}
+
+std::size_t TaskTable::chunkOf(std::size_t row) const {
+  return static_cast<std::size_t>(std::upper_bound(chunkStarts.begin(), chunkStarts.end(), row) - chunkStarts.begin()) - 1;
+}
+
+std::size_t TaskTable::chunkFor(int id) const {
+  auto it = std::partition_point(chunks.begin(), chunks.end(),
+                                 [id](const std::shared_ptr<Chunk>& chunk) { return chunk->ids.back() < id; });
+  return static_cast<std::size_t>(it - chunks.begin());
+}
+
+/**
+ * @brief Gets a chunk for writing, cloning it first if a copy of the table shares it.
+ * @param chunk The chunk index.
+ * @return The chunk, owned by this table alone.
+ * @note Copies are only made from the table itself, so a use count of one cannot grow while a
+ *       mutation runs; copies released on other threads can only shrink it.
+ */
+TaskTable::Chunk& TaskTable::writable(std::size_t chunk) {
+  if(chunks[chunk].use_count() > 1) {
+    chunks[chunk] = std::make_shared<Chunk>(*chunks[chunk]);
+  } else {
+    // Pairs with the release of the last other reference, so its reads finish before these writes
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+  return *chunks[chunk];
+}
+
+void TaskTable::split(std::size_t chunk) {
+  Chunk& first = *chunks[chunk];
+  auto second = std::make_shared<Chunk>();
+  const std::size_t half = first.ids.size() / 2;
+  for(std::size_t r = half; r < first.ids.size(); ++r) {
+    second->push(first.row(r));
+    first.garbageBytes += first.descriptionLengths[r];
+  }
+  first.deletedRows -= second->deletedRows;
+  first.ids.resize(half);
+  first.statuses.resize(half);
+  first.createdAts.resize(half);
+  first.updatedAts.resize(half);
+  first.descriptionOffsets.resize(half);
+  first.descriptionLengths.resize(half);
+  first.compactArena();
+
+  chunks.insert(chunks.begin() + static_cast<std::ptrdiff_t>(chunk + 1), std::move(second));
+  chunkStarts.insert(chunkStarts.begin() + static_cast<std::ptrdiff_t>(chunk + 1), chunkStarts[chunk] + half);
+}
@@ -0,0 +1,49 @@
+#include "core/TaskView.h"
+#include "core/TaskSerializer.h"
+
+TaskView::TaskView(int id, std::string_view description, TaskStatus status, std::time_t createdAt, std::time_t updatedAt) :
+           id(id), description(description), status(status), createdAt(createdAt), updatedAt(updatedAt) {}
+
+TaskView::TaskView(const Task& task) :
+           id(task.getId()), description(task.getDescription()), status(task.getStatus()),
+           createdAt(task.getCreatedAt()), updatedAt(task.getUpdatedAt()) {}
+
+int TaskView::getId() const { return id; }
+
+std::string_view TaskView::getDescription() const { return description; }
+
+TaskStatus TaskView::getStatus() const { return status; }
+
+std::time_t TaskView::getCreatedAt() const { return createdAt; }
+
+std::time_t TaskView::getUpdatedAt() const { return updatedAt; }
+
+/**
+ * @brief Copies the viewed fields into an owning Task.
+ * @return A Task with the same attributes.
+ */
+Task TaskView::toTask(const Task::allocator_type& allocator) const {
+    return Task(id, description, status, createdAt, updatedAt, allocator);
+}
+
+/**
+ * @brief Converts the task to a human-readable string representation.
+ * @return A string describing the task's attributes in the format:
+ *         "Task: ( id: <id>, status: <label>, description: <desc>, createdAt: <time>, updatedAt: <time> )".
+ */
+std::string TaskView::toString() const {
+    char time[Task::TIME_BUFFER_SIZE];
+    TaskSerializer text;
+    text.appendRaw("Task: ( id: ");
+    text.appendInteger(id);
+    text.appendRaw(", status: ");
+    text.appendRaw(TaskUtils::statusToLabel(status));
+    text.appendRaw(", description: ");
+    text.appendRaw(description);
+    text.appendRaw(", createdAt: ");
+    text.appendRaw(std::string_view(time, Task::formatTime(createdAt, time)));
+    text.appendRaw(", updatedAt: ");
+    text.appendRaw(std::string_view(time, Task::formatTime(updatedAt, time)));
+    text.appendRaw(" )");
+    return text.take();
+}
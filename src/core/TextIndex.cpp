@@ -0,0 +1,497 @@
+#include "core/TextIndex.h"
+#include "core/AtomicFile.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+    /**
+     * @brief Magic bytes identifying a text index file.
+     */
+    constexpr char textIndexMagic[8] = {'T', 'T', 'F', 'T', 'S', '0', '0', '1'};
+
+    /**
+     * @brief Log size (bytes) above which commit() merges the log into the term table.
+     */
+    constexpr std::uint64_t LOG_COMPACTION_THRESHOLD = 1024 * 1024;
+
+    /**
+     * @brief On-disk header at the start of a text index file.
+     * @note Followed by termCount TermEntry records sorted by term, postingCount task IDs, textSize
+     *       bytes of term text and, from logOffset to the end of the file, the log.
+     */
+    struct TextIndexHeader {
+        char magic[8];
+        std::uint64_t storeSize;
+        std::int64_t storeMtime;
+        std::uint64_t storeVersion;
+        std::uint64_t termCount;
+        std::uint64_t postingCount;
+        std::uint64_t textSize;
+        std::uint64_t logOffset;
+    };
+
+    /**
+     * @brief One term of the term table and the location of its posting list.
+     */
+    struct TermEntry {
+        std::uint32_t textOffset;
+        std::uint32_t textLength;
+        std::uint32_t postingOffset;
+        std::uint32_t postingCount;
+    };
+
+    static_assert(sizeof(TextIndexHeader) == 64, "TextIndexHeader must match the on-disk layout");
+    static_assert(sizeof(TermEntry) == 16, "TermEntry must match the on-disk layout");
+
+    /**
+     * @brief A log record header: the op ('P' for put, 'D' for delete), the task ID and the
+     *        length of the space-separated terms that follow.
+     */
+    struct RecordHeader {
+        std::uint32_t op;
+        std::int32_t id;
+        std::uint32_t length;
+    };
+
+    static_assert(sizeof(RecordHeader) == 12, "RecordHeader must match the on-disk layout");
+
+    using TermPostings = std::vector<std::pair<std::string, std::vector<int>>>;
+
+    /**
+     * @brief Records the store's current size, modification time and version in a header.
+     */
+    void stamp(TextIndexHeader& header, const std::string& storePath, std::uint64_t version) {
+        header.storeSize = std::filesystem::file_size(storePath);
+        header.storeMtime = std::filesystem::last_write_time(storePath).time_since_epoch().count();
+        header.storeVersion = version;
+    }
+
+    TextIndexHeader headerOf(std::string_view image) {
+        TextIndexHeader header {};
+        std::memcpy(&header, image.data(), sizeof(header));
+        return header;
+    }
+
+    TermEntry termAt(std::string_view image, std::size_t index) {
+        TermEntry entry;
+        std::memcpy(&entry, image.data() + sizeof(TextIndexHeader) + index * sizeof(TermEntry), sizeof(entry));
+        return entry;
+    }
+
+    std::string_view termText(std::string_view image, const TextIndexHeader& header, const TermEntry& entry) {
+        std::size_t text = sizeof(TextIndexHeader) + header.termCount * sizeof(TermEntry) + header.postingCount * sizeof(std::int32_t);
+        return image.substr(text + entry.textOffset, entry.textLength);
+    }
+
+    void appendPostings(std::string_view image, const TextIndexHeader& header, const TermEntry& entry, std::vector<int>& ids) {
+        std::size_t postings = sizeof(TextIndexHeader) + header.termCount * sizeof(TermEntry);
+        std::size_t old = ids.size();
+        ids.resize(old + entry.postingCount);
+        std::memcpy(ids.data() + old, image.data() + postings + entry.postingOffset * sizeof(std::int32_t),
+                    entry.postingCount * sizeof(std::int32_t));
+    }
+
+    /**
+     * @brief Encodes terms and their posting lists as a term table with an unstamped header.
+     * @param terms The terms in ascending order, each with its task IDs in ascending order.
+     */
+    std::string encode(const TermPostings& terms) {
+        TextIndexHeader header {};
+        std::memcpy(header.magic, textIndexMagic, sizeof(textIndexMagic));
+        header.termCount = terms.size();
+        for(const auto& [term, ids] : terms) {
+            header.postingCount += ids.size();
+            header.textSize += term.size();
+        }
+        if(header.postingCount > UINT32_MAX || header.textSize > UINT32_MAX) {
+            throw std::runtime_error("Text index too large");
+        }
+        header.logOffset = sizeof(header) + header.termCount * sizeof(TermEntry)
+                           + header.postingCount * sizeof(std::int32_t) + header.textSize;
+
+        std::string image;
+        image.reserve(header.logOffset);
+        image.append(reinterpret_cast<const char*>(&header), sizeof(header));
+        TermEntry entry {};
+        for(const auto& [term, ids] : terms) {
+            entry.textLength = static_cast<std::uint32_t>(term.size());
+            entry.postingCount = static_cast<std::uint32_t>(ids.size());
+            image.append(reinterpret_cast<const char*>(&entry), sizeof(entry));
+            entry.textOffset += entry.textLength;
+            entry.postingOffset += entry.postingCount;
+        }
+        for(const auto& [term, ids] : terms) {
+            image.append(reinterpret_cast<const char*>(ids.data()), ids.size() * sizeof(std::int32_t));
+        }
+        for(const auto& [term, ids] : terms) image.append(term);
+        return image;
+    }
+
+    bool isTermByte(unsigned char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c >= 0x80;
+    }
+
+    /**
+     * @brief Calls visit with every term of a text, lowercased, in order and with repeats.
+     */
+    template <typename Visit>
+    void forEachTerm(std::string_view text, Visit visit) {
+        std::string term;
+        for(std::size_t i = 0; i <= text.size(); ++i) {
+            unsigned char c = i < text.size() ? static_cast<unsigned char>(text[i]) : ' ';
+            if(isTermByte(c)) {
+                term += static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+            } else if(!term.empty()) {
+                visit(std::move(term));
+                term.clear();
+            }
+        }
+    }
+
+}
+
+/**
+ * @brief Splits text into the terms it is indexed under.
+ * @param text The text to split.
+ * @return The distinct terms, lowercased, in ascending order.
+ * @note Terms are runs of ASCII letters and digits and of non-ASCII (UTF-8) bytes, so words in
+ *       other scripts are indexed whole but not case-folded.
+ */
+std::vector<std::string> TextIndex::tokenize(std::string_view text) {
+  std::vector<std::string> terms;
+  forEachTerm(text, [&](std::string term) { terms.push_back(std::move(term)); });
+  std::sort(terms.begin(), terms.end());
+  terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+  return terms;
+}
+
+bool TextIndex::exists(const std::string& storePath) {
+  std::error_code ec;
+  return std::filesystem::exists(storePath + ".fts", ec);
+}
+
+/**
+ * @brief Opens the index of a store if it is up to date.
+ * @param storePath The store.
+ * @param storeVersion The current StoreLock version of the store.
+ * @return False if the index is missing, stale or damaged; it must then be built.
+ * @throws std::runtime_error If the index file cannot be mapped.
+ * @note The log is replayed into memory, so it costs O(log size) on top of mapping the file.
+ */
+bool TextIndex::open(const std::string& storePath, std::uint64_t storeVersion) {
+  close();
+  this->storePath = storePath;
+  indexPath = storePath + ".fts";
+
+  if(!exists(storePath)) return false;
+  file = MappedFile(indexPath, MappedFile::Access::READ_ONLY);
+  if(file.size() < sizeof(TextIndexHeader)) return false;
+
+  TextIndexHeader header = headerOf(std::string_view(file.data(), file.size()));
+  TextIndexHeader current {};
+  stamp(current, storePath, storeVersion);
+  if(std::memcmp(header.magic, textIndexMagic, sizeof(textIndexMagic)) != 0
+     || header.storeSize != current.storeSize || header.storeMtime != current.storeMtime
+     || header.storeVersion != current.storeVersion
+     || header.logOffset != sizeof(header) + header.termCount * sizeof(TermEntry)
+                            + header.postingCount * sizeof(std::int32_t) + header.textSize
+     || file.size() < header.logOffset) {
+    file.close();
+    return false;
+  }
+
+  image = std::string_view(file.data(), header.logOffset);
+  logSize = file.size() - header.logOffset;
+  if(!replay(std::string_view(file.data() + header.logOffset, logSize))) {
+    close();
+    return false;
+  }
+  opened = true;
+  return true;
+}
+
+/**
+ * @brief Builds the index in memory from every task of a store.
+ * @param storePath The store.
+ * @param documents The ID and description of every task, in ascending ID order.
+ * @note Nothing is written until commit().
+ * @note Documents arrive in ID order, so every posting list is built sorted.
+ */
+void TextIndex::build(const std::string& storePath, const std::vector<std::pair<int, std::string_view>>& documents) {
+  close();
+  this->storePath = storePath;
+  indexPath = storePath + ".fts";
+
+  std::unordered_map<std::string, std::vector<int>> postings;
+  for(const auto& [id, description] : documents) {
+    for(std::string& term : tokenize(description)) postings[std::move(term)].push_back(id);
+  }
+  TermPostings terms(std::make_move_iterator(postings.begin()), std::make_move_iterator(postings.end()));
+  std::sort(terms.begin(), terms.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  built = encode(terms);
+  image = built;
+  opened = true;
+}
+
+bool TextIndex::isOpen() const { return opened; }
+
+/**
+ * @brief Indexes the description of an added or updated task, replacing its old terms.
+ * @param id The ID of the task.
+ * @param description The new description.
+ * @note Also records the change for the next commit().
+ */
+void TextIndex::put(int id, std::string_view description) {
+  std::vector<std::string> terms = tokenize(description);
+  std::string joined;
+  for(const std::string& term : terms) {
+    if(!joined.empty()) joined += ' ';
+    joined += term;
+  }
+
+  RecordHeader record {'P', id, static_cast<std::uint32_t>(joined.size())};
+  pending.append(reinterpret_cast<const char*>(&record), sizeof(record));
+  pending.append(joined);
+  changed[id] = std::move(terms);
+}
+
+/**
+ * @brief Removes a deleted task from the index.
+ * @param id The ID of the task.
+ * @note Also records the change for the next commit().
+ */
+void TextIndex::remove(int id) {
+  RecordHeader record {'D', id, 0};
+  pending.append(reinterpret_cast<const char*>(&record), sizeof(record));
+  changed[id].clear();
+}
+
+/**
+ * @brief Writes the changes since the last commit and stamps the index with the store's state.
+ * @param storeVersion The StoreLock version the store was saved as.
+ * @throws std::runtime_error If the index file cannot be written.
+ * @note Call after the store is written, under the exclusive store lock.
+ * @note Appends the changes to the log, so committing costs O(changes) I/O; a built index, or a
+ *       log grown past LOG_COMPACTION_THRESHOLD, is written out in full instead.
+ */
+void TextIndex::commit(std::uint64_t storeVersion) {
+  if(!built.empty() || logSize + pending.size() > LOG_COMPACTION_THRESHOLD) {
+    compact(storeVersion);
+    return;
+  }
+
+  TextIndexHeader header = headerOf(image);
+  image = {};
+  file.close();
+
+  std::fstream out(indexPath, std::ios::binary | std::ios::in | std::ios::out);
+  if(!out){
+    throw std::runtime_error("Failed to open text index file: " + indexPath);
+  }
+  out.seekp(static_cast<std::streamoff>(header.logOffset + logSize));
+  out.write(pending.data(), static_cast<std::streamsize>(pending.size()));
+  out.flush();
+  logSize += pending.size();
+  pending.clear();
+
+  stamp(header, storePath, storeVersion);
+  out.seekp(0, std::ios::beg);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.close();
+  if(!out){
+    throw std::runtime_error("Failed to write text index file: " + indexPath);
+  }
+
+  file = MappedFile(indexPath, MappedFile::Access::READ_ONLY);
+  image = std::string_view(file.data(), header.logOffset);
+}
+
+/**
+ * @brief Finds the tasks whose descriptions match a query.
+ * @param query Words separated by whitespace. Every word must match (AND); "OR" between
+ *              words separates alternatives, and binds looser than AND. A word ending in
+ *              '*' matches every term starting with it.
+ * @return The matching task IDs in ascending order.
+ * @note Words are split into terms like descriptions are, so "e-mail" must match both "e" and
+ *       "mail". Each AND group intersects its terms' lists from the shortest up.
+ */
+std::vector<int> TextIndex::search(std::string_view query) const {
+  std::vector<std::vector<std::pair<std::string, bool>>> groups(1);
+  std::size_t pos = 0;
+  while((pos = query.find_first_not_of(" \t\r\n", pos)) != std::string_view::npos) {
+    std::size_t end = std::min(query.find_first_of(" \t\r\n", pos), query.size());
+    std::string_view word = query.substr(pos, end - pos);
+    pos = end;
+    if(word == "OR") {
+      groups.emplace_back();
+      continue;
+    }
+    if(word == "AND") continue;
+
+    bool prefix = word.ends_with('*');
+    std::vector<std::pair<std::string, bool>> terms;
+    forEachTerm(word, [&](std::string term) { terms.emplace_back(std::move(term), false); });
+    if(!terms.empty()) terms.back().second = prefix;
+    groups.back().insert(groups.back().end(), terms.begin(), terms.end());
+  }
+
+  std::vector<int> result;
+  for(const auto& group : groups) {
+    if(group.empty()) continue;
+
+    std::vector<std::vector<int>> lists;
+    for(const auto& [term, prefix] : group) lists.push_back(match(term, prefix));
+    std::sort(lists.begin(), lists.end(), [](const auto& a, const auto& b) { return a.size() < b.size(); });
+    std::vector<int> matches = std::move(lists.front());
+    for(std::size_t i = 1; i < lists.size() && !matches.empty(); ++i) {
+      std::vector<int> both;
+      std::set_intersection(matches.begin(), matches.end(), lists[i].begin(), lists[i].end(), std::back_inserter(both));
+      matches = std::move(both);
+    }
+
+    std::vector<int> either;
+    std::set_union(result.begin(), result.end(), matches.begin(), matches.end(), std::back_inserter(either));
+    result = std::move(either);
+  }
+  return result;
+}
+
+void TextIndex::close() {
+  image = {};
+  file.close();
+  built.clear();
+  logSize = 0;
+  changed.clear();
+  pending.clear();
+  opened = false;
+}
+
+/**
+ * @brief Finds the tasks indexed under a term.
+ * @param term A lowercased term.
+ * @param prefix Whether every term starting with term matches.
+ * @return The task IDs in ascending order.
+ * @note Binary-searches the term table, then replaces the postings of changed tasks by their
+ *       current terms.
+ */
+std::vector<int> TextIndex::match(std::string_view term, bool prefix) const {
+  std::vector<int> ids;
+  TextIndexHeader header = headerOf(image);
+  std::size_t low = 0, high = header.termCount;
+  while(low < high) {
+    std::size_t mid = low + (high - low) / 2;
+    if(termText(image, header, termAt(image, mid)) < term) low = mid + 1;
+    else high = mid;
+  }
+
+  std::size_t matchedTerms = 0;
+  for(std::size_t i = low; i < header.termCount; ++i) {
+    TermEntry entry = termAt(image, i);
+    std::string_view text = termText(image, header, entry);
+    if(prefix ? !text.starts_with(term) : text != term) break;
+    appendPostings(image, header, entry, ids);
+    ++matchedTerms;
+  }
+  if(matchedTerms > 1) {
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+  }
+  if(changed.empty()) return ids;
+
+  std::erase_if(ids, [this](int id) { return changed.contains(id); });
+  std::size_t stored = ids.size();
+  for(const auto& [id, terms] : changed) {
+    auto it = std::lower_bound(terms.begin(), terms.end(), term);
+    if(it != terms.end() && (prefix ? std::string_view(*it).starts_with(term) : *it == term)) ids.push_back(id);
+  }
+  std::inplace_merge(ids.begin(), ids.begin() + static_cast<std::ptrdiff_t>(stored), ids.end());
+  return ids;
+}
+
+/**
+ * @brief Applies log records to the changed tasks.
+ * @param records The encoded records.
+ * @return False if the records are torn or malformed.
+ */
+bool TextIndex::replay(std::string_view records) {
+  std::size_t pos = 0;
+  while(pos < records.size()) {
+    RecordHeader record;
+    if(records.size() - pos < sizeof(record)) return false;
+    std::memcpy(&record, records.data() + pos, sizeof(record));
+    pos += sizeof(record);
+    if((record.op != 'P' && record.op != 'D') || records.size() - pos < record.length) return false;
+
+    std::vector<std::string>& terms = changed[record.id];
+    terms.clear();
+    std::string_view joined = records.substr(pos, record.length);
+    pos += record.length;
+    while(!joined.empty()) {
+      std::size_t space = std::min(joined.find(' '), joined.size());
+      terms.emplace_back(joined.substr(0, space));
+      joined.remove_prefix(std::min(space + 1, joined.size()));
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Merges the changed tasks into the term table and writes a fresh index file.
+ * @param storeVersion The StoreLock version to stamp the index with.
+ * @throws std::runtime_error If the index file cannot be written.
+ * @note Works on terms only; no description is tokenized again.
+ * @note The new index is renamed over the old one, so other processes mapping it are unaffected.
+ *       It is derived data and is not flushed to disk.
+ */
+void TextIndex::compact(std::uint64_t storeVersion) {
+  std::map<std::string, std::vector<int>> added;
+  for(const auto& [id, terms] : changed) {
+    for(const std::string& term : terms) added[term].push_back(id);
+  }
+
+  TermPostings terms;
+  TextIndexHeader header = headerOf(image);
+  auto next = added.begin();
+  for(std::size_t i = 0; i < header.termCount; ++i) {
+    TermEntry entry = termAt(image, i);
+    std::string_view text = termText(image, header, entry);
+    for(; next != added.end() && next->first < text; ++next) terms.emplace_back(next->first, std::move(next->second));
+
+    std::vector<int> ids;
+    appendPostings(image, header, entry, ids);
+    std::erase_if(ids, [this](int id) { return changed.contains(id); });
+    if(next != added.end() && next->first == text) {
+      std::size_t stored = ids.size();
+      ids.insert(ids.end(), next->second.begin(), next->second.end());
+      std::inplace_merge(ids.begin(), ids.begin() + static_cast<std::ptrdiff_t>(stored), ids.end());
+      ++next;
+    }
+    if(!ids.empty()) terms.emplace_back(std::string(text), std::move(ids));
+  }
+  for(; next != added.end(); ++next) terms.emplace_back(next->first, std::move(next->second));
+
+  std::string encoded = encode(terms);
+  TextIndexHeader fresh = headerOf(encoded);
+  stamp(fresh, storePath, storeVersion);
+  std::memcpy(encoded.data(), &fresh, sizeof(fresh));
+
+  image = {};
+  file.close();
+  AtomicFile out(indexPath, Durability::NONE);
+  out.write(encoded);
+  out.commit();
+
+  built.clear();
+  changed.clear();
+  pending.clear();
+  logSize = 0;
+  file = MappedFile(indexPath, MappedFile::Access::READ_ONLY);
+  image = std::string_view(file.data(), fresh.logOffset);
+}
@@ -1,6 +1,85 @@
 #include "core/TaskManager.h"
 #include "cli/Commands.h"
+#include "cli/Daemon.h"
+#include "core/Stats.h"
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+    /**
+     * @brief Loads the store and runs the command named by argv[1].
+     * @param argc The number of command-line arguments, without --stats.
+     * @param argv The array of command-line arguments, without --stats.
+     * @return The command's exit code.
+     */
+    int dispatch(int argc, char* argv[]) {
+
+        // Check for minimum required arguments
+        if (argc < 2) {
+            std::cerr << "Usage: ./task-cli <action>\n";
+            return 1;
+        }
+
+        // Commands that work on explicit store paths do not need the default store loaded
+        std::string action = argv[1];
+        if (action == "convert") {
+            // A daemon may hold unsaved changes to either store and would not see the new one
+            for (int i = 2; i < std::min(argc, 4); ++i) {
+                if (Daemon::serving(Daemon::socketPath(argv[i]))) {
+                    std::cerr << "A daemon is serving " << argv[i] << "; stop it before converting" << std::endl;
+                    return 1;
+                }
+            }
+            return CLI::convert(argc, argv);
+        }
+
+        const char* store = std::getenv("TASK_CLI_STORE");
+        std::string storeName = store ? store : "tasks.json";
+
+        // Hand the command to a running daemon
+        if (action != "serve" && !std::getenv("TASK_CLI_NO_DAEMON")) {
+            TASK_STATS_SCOPE("forward");
+            if (auto code = Daemon::forward(Daemon::socketPath(storeName), argc, argv)) return *code;
+        }
+
+        // Initialize the TaskManager and load tasks
+        TaskManager manager(storeName);
+        if (action == "add" || action == "update" || action == "delete" || action == "restore" || action.starts_with("mark-") || action == "search") {
+            // Single-task commands only decode the task they touch, and search only the tasks it finds
+            manager.setLazyLoading(true);
+        }
+        if (const char* mode = std::getenv("TASK_CLI_STORE_MODE"); mode && std::string(mode) == "journal") {
+            manager.setStoreMode(StoreMode::JOURNAL);
+        }
+        if (const char* level = std::getenv("TASK_CLI_DURABILITY")) {
+            std::string durability = level;
+            if (durability == "none") manager.setDurability(Durability::NONE);
+            else if (durability == "fsync-data") manager.setDurability(Durability::FSYNC_DATA);
+            else if (durability == "fsync-full") manager.setDurability(Durability::FSYNC_FULL);
+        }
+        try {
+            manager.loadTasksFromStore();
+        } catch (const std::exception& e) {
+            std::cerr << "Error loading tasks: " << e.what() << std::endl;
+            return 1;
+        }
+
+        // Determine the action and delegate to the appropriate CLI command
+        if (action == "serve") return Daemon::serve(manager, Daemon::socketPath(storeName), argc, argv);
+        int code = CLI::run(manager, argc, argv);
+#ifdef TASK_TRACKER_STATS
+        ArenaStats arena = manager.getArenaStats();
+        TASK_STATS_ADD("arena allocations", arena.allocations);
+        TASK_STATS_ADD("arena bytes", arena.usedBytes);
+#endif
+        return code;
+    }
+
+}
 
 /**
  * @brief Entry point for the task management CLI application.
@@ -20,31 +99,29 @@
  */
 int main(int argc, char* argv[]) {
 
-    // Check for minimum required arguments
-    if (argc < 2) {
-        std::cerr << "Usage: ./task-cli <action>\n";
-        return 1;
+    // --stats may appear anywhere; strip it so commands never see it
+    std::vector<char*> args;
+    bool stats = std::getenv("TASK_CLI_STATS") != nullptr;
+    for (int i = 0; i < argc; ++i) {
+        if (i > 0 && std::string_view(argv[i]) == "--stats") stats = true;
+        else args.push_back(argv[i]);
     }
+    args.push_back(nullptr);
+    int count = static_cast<int>(args.size()) - 1;
 
-    // Initialize the TaskManager and load tasks
-    TaskManager manager;
-    try {
-        manager.loadTasksFromStore();
-    } catch (const std::exception& e) {
-        std::cerr << "Error loading tasks: " << e.what() << std::endl;
-        return 1;
-    }
+#ifdef TASK_TRACKER_STATS
+    if (!stats) return dispatch(count, args.data());
 
-    // Determine the action and delegate to the appropriate CLI command
-    std::string action = argv[1];
-    if (action == "add") return CLI::add(manager, argc, argv);
-    if (action == "update") return CLI::update(manager, argc, argv);
-    if (action == "delete") return CLI::deleteTask(manager, argc, argv);
-    if (action == "mark-in-progress") return CLI::changeStatus(manager, argc, argv, TaskStatus::IN_PROGRESS);
-    if (action == "mark-done") return CLI::changeStatus(manager, argc, argv, TaskStatus::DONE);
-    if (action == "list") return CLI::list(manager, argc, argv);
-
-    // Handle unknown actions
-    std::cerr << "Unknown action: " << action << std::endl;
-    return 1;
-}
\ No newline at end of file
+    Stats::enable();
+    int code;
+    {
+        TASK_STATS_SCOPE("total");
+        code = dispatch(count, args.data());
+    }
+    Stats::report(std::cerr);
+    return code;
+#else
+    if (stats) std::cerr << "Stats are not compiled in; rebuild with -DTASK_TRACKER_ENABLE_STATS=ON" << std::endl;
+    return dispatch(count, args.data());
+#endif
+}
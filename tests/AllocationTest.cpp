@@ -0,0 +1,139 @@
+#include "TestSupport.h"
+#include "core/TaskManager.h"
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file AllocationTest.cpp
+ * @brief Counts heap allocations of the Task and TaskManager API through a replaced operator new.
+ *
+ * Reads must not allocate, rvalue descriptions must be stored once rather than copied again on
+ * their way into the map, and listing tasks must stay within a constant number of allocations
+ * per task.
+ */
+
+namespace {
+
+    std::size_t allocationCount = 0; ///< operator new calls since the program started.
+    std::size_t allocatedBytes = 0;  ///< Bytes requested through operator new since the program started.
+
+    /**
+     * @brief Allocations and bytes requested while a scope is alive.
+     */
+    class AllocationScope {
+    private:
+        std::size_t startCount = allocationCount;
+        std::size_t startBytes = allocatedBytes;
+    public:
+        std::size_t count() const { return allocationCount - startCount; }
+        std::size_t bytes() const { return allocatedBytes - startBytes; }
+    };
+
+    constexpr std::size_t TASKS = 20'000;
+    constexpr std::size_t DESCRIPTION_LENGTH = 1'000; ///< Far beyond the small-string buffer.
+
+    std::string description(std::size_t i, char fill) {
+        return std::to_string(i) + std::string(DESCRIPTION_LENGTH, fill);
+    }
+
+}
+
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    allocatedBytes += size;
+    if(void* p = std::malloc(size != 0 ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+// std::pmr::new_delete_resource(), which backs the task arena, allocates through the aligned form
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    ++allocationCount;
+    allocatedBytes += size;
+    std::size_t align = std::max(static_cast<std::size_t>(alignment), sizeof(void*));
+    if(void* p = std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+int main() {
+    TestSupport::ScratchDirectory directory("allocation-test");
+    const std::string store = directory.path("tasks.json");
+
+    TaskManager manager(store);
+    manager.setDurability(Durability::NONE);
+    manager.loadTasksFromStore();
+    manager.removeTask(1);
+
+    // The descriptions are built up front, so only the map's own allocations are counted: arena
+    // blocks and the bookkeeping of each insert, but never a second copy of a description.
+    std::vector<std::string> texts;
+    for(std::size_t i = 1; i <= TASKS * 2; ++i) texts.push_back(description(i, i <= TASKS ? 'a' : 'b'));
+    {
+        std::vector<Task> pending;
+        pending.reserve(TASKS);
+        for(std::size_t i = 1; i <= TASKS; ++i) {
+            pending.emplace_back(static_cast<int>(i), texts[i - 1], TaskStatus::TODO, 1, 1);
+        }
+        AllocationScope scope;
+        for(Task& task : pending) manager.addTask(std::move(task));
+        CHECK(scope.bytes() <= 2 * TASKS * (DESCRIPTION_LENGTH + 256));
+        CHECK(scope.count() <= TASKS / 100);
+    }
+    {
+        AllocationScope scope;
+        for(std::size_t i = TASKS + 1; i <= TASKS * 2; ++i) {
+            manager.emplaceTask(static_cast<int>(i), std::move(texts[i - 1]), TaskStatus::DONE, 2, 2);
+        }
+        CHECK(scope.bytes() <= 2 * TASKS * (DESCRIPTION_LENGTH + 256));
+        CHECK(scope.count() <= TASKS / 100);
+    }
+
+    // Reading tasks and shrinking descriptions in place allocate nothing.
+    {
+        AllocationScope scope;
+        std::size_t length = 0;
+        for(const auto& [id, task] : manager.getTasks()) length += task.getDescription().size();
+        manager.forEachTask([&length](const TaskView& task) { length += task.getDescription().size(); });
+        CHECK(length > 0);
+        CHECK(scope.count() == 0);
+    }
+    {
+        std::string shorter = description(7, 'c').substr(0, DESCRIPTION_LENGTH / 2);
+        AllocationScope scope;
+        CHECK(manager.updateDescription(7, std::move(shorter), 3));
+        CHECK(scope.count() == 0);
+        CHECK(manager.findTaskView(7)->getDescription().size() == DESCRIPTION_LENGTH / 2);
+    }
+    {
+        Task task(9, description(9, 'd'), TaskStatus::TODO, 4, 4);
+        AllocationScope scope;
+        std::string_view view = task.getDescription();
+        task.setDescription(view.substr(0, 10));
+        CHECK(scope.count() == 0);
+    }
+
+    // Listing allocates a constant number of times per task, not per character.
+    {
+        manager.saveTasksToStore();
+        AllocationScope scope;
+        TestSupport::CommandOutput result = TestSupport::run(manager, {"list", "--format", "jsonl"});
+        CHECK(result.code == 0);
+        CHECK(scope.count() <= TASKS * 2 * 4);
+    }
+    {
+        AllocationScope scope;
+        TestSupport::CommandOutput result = TestSupport::run(manager, {"list"});
+        CHECK(result.code == 0);
+        CHECK(scope.count() <= TASKS * 2 * 4);
+    }
+
+    return TestSupport::result();
+}
@@ -0,0 +1,127 @@
+#include "TestSupport.h"
+#include "core/BinaryStore.h"
+#include "core/TaskManager.h"
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @file BinaryStoreTest.cpp
+ * @brief Checks that BinaryStore::open() rejects truncated and corrupt stores instead of mapping
+ *        them, and that status changes only reach the mapped file when they are saved.
+ *
+ * Offsets below follow the on-disk layout: a 32-byte header, then 40-byte records holding the
+ * id at byte 0, the description offset at byte 24 and the description length at byte 32.
+ */
+
+namespace {
+
+    constexpr std::size_t HEADER_SIZE = 32;
+    constexpr std::size_t RECORD_SIZE = 40;
+
+    /**
+     * @brief Copies the valid store and overwrites some of its bytes.
+     */
+    std::string corrupt(const std::string& valid, const std::string& path, std::size_t at, const void* bytes, std::size_t size) {
+        std::filesystem::copy_file(valid, path, std::filesystem::copy_options::overwrite_existing);
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(at));
+        file.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(size));
+        return path;
+    }
+
+    bool opens(const std::string& path) {
+        try {
+            BinaryStore store;
+            store.open(path);
+            for(std::size_t i = 0; i < store.size(); ++i) store.at(i);
+            return true;
+        } catch(const std::runtime_error&) {
+            return false;
+        }
+    }
+
+}
+
+int main() {
+    TestSupport::ScratchDirectory directory("binary-store-test");
+    const std::string valid = directory.path("tasks.bin");
+    const std::string broken = directory.path("broken.bin");
+    {
+        TaskManager manager(directory.path("tasks.json"));
+        manager.setDurability(Durability::NONE);
+        manager.loadTasksFromStore();
+        for(int id = 2; id <= 10; ++id) manager.emplaceTask(id, "task " + std::to_string(id), TaskStatus::TODO, 0, 0);
+        manager.exportStore(valid, StoreFormat::BINARY);
+    }
+    CHECK(opens(valid));
+
+    const std::uint64_t pastHeap = 1 << 20;
+    CHECK(!opens(corrupt(valid, broken, HEADER_SIZE + 3 * RECORD_SIZE + 24, &pastHeap, sizeof(pastHeap))));
+
+    const std::uint32_t tooLong = 1 << 20;
+    CHECK(!opens(corrupt(valid, broken, HEADER_SIZE + 9 * RECORD_SIZE + 32, &tooLong, sizeof(tooLong))));
+
+    const std::uint64_t wraps = UINT64_MAX - 2;
+    CHECK(!opens(corrupt(valid, broken, HEADER_SIZE + 5 * RECORD_SIZE + 24, &wraps, sizeof(wraps))));
+
+    const std::int32_t outOfOrder = 100;
+    CHECK(!opens(corrupt(valid, broken, HEADER_SIZE + 2 * RECORD_SIZE, &outOfOrder, sizeof(outOfOrder))));
+
+    // A store cut short inside its heap or its record table
+    for(std::uintmax_t size : {std::filesystem::file_size(valid) - 5, std::uintmax_t(HEADER_SIZE + RECORD_SIZE + 7), std::uintmax_t(10)}) {
+        std::filesystem::copy_file(valid, broken, std::filesystem::copy_options::overwrite_existing);
+        std::filesystem::resize_file(broken, size);
+        CHECK(!opens(broken));
+    }
+
+    // Status changes stay in the process until its save, which merges a save made in between
+    auto statusIn = [&valid](int id) {
+        TaskManager reader(valid);
+        reader.loadTasksFromStore();
+        return reader.findTaskView(id)->getStatus();
+    };
+    {
+        TaskManager first(valid);
+        first.setDurability(Durability::NONE);
+        first.loadTasksFromStore();
+        CHECK(first.setStatus(3, TaskStatus::DONE, 1));
+        CHECK(first.deleteTask(4, 1));
+        CHECK(first.findTaskView(3)->getStatus() == TaskStatus::DONE);
+        std::size_t deleted = 0;
+        first.forEachTask([&deleted](const TaskView& task) { deleted += task.getStatus() == TaskStatus::DELETED; });
+        CHECK(deleted == 1);
+        CHECK(statusIn(3) == TaskStatus::TODO);
+        CHECK(statusIn(4) == TaskStatus::TODO);
+
+        TaskManager second(valid);
+        second.setDurability(Durability::NONE);
+        second.loadTasksFromStore();
+        CHECK(second.setStatus(5, TaskStatus::IN_PROGRESS, 1));
+        second.saveTasksToStore();
+        CHECK(statusIn(3) == TaskStatus::TODO);
+        CHECK(statusIn(5) == TaskStatus::IN_PROGRESS);
+
+        first.saveTasksToStore();
+    }
+    CHECK(statusIn(3) == TaskStatus::DONE);
+    CHECK(statusIn(4) == TaskStatus::DELETED);
+    CHECK(statusIn(5) == TaskStatus::IN_PROGRESS);
+    CHECK(opens(valid));
+
+    // Loading a corrupt store fails with the same error rather than reading past the mapping
+    corrupt(valid, directory.path("tasks.json"), HEADER_SIZE + 3 * RECORD_SIZE + 24, &pastHeap, sizeof(pastHeap));
+    TaskManager manager(directory.path("tasks.json"));
+    bool threw = false;
+    try {
+        manager.loadTasksFromStore();
+    } catch(const std::runtime_error& error) {
+        threw = std::string(error.what()).find("Corrupt binary store") != std::string::npos;
+    }
+    CHECK(threw);
+
+    return TestSupport::result();
+}
@@ -0,0 +1,135 @@
+#include "TestSupport.h"
+#include "core/TaskManager.h"
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * @file ConcurrentWriterTest.cpp
+ * @brief Forks writer processes that add tasks to one store at the same time.
+ *
+ * Every writer behaves like a separate `task-cli add` invocation: a fresh TaskManager loads the
+ * store, adds one task and saves it. Afterwards the store must hold every added task exactly once
+ * under a unique id, and each id a writer was told must be the one its task was saved under.
+ * Runs against snapshot, journal and binary stores.
+ */
+
+namespace {
+
+    constexpr int WRITERS = 8;
+    constexpr int ADDS_PER_WRITER = 50;
+
+    /**
+     * @brief Configures a manager the way task-cli would for the given mode.
+     */
+    void configure(TaskManager& manager, const std::string& mode) {
+        manager.setDurability(Durability::NONE);
+        manager.setLazyLoading(true);
+        if(mode == "journal") manager.setStoreMode(StoreMode::JOURNAL);
+    }
+
+    /**
+     * @brief Adds ADDS_PER_WRITER tasks, one process-like TaskManager each, and records the reported ids.
+     * @return The number of adds that failed or reported no id.
+     */
+    int write(const std::string& store, const std::string& mode, int writer, const std::string& report) {
+        std::ofstream ids(report);
+        int failures = 0;
+        for(int add = 0; add < ADDS_PER_WRITER; ++add) {
+            TaskManager manager(store);
+            configure(manager, mode);
+            manager.loadTasksFromStore();
+            std::string description = "writer " + std::to_string(writer) + " add " + std::to_string(add);
+            TestSupport::CommandOutput result = TestSupport::run(manager, {"add", description});
+            std::size_t id = result.out.find("id: ");
+            if(result.code != 0 || id == std::string::npos) {
+                ++failures;
+                continue;
+            }
+            ids << std::stoi(result.out.substr(id + 4)) << " " << description << "\n";
+        }
+        return failures;
+    }
+
+    /**
+     * @brief Runs the writers against one store and checks the result.
+     */
+    void check(const TestSupport::ScratchDirectory& directory, const std::string& mode) {
+        std::string store = directory.path(mode + ".json");
+        {
+            TaskManager manager(store);
+            manager.setDurability(Durability::NONE);
+            manager.loadTasksFromStore();
+            if(mode == "binary") {
+                store = directory.path("binary.bin");
+                manager.exportStore(store, StoreFormat::BINARY);
+            }
+        }
+
+        std::vector<pid_t> children;
+        for(int writer = 0; writer < WRITERS; ++writer) {
+            pid_t pid = ::fork();
+            if(pid == 0) {
+                std::string report = directory.path(mode + "-writer-" + std::to_string(writer));
+                ::_exit(write(store, mode, writer, report) == 0 ? 0 : 1);
+            }
+            CHECK(pid > 0);
+            children.push_back(pid);
+        }
+        for(pid_t child : children) {
+            int status = 0;
+            CHECK(::waitpid(child, &status, 0) == child);
+            CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+        }
+
+        TaskManager manager(store);
+        configure(manager, mode);
+        manager.loadTasksFromStore();
+        std::map<int, std::string> saved;
+        std::size_t visited = 0;
+        manager.forEachTask([&](const TaskView& task) {
+            ++visited;
+            saved.emplace(task.getId(), std::string(task.getDescription()));
+        });
+        CHECK(visited == saved.size());
+        CHECK(saved.size() == 1 + WRITERS * ADDS_PER_WRITER);
+
+        // Every add is in the store once, under the id its writer reported
+        std::set<std::string> descriptions;
+        for(const auto& [id, description] : saved) descriptions.insert(description);
+        CHECK(descriptions.size() == saved.size());
+        for(int writer = 0; writer < WRITERS; ++writer) {
+            std::ifstream ids(directory.path(mode + "-writer-" + std::to_string(writer)));
+            int reported = 0;
+            std::string description;
+            int count = 0;
+            while(ids >> reported && std::getline(ids >> std::ws, description)) {
+                ++count;
+                auto task = saved.find(reported);
+                CHECK(task != saved.end() && task->second == description);
+            }
+            CHECK(count == ADDS_PER_WRITER);
+        }
+
+        // The snapshot itself holds no duplicate records
+        if(mode == "snapshot") {
+            std::ifstream in(store, std::ios::binary);
+            std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            std::size_t records = 0;
+            for(std::size_t at = text.find("\"id\":"); at != std::string::npos; at = text.find("\"id\":", at + 1)) ++records;
+            CHECK(records == saved.size());
+        }
+    }
+
+}
+
+int main() {
+    TestSupport::ScratchDirectory directory("concurrent-writer-test");
+    for(const std::string mode : {"snapshot", "journal", "binary"}) check(directory, mode);
+    return TestSupport::result();
+}
@@ -0,0 +1,123 @@
+#include "TestSupport.h"
+#include "core/TaskManager.h"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/**
+ * @file DeleteRestoreTest.cpp
+ * @brief Checks delete -> restore -> compact round trips on a lazily loaded JSON store.
+ *
+ * A status change is patched into the store in place when the task's new record fits its old
+ * one, and rewrites the store otherwise. A hard link to the store tells the two apart: an
+ * AtomicFile replaces the store with a new file, which drops the link count back to one.
+ */
+
+namespace {
+
+    /**
+     * @brief Runs a command the way task-cli would, in a lazily loading manager of its own.
+     */
+    TestSupport::CommandOutput command(const std::string& store, const std::vector<std::string>& arguments) {
+        TaskManager manager(store);
+        manager.setDurability(Durability::NONE);
+        manager.setLazyLoading(true);
+        manager.loadTasksFromStore();
+        return TestSupport::run(manager, arguments);
+    }
+
+    /**
+     * @brief Gets the status of a task as loaded from the store, or TaskStatus::UNKNOWN if it is gone.
+     */
+    TaskStatus statusOf(const std::string& store, int id) {
+        TaskManager manager(store);
+        manager.setLazyLoading(true);
+        manager.loadTasksFromStore();
+        auto task = manager.findTaskView(id);
+        return task ? task->getStatus() : TaskStatus::UNKNOWN;
+    }
+
+    /**
+     * @brief Runs a command and checks whether it patched the store in place or rewrote it.
+     * @param link A hard link to the store, re-created after a rewrite.
+     */
+    void checkSaved(const std::string& store, const std::string& link, const std::vector<std::string>& arguments, bool inPlace) {
+        std::uintmax_t size = std::filesystem::file_size(store);
+        CHECK(command(store, arguments).code == 0);
+        CHECK((std::filesystem::hard_link_count(store) == 2) == inPlace);
+        if(inPlace) CHECK(std::filesystem::file_size(store) == size);
+        std::filesystem::remove(link);
+        std::filesystem::create_hard_link(store, link);
+    }
+
+}
+
+int main() {
+    TestSupport::ScratchDirectory directory("delete-restore-test");
+    const std::string store = directory.path("tasks.json");
+    const std::string link = directory.path("link.json");
+    {
+        TaskManager manager(store);
+        manager.setDurability(Durability::NONE);
+        manager.loadTasksFromStore();
+        for(int id = 2; id <= 30; ++id) {
+            manager.emplaceTask(id, "task " + std::to_string(id), static_cast<TaskStatus>(id % 3), 1'700'000'000, 1'700'000'000);
+        }
+        manager.saveTasksToStore();
+    }
+    std::filesystem::create_hard_link(store, link);
+
+    // "in_progress" is longer than "deleted", which is longer than "todo" and "done"
+    checkSaved(store, link, {"delete", "4"}, true);
+    CHECK(statusOf(store, 4) == TaskStatus::DELETED);
+    checkSaved(store, link, {"restore", "4"}, true);
+    CHECK(statusOf(store, 4) == TaskStatus::TODO);
+    checkSaved(store, link, {"mark-done", "3"}, true);
+    CHECK(statusOf(store, 3) == TaskStatus::DONE);
+
+    // A tombstone that outgrows the record rewrites the store; restoring it patches again
+    checkSaved(store, link, {"delete", "3"}, false);
+    CHECK(statusOf(store, 3) == TaskStatus::DELETED);
+    checkSaved(store, link, {"delete", "5"}, false);
+    checkSaved(store, link, {"restore", "3"}, true);
+    CHECK(statusOf(store, 3) == TaskStatus::TODO);
+    checkSaved(store, link, {"restore", "5", "done"}, true);
+    CHECK(statusOf(store, 5) == TaskStatus::DONE);
+    checkSaved(store, link, {"delete", "7"}, true);
+    checkSaved(store, link, {"restore", "7", "in-progress"}, true); // the patched record kept its old length
+    CHECK(statusOf(store, 7) == TaskStatus::IN_PROGRESS);
+    CHECK(command(store, {"restore", "8"}).code == 1);
+    for(const std::vector<std::string>& arguments : std::vector<std::vector<std::string>>{
+            {"update", "7x", "description"}, {"delete", "7x"}, {"restore", "7x"}, {"mark-done", "7x"}}) {
+        TestSupport::CommandOutput invalid = command(store, arguments);
+        CHECK(invalid.code == 1);
+        CHECK(invalid.err == "Invalid id: 7x\n");
+    }
+
+    // Added tasks are appended in place, and their deletes patch or rewrite like any other
+    CHECK(command(store, {"add", "appended"}).code == 0);
+    CHECK(std::filesystem::hard_link_count(store) == 2);
+    checkSaved(store, link, {"mark-in-progress", "31"}, false);
+    checkSaved(store, link, {"delete", "31"}, true);
+    checkSaved(store, link, {"delete", "10"}, true);
+    CHECK(statusOf(store, 31) == TaskStatus::DELETED);
+
+    // An index rebuilt from the patched store locates the same records
+    std::filesystem::remove(store + ".idx");
+    CHECK(statusOf(store, 3) == TaskStatus::TODO);
+    CHECK(statusOf(store, 10) == TaskStatus::DELETED);
+    CHECK(statusOf(store, 31) == TaskStatus::DELETED);
+    CHECK(statusOf(store, 30) == TaskStatus::TODO);
+    CHECK(command(store, {"list", "deleted", "--format", "tsv"}).out.find("\n10\tdeleted\ttask 10\t") != std::string::npos);
+
+    // Compacting drops the tombstones for good
+    CHECK(command(store, {"compact"}).code == 0);
+    CHECK(statusOf(store, 10) == TaskStatus::UNKNOWN);
+    CHECK(statusOf(store, 31) == TaskStatus::UNKNOWN);
+    CHECK(statusOf(store, 5) == TaskStatus::DONE);
+    CHECK(statusOf(store, 7) == TaskStatus::IN_PROGRESS);
+    CHECK(command(store, {"restore", "10"}).code == 1);
+    CHECK(command(store, {"status-stats"}).out.find("Deleted: 0\n") != std::string::npos);
+
+    return TestSupport::result();
+}
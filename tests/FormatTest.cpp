@@ -0,0 +1,89 @@
+#include "TestSupport.h"
+#include "core/TaskManager.h"
+#include <string>
+#include <vector>
+
+/**
+ * @file FormatTest.cpp
+ * @brief Checks the human, jsonl and tsv output of `list --format`, on a manager and on a table.
+ *
+ * Descriptions carry tabs, newlines, carriage returns, backslashes and quotes. Human output must
+ * match TaskView::toString(), jsonl output the store's encoding, and tsv output must escape
+ * them so every task stays on one line of five tab-separated fields.
+ */
+
+namespace {
+
+    /**
+     * @brief Checks every format of a list command on a manager or a table.
+     * @param target The TaskManager or TaskTable to list.
+     * @param manager The manager holding the same tasks, for the expected human output.
+     */
+    template <typename Target>
+    void checkFormats(Target& target, const TaskManager& manager) {
+        std::string human;
+        manager.forEachTask([&human](const TaskView& task) {
+            if(task.getStatus() != TaskStatus::DELETED) human += task.toString() + "\n";
+        });
+        TestSupport::CommandOutput output = TestSupport::run(target, {"list"});
+        CHECK(output.code == 0);
+        CHECK(output.out == human);
+        CHECK(TestSupport::run(target, {"list", "--format", "human"}).out == human);
+
+        output = TestSupport::run(target, {"list", "--format", "jsonl"});
+        CHECK(output.code == 0);
+        CHECK(output.out ==
+              "{\"id\":1,\"description\":\"Created Store\",\"status\":\"todo\",\"createdAt\":0,\"updatedAt\":0}\n"
+              "{\"id\":2,\"description\":\"Tab\\there\",\"status\":\"todo\",\"createdAt\":100,\"updatedAt\":200}\n"
+              "{\"id\":3,\"description\":\"Line\\nbreak\\r\\nand \\\\ \\\"quoted\\\"\",\"status\":\"in_progress\",\"createdAt\":300,\"updatedAt\":400}\n"
+              "{\"id\":4,\"description\":\"Plain\",\"status\":\"done\",\"createdAt\":500,\"updatedAt\":600}\n");
+
+        output = TestSupport::run(target, {"list", "--format", "tsv"});
+        CHECK(output.code == 0);
+        CHECK(output.out ==
+              "id\tstatus\tdescription\tcreatedAt\tupdatedAt\n"
+              "1\ttodo\tCreated Store\t0\t0\n"
+              "2\ttodo\tTab\\there\t100\t200\n"
+              "3\tin_progress\tLine\\nbreak\\r\\nand \\\\ \"quoted\"\t300\t400\n"
+              "4\tdone\tPlain\t500\t600\n");
+
+        // Filters and pages apply to every format; the tsv header is printed even with no tasks
+        CHECK(TestSupport::run(target, {"list", "done", "--format", "tsv"}).out ==
+              "id\tstatus\tdescription\tcreatedAt\tupdatedAt\n4\tdone\tPlain\t500\t600\n");
+        CHECK(TestSupport::run(target, {"list", "--sort", "recent", "--limit", "1", "--format", "jsonl"}).out ==
+              "{\"id\":4,\"description\":\"Plain\",\"status\":\"done\",\"createdAt\":500,\"updatedAt\":600}\n");
+        CHECK(TestSupport::run(target, {"list", "--since", "10000", "--format", "tsv"}).out ==
+              "id\tstatus\tdescription\tcreatedAt\tupdatedAt\n");
+        CHECK(TestSupport::run(target, {"list", "--since", "10000", "--format", "jsonl"}).out.empty());
+
+        output = TestSupport::run(target, {"list", "--format", "csv"});
+        CHECK(output.code == 1);
+        CHECK(output.out.empty());
+        CHECK(output.err.find("Unknown output format") != std::string::npos);
+        CHECK(TestSupport::run(target, {"list", "--format"}).code == 1);
+    }
+
+}
+
+int main() {
+    TestSupport::ScratchDirectory directory("format-test");
+    const std::string store = directory.path("tasks.json");
+    TaskManager manager(store);
+    manager.setDurability(Durability::NONE);
+    manager.loadTasksFromStore();
+    manager.emplaceTask(2, "Tab\there", TaskStatus::TODO, 100, 200);
+    manager.emplaceTask(3, "Line\nbreak\r\nand \\ \"quoted\"", TaskStatus::IN_PROGRESS, 300, 400);
+    manager.emplaceTask(4, "Plain", TaskStatus::DONE, 500, 600);
+    manager.emplaceTask(5, "Deleted\ttask", TaskStatus::DELETED, 700, 800);
+
+    checkFormats(manager, manager);
+    checkFormats(manager.getTable(), manager);
+
+    // Tasks loaded back from the store print the same
+    manager.saveTasksToStore();
+    TaskManager reloaded(store);
+    reloaded.loadTasksFromStore();
+    checkFormats(reloaded, reloaded);
+
+    return TestSupport::result();
+}
@@ -0,0 +1,128 @@
+#include "TestSupport.h"
+#include "core/TaskManager.h"
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @file PagingTest.cpp
+ * @brief Checks that `list` pages, fetched with --after cursors or with --offset, add up to the full list.
+ *
+ * Update times are drawn from a handful of values, so most tasks tie with others and cursors in
+ * the updated and recent orders have to break ties by ID. Every order, several filters and page
+ * sizes are walked on a TaskManager (answered by its secondary indexes) and on its TaskTable.
+ */
+
+namespace {
+
+    /**
+     * @brief Runs a list command in tsv format.
+     * @param target The TaskManager or TaskTable to list.
+     * @param arguments The options after "list".
+     * @param next Receives the cursor printed for the next page, or an empty string.
+     * @return The listed IDs, in output order.
+     */
+    template <typename Target>
+    std::vector<int> list(Target& target, std::vector<std::string> arguments, std::string& next) {
+        arguments.insert(arguments.begin(), "list");
+        arguments.insert(arguments.end(), {"--format", "tsv"});
+        TestSupport::CommandOutput output = TestSupport::run(target, arguments);
+        CHECK(output.code == 0);
+
+        std::vector<int> ids;
+        std::size_t line = output.out.find('\n');
+        while(line != std::string::npos && line + 1 < output.out.size()) {
+            ids.push_back(std::stoi(output.out.substr(line + 1)));
+            line = output.out.find('\n', line + 1);
+        }
+        const std::string marker = "Next page: --after ";
+        std::size_t at = output.err.find(marker);
+        next = at == std::string::npos ? "" : output.err.substr(at + marker.size(), output.err.find('\n', at) - at - marker.size());
+        return ids;
+    }
+
+    /**
+     * @brief Walks every page of a query both ways and compares them with the unpaged list.
+     * @param target The TaskManager or TaskTable to list.
+     * @param query The filter and sort options.
+     * @param size The page size.
+     */
+    template <typename Target>
+    void checkPages(Target& target, const std::vector<std::string>& query, std::size_t size) {
+        std::string next;
+        const std::vector<int> all = list(target, query, next);
+        CHECK(next.empty());
+
+        std::vector<int> byCursor;
+        std::vector<std::string> arguments = query;
+        arguments.insert(arguments.end(), {"--limit", std::to_string(size)});
+        for(std::size_t pages = 0; pages <= all.size() + 1; ++pages) {
+            std::vector<int> page = list(target, arguments, next);
+            CHECK(page.size() <= size);
+            byCursor.insert(byCursor.end(), page.begin(), page.end());
+            if(next.empty()) break;
+            arguments = query;
+            arguments.insert(arguments.end(), {"--limit", std::to_string(size), "--after", next});
+        }
+        CHECK(byCursor == all);
+
+        std::vector<int> byOffset;
+        for(std::size_t offset = 0;; offset += size) {
+            arguments = query;
+            arguments.insert(arguments.end(), {"--limit", std::to_string(size), "--offset", std::to_string(offset)});
+            std::vector<int> page = list(target, arguments, next);
+            byOffset.insert(byOffset.end(), page.begin(), page.end());
+            if(page.size() < size || offset > all.size()) break;
+        }
+        CHECK(byOffset == all);
+    }
+
+    template <typename Target>
+    void checkAllPages(Target& target) {
+        for(const char* sort : {"id", "updated", "recent"}) {
+            for(std::vector<std::string> filter : {std::vector<std::string>{}, std::vector<std::string>{"done"},
+                                                   std::vector<std::string>{"deleted"},
+                                                   std::vector<std::string>{"--since", "1001", "--until", "1004"}}) {
+                filter.insert(filter.end(), {"--sort", sort});
+                for(std::size_t size : {1, 7, 64}) checkPages(target, filter, size);
+            }
+        }
+    }
+
+}
+
+int main() {
+    TestSupport::ScratchDirectory directory("paging-test");
+    TaskManager manager(directory.path("tasks.json"));
+    manager.setDurability(Durability::NONE);
+    manager.loadTasksFromStore();
+    std::mt19937 random(23);
+    for(int id = 2; id <= 400; ++id) {
+        manager.emplaceTask(id, "task " + std::to_string(id), static_cast<TaskStatus>(random() % 3), 0,
+                            static_cast<std::time_t>(1'000 + random() % 6));
+    }
+    for(int id = 5; id <= 400; id += 11) manager.deleteTask(id, static_cast<std::time_t>(1'000 + random() % 6));
+
+    checkAllPages(manager);
+    checkAllPages(manager.getTable());
+
+    // A cursor is a position: tasks removed before it or added after it neither shift nor repeat the next page
+    std::string next;
+    std::vector<int> all = list(manager, {"--sort", "updated"}, next);
+    std::vector<int> first = list(manager, {"--sort", "updated", "--limit", "50"}, next);
+    CHECK(!next.empty());
+    manager.removeTask(first[3]);
+    manager.removeTask(first[20]);
+    manager.emplaceTask(manager.nextId(), "latest", TaskStatus::TODO, 0, 2'000);
+    all.push_back(manager.nextId() - 1);
+    std::vector<int> rest = list(manager, {"--sort", "updated", "--after", next}, next);
+    CHECK(rest == std::vector<int>(all.begin() + 50, all.end()));
+
+    // A cursor only fits the order it was printed for
+    list(manager, {"--sort", "recent", "--limit", "5"}, next);
+    CHECK(TestSupport::run(manager, {"list", "--sort", "id", "--after", next}).code == 1);
+    CHECK(TestSupport::run(manager, {"list", "--sort", "recent", "--after", next}).code == 0);
+    CHECK(TestSupport::run(manager, {"list", "--after", "u12"}).code == 1);
+
+    return TestSupport::result();
+}
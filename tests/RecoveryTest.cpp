@@ -0,0 +1,120 @@
+#include "TestSupport.h"
+#include "core/TaskManager.h"
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/**
+ * @file RecoveryTest.cpp
+ * @brief Checks that a lazily loaded JSON store survives an in-place patch interrupted by a crash.
+ *
+ * Before patching the store, a save writes the bytes it overwrites to <store>.undo and removes
+ * that record once the patch is flushed. A crash in between is simulated by damaging the store
+ * and leaving an undo record behind, in the same layout: the old store size, then the offset,
+ * length and old bytes of each region, as native 64-bit integers.
+ */
+
+namespace {
+
+    std::string contents(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    void overwrite(const std::string& path, const std::string& bytes) {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << bytes;
+    }
+
+    std::string number(std::uint64_t value) { return std::string(reinterpret_cast<const char*>(&value), sizeof(value)); }
+
+    TaskManager& load(TaskManager& manager) {
+        manager.setDurability(Durability::NONE);
+        manager.setLazyLoading(true);
+        manager.loadTasksFromStore();
+        return manager;
+    }
+
+}
+
+int main() {
+    TestSupport::ScratchDirectory directory("recovery-test");
+    const std::string store = directory.path("tasks.json");
+    const std::string undo = store + ".undo";
+
+    // A missing store is created whole, with nothing left next to it
+    {
+        TaskManager manager(store);
+        load(manager);
+        CHECK(manager.findTaskView(1).has_value());
+    }
+    CHECK(!std::filesystem::exists(undo));
+    for(const auto& entry : std::filesystem::directory_iterator(std::filesystem::path(store).parent_path())) {
+        CHECK(entry.path().filename().string().find(".tmp") == std::string::npos);
+    }
+
+    {
+        TaskManager manager(store);
+        manager.setDurability(Durability::NONE);
+        manager.loadTasksFromStore();
+        for(int id = 2; id <= 50; ++id) manager.emplaceTask(id, "task " + std::to_string(id), TaskStatus::TODO, 10, 10);
+        manager.saveTasksToStore();
+    }
+
+    // A save that completes patches in place and removes its undo record
+    {
+        TaskManager manager(store);
+        CHECK(load(manager).setStatus(7, TaskStatus::DONE, 20));
+        manager.addTask(Task(manager.nextId(), "appended", TaskStatus::TODO, 30, 30));
+        manager.saveTasksToStore();
+    }
+    CHECK(!std::filesystem::exists(undo));
+    const std::string saved = contents(store);
+
+    // A patch torn halfway: one region overwritten, garbage appended past the old end
+    std::string torn = saved;
+    const std::size_t region = saved.find("\"id\":20,");
+    torn.replace(region, 12, "############");
+    torn += ", {\"id\":99,\"descr";
+    overwrite(store, torn);
+    overwrite(undo, number(saved.size()) + number(region) + number(12) + saved.substr(region, 12));
+
+    {
+        TaskManager manager(store);
+        load(manager);
+        CHECK(contents(store) == saved);
+        CHECK(!std::filesystem::exists(undo));
+        CHECK(manager.findTaskView(20).has_value());
+        CHECK(manager.findTaskView(7)->getStatus() == TaskStatus::DONE);
+        CHECK(manager.findTaskView(51)->getDescription() == "appended");
+        CHECK(!manager.findTaskView(99).has_value());
+
+        // A save that finds a record left by another process rolls it back before writing
+        overwrite(store, torn);
+        overwrite(undo, number(saved.size()) + number(region) + number(12) + saved.substr(region, 12));
+        CHECK(manager.setStatus(8, TaskStatus::IN_PROGRESS, 40));
+        manager.saveTasksToStore();
+        CHECK(!std::filesystem::exists(undo));
+    }
+    TaskManager reloaded(store);
+    reloaded.loadTasksFromStore();
+    CHECK(reloaded.getTasks().size() == 51);
+    CHECK(reloaded.findTaskView(8)->getStatus() == TaskStatus::IN_PROGRESS);
+    CHECK(reloaded.findTaskView(20)->getDescription() == "task 20");
+
+    // A malformed record is reported instead of being applied
+    overwrite(undo, "xx");
+    bool threw = false;
+    try {
+        TaskManager manager(store);
+        load(manager);
+    } catch(const std::runtime_error&) {
+        threw = true;
+    }
+    CHECK(threw);
+
+    return TestSupport::result();
+}
@@ -0,0 +1,78 @@
+#include "TestSupport.h"
+#include "core/TaskManager.h"
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+/**
+ * @file SaveTest.cpp
+ * @brief Checks that JSON snapshots encoded on several threads are byte-identical to sequential ones.
+ *
+ * The store holds more than PARALLEL_SAVE_THRESHOLD tasks, so exporting it with more than one
+ * save thread takes the batched parallel path, including a last batch shorter than the others.
+ * Descriptions carry quotes, backslashes, tabs and newlines so escaping is covered as well.
+ */
+
+namespace {
+
+    std::string contents(const std::string& path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    /**
+     * @brief Exports a JSON snapshot of a manager's tasks with the given number of save threads.
+     * @return The bytes of the snapshot.
+     */
+    std::string snapshot(TaskManager& manager, const std::string& path, std::size_t threads) {
+        manager.setSaveThreads(threads);
+        manager.exportStore(path, StoreFormat::JSON);
+        return contents(path);
+    }
+
+}
+
+int main() {
+    TestSupport::ScratchDirectory directory("save-test");
+    const std::string store = directory.path("tasks.json");
+    const int count = static_cast<int>(TaskManager::PARALLEL_SAVE_THRESHOLD + TaskManager::PARALLEL_SAVE_BATCH / 2 + 123);
+    {
+        TaskManager manager(store);
+        manager.setDurability(Durability::NONE);
+        manager.setSaveThreads(1);
+        manager.loadTasksFromStore();
+        for(int id = 2; id <= count; ++id) {
+            std::string description = "Task \"" + std::to_string(id) + "\"\twith a \\ and\na line break";
+            manager.emplaceTask(id, description, static_cast<TaskStatus>(id % 3), id, id * 7);
+        }
+        for(int id = 10; id <= count; id += 97) manager.deleteTask(id, 1);
+        manager.saveTasksToStore();
+    }
+
+    TaskManager manager(store);
+    manager.setDurability(Durability::NONE);
+    manager.loadTasksFromStore();
+    const std::string sequential = snapshot(manager, directory.path("sequential.json"), 1);
+    CHECK(sequential == contents(store));
+    for(std::size_t threads : {2, 3, 4, 16, 0}) {
+        std::string path = directory.path("parallel-" + std::to_string(threads) + ".json");
+        CHECK(snapshot(manager, path, threads) == sequential);
+    }
+
+    // A parallel snapshot reloads to the same tasks
+    TaskManager reloaded(directory.path("parallel-4.json"));
+    reloaded.loadTasksFromStore();
+    std::size_t tasks = 0;
+    bool same = true;
+    reloaded.forEachTask([&](const TaskView& task) {
+        ++tasks;
+        if(task.getId() == 1) return;
+        std::string description = "Task \"" + std::to_string(task.getId()) + "\"\twith a \\ and\na line break";
+        same = same && task.getDescription() == description && task.getCreatedAt() == task.getId();
+    });
+    CHECK(same);
+    CHECK(tasks == static_cast<std::size_t>(count));
+
+    return TestSupport::result();
+}
@@ -0,0 +1,119 @@
+#include "TestSupport.h"
+#include "core/StoreLock.h"
+#include "core/TaskManager.h"
+#include "core/TextIndex.h"
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/**
+ * @file SearchTest.cpp
+ * @brief Checks `search` and its persisted text index as tasks are added, updated, deleted and restored.
+ *
+ * Each command runs in a fresh, lazily loading TaskManager, like a separate task-cli process, so
+ * searches read the index other "processes" committed. The index must stay current after every
+ * save without being rebuilt: a hard link to the index file keeps pointing at the same file as
+ * long as commits append to it instead of replacing it.
+ */
+
+namespace {
+
+    /**
+     * @brief Runs a command the way task-cli would, in a manager of its own.
+     */
+    TestSupport::CommandOutput command(const std::string& store, const std::vector<std::string>& arguments) {
+        TaskManager manager(store);
+        manager.setDurability(Durability::NONE);
+        manager.setLazyLoading(true);
+        manager.loadTasksFromStore();
+        return TestSupport::run(manager, arguments);
+    }
+
+    /**
+     * @brief Gets the IDs printed by a search, in output order.
+     */
+    std::vector<int> search(const std::string& store, const std::string& query) {
+        std::vector<int> ids;
+        std::string out = command(store, {"search", query}).out;
+        for(std::size_t at = out.find("id: "); at != std::string::npos; at = out.find("id: ", at + 1)) {
+            ids.push_back(std::stoi(out.substr(at + 4)));
+        }
+        return ids;
+    }
+
+    /**
+     * @brief Checks whether the store's text index is up to date, so a search would not rebuild it.
+     */
+    bool indexCurrent(const std::string& store) {
+        StoreLock lock(store + ".lock");
+        StoreLock::Scope scope(lock, StoreLock::Mode::SHARED);
+        TextIndex index;
+        return index.open(store, lock.version());
+    }
+
+}
+
+int main() {
+    TestSupport::ScratchDirectory directory("search-test");
+    const std::string store = directory.path("tasks.json");
+    const std::string indexFile = store + ".fts";
+    {
+        TaskManager manager(store);
+        manager.setDurability(Durability::NONE);
+        manager.loadTasksFromStore();
+        manager.emplaceTask(2, "Quarterly report draft", TaskStatus::TODO, 0, 0);
+        manager.emplaceTask(3, "Review budget", TaskStatus::TODO, 0, 0);
+        manager.emplaceTask(4, "Email the report to the client", TaskStatus::DONE, 0, 0);
+        for(int id = 5; id < 1'000; ++id) manager.emplaceTask(id, "Filler " + std::to_string(id), TaskStatus::TODO, 0, 0);
+        manager.saveTasksToStore();
+    }
+
+    // The first search builds and commits the index
+    CHECK(!TextIndex::exists(store));
+    CHECK(search(store, "report") == std::vector<int>({2, 4}));
+    CHECK(TextIndex::exists(store));
+    CHECK(indexCurrent(store));
+    CHECK(search(store, "REPORT client") == std::vector<int>({4}));
+    CHECK(search(store, "rep*") == std::vector<int>({2, 4}));
+    CHECK(search(store, "budget OR client") == std::vector<int>({3, 4}));
+
+    // Later saves append to the index instead of rewriting it
+    std::filesystem::create_hard_link(indexFile, directory.path("index-link"));
+
+    CHECK(command(store, {"update", "2", "Quarterly summary draft"}).code == 0);
+    CHECK(indexCurrent(store));
+    CHECK(search(store, "report") == std::vector<int>({4}));
+    CHECK(search(store, "summary") == std::vector<int>({2}));
+    CHECK(search(store, "draft") == std::vector<int>({2}));
+
+    CHECK(command(store, {"delete", "4"}).code == 0);
+    CHECK(indexCurrent(store));
+    CHECK(search(store, "report").empty());
+    CHECK(search(store, "email").empty());
+
+    CHECK(command(store, {"restore", "4"}).code == 0);
+    CHECK(search(store, "email") == std::vector<int>({4}));
+
+    CHECK(command(store, {"add", "Another report"}).code == 0);
+    CHECK(indexCurrent(store));
+    CHECK(search(store, "report") == std::vector<int>({4, 1'000}));
+
+    CHECK(std::filesystem::hard_link_count(indexFile) == 2);
+
+    // Changes not saved yet are searched as well
+    {
+        TaskManager manager(store);
+        manager.setDurability(Durability::NONE);
+        manager.setLazyLoading(true);
+        manager.loadTasksFromStore();
+        CHECK(manager.updateDescription(3, "Review the report budget", 1));
+        std::vector<int> ids;
+        for(const TaskView& task : manager.searchTasks("report")) ids.push_back(task.getId());
+        CHECK(ids == std::vector<int>({3, 4, 1'000}));
+        manager.saveTasksToStore();
+    }
+    CHECK(search(store, "report") == std::vector<int>({3, 4, 1'000}));
+    CHECK(indexCurrent(store));
+
+    return TestSupport::result();
+}
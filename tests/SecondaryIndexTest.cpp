@@ -0,0 +1,106 @@
+#include "TestSupport.h"
+#include "core/TaskManager.h"
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @file SecondaryIndexTest.cpp
+ * @brief Checks TaskManager::queryTasks() against a full scan while tasks change.
+ *
+ * The status and updatedAt indexes are built by the first query and then maintained by every
+ * mutation, so each round of random adds, updates, status changes, soft deletes, restores and
+ * removals is followed by the same queries through the indexes and through a scan of all tasks.
+ */
+
+namespace {
+
+    std::vector<int> ids(const std::vector<TaskView>& views) {
+        std::vector<int> result;
+        for(const TaskView& view : views) result.push_back(view.getId());
+        return result;
+    }
+
+    /**
+     * @brief Runs a set of queries through the indexes and compares them with a full scan.
+     */
+    void checkQueries(const TaskManager& manager) {
+        std::vector<TaskView> all;
+        manager.forEachTask([&all](const TaskView& task) { all.push_back(task); });
+
+        for(TaskOrder order : {TaskOrder::ID, TaskOrder::UPDATED, TaskOrder::RECENT}) {
+            for(std::optional<TaskStatus> status : {std::optional<TaskStatus>(), std::optional(TaskStatus::TODO),
+                                                    std::optional(TaskStatus::IN_PROGRESS), std::optional(TaskStatus::DONE),
+                                                    std::optional(TaskStatus::DELETED)}) {
+                TaskQuery query;
+                query.order = order;
+                query.filter.status = status;
+                CHECK(ids(manager.queryTasks(query)) == TestSupport::expectedIds(all, query));
+
+                query.filter.updatedFrom = 1'000;
+                query.filter.updatedUntil = 1'400;
+                CHECK(ids(manager.queryTasks(query)) == TestSupport::expectedIds(all, query));
+
+                query.limit = 25;
+                query.offset = 10;
+                CHECK(ids(manager.queryTasks(query)) == TestSupport::expectedIds(all, query));
+
+                query.offset = 0;
+                query.after = TaskCursor{1'200, 1'500};
+                CHECK(ids(manager.queryTasks(query)) == TestSupport::expectedIds(all, query));
+            }
+        }
+    }
+
+}
+
+int main() {
+    TestSupport::ScratchDirectory directory("secondary-index-test");
+    const std::string store = directory.path("tasks.json");
+    std::mt19937 random(15);
+    auto randomTime = [&random] { return static_cast<std::time_t>(1'000 + random() % 500); };
+
+    TaskManager manager(store);
+    manager.setDurability(Durability::NONE);
+    manager.loadTasksFromStore();
+    for(int id = 2; id <= 3'000; ++id) {
+        manager.emplaceTask(id, "task " + std::to_string(id), static_cast<TaskStatus>(id % 3), 0, randomTime());
+    }
+    checkQueries(manager);
+
+    for(int round = 0; round < 10; ++round) {
+        for(int i = 0; i < 300; ++i) {
+            int id = static_cast<int>(random() % 3'200) + 1;
+            switch(random() % 6) {
+                case 0: manager.setStatus(id, static_cast<TaskStatus>(random() % 3), randomTime()); break;
+                case 1: manager.updateDescription(id, "updated " + std::to_string(i), randomTime()); break;
+                case 2: manager.deleteTask(id, randomTime()); break;
+                case 3: manager.restoreTask(id, TaskStatus::TODO, randomTime()); break;
+                case 4: manager.removeTask(id); break;
+                default: manager.emplaceTask(manager.nextId(), "added", TaskStatus::TODO, 0, randomTime());
+            }
+        }
+        checkQueries(manager);
+    }
+
+    // Indexes built from the saved store answer the same as the ones maintained along the way
+    manager.saveTasksToStore();
+    TaskManager reloaded(store);
+    reloaded.loadTasksFromStore();
+    for(TaskOrder order : {TaskOrder::ID, TaskOrder::UPDATED, TaskOrder::RECENT}) {
+        TaskQuery query;
+        query.order = order;
+        query.filter.status = TaskStatus::DONE;
+        CHECK(ids(reloaded.queryTasks(query)) == ids(manager.queryTasks(query)));
+    }
+    checkQueries(reloaded);
+
+    // Purging tombstones drops them from the DELETED index too
+    manager.purgeDeletedTasks();
+    TaskQuery deleted;
+    deleted.filter.status = TaskStatus::DELETED;
+    CHECK(manager.queryTasks(deleted).empty());
+    checkQueries(manager);
+
+    return TestSupport::result();
+}
@@ -0,0 +1,99 @@
+#include "TestSupport.h"
+#include "core/TaskManager.h"
+#include <string>
+
+/**
+ * @file StatusStatsTest.cpp
+ * @brief Checks the per-status counts printed by `status-stats`, and the task counts of `stats`.
+ *
+ * The counts come from a scan of the tasks on a TaskManager and from the status column on a
+ * TaskTable; both must agree with each other, after deletes and restores, and on a lazily loaded
+ * JSON store and a memory-mapped binary store. `stats` must count deleted tasks apart from the
+ * live ones.
+ */
+
+namespace {
+
+    std::string counts(std::size_t todo, std::size_t inProgress, std::size_t done, std::size_t deleted) {
+        return "Todo: " + std::to_string(todo) + "\nIn progress: " + std::to_string(inProgress) +
+               "\nDone: " + std::to_string(done) + "\nDeleted: " + std::to_string(deleted) +
+               "\nTotal: " + std::to_string(todo + inProgress + done + deleted) + "\n";
+    }
+
+    /**
+     * @brief Prints the counts of a manager and of its table, which must be the same.
+     */
+    std::string statusStats(TaskManager& manager) {
+        TestSupport::CommandOutput managed = TestSupport::run(manager, {"status-stats"});
+        TestSupport::CommandOutput table = TestSupport::run(manager.getTable(), {"status-stats"});
+        CHECK(managed.code == 0);
+        CHECK(table.code == 0);
+        CHECK(managed.out == table.out);
+        return managed.out;
+    }
+
+    /**
+     * @brief Prints the task count lines of `stats`.
+     */
+    std::string taskCounts(TaskManager& manager) {
+        TestSupport::CommandOutput output = TestSupport::run(manager, {"stats"});
+        CHECK(output.code == 0);
+        return output.out.substr(0, output.out.find("Arena Used: "));
+    }
+
+    /**
+     * @brief Loads a store in a fresh, lazily loading manager and prints its counts.
+     */
+    std::string reloaded(const std::string& store) {
+        TaskManager manager(store);
+        manager.setLazyLoading(true);
+        manager.loadTasksFromStore();
+        TestSupport::CommandOutput output = TestSupport::run(manager, {"status-stats"});
+        CHECK(output.code == 0);
+        return output.out;
+    }
+
+}
+
+int main() {
+    TestSupport::ScratchDirectory directory("status-stats-test");
+    const std::string store = directory.path("tasks.json");
+    TaskManager manager(store);
+    manager.setDurability(Durability::NONE);
+    manager.loadTasksFromStore();
+
+    // A new store holds the one "Created Store" task
+    CHECK(statusStats(manager) == counts(1, 0, 0, 0));
+
+    for(int id = 2; id <= 1'000; ++id) manager.emplaceTask(id, "task " + std::to_string(id), static_cast<TaskStatus>(id % 3), 0, 0);
+    CHECK(statusStats(manager) == counts(334, 333, 333, 0));
+
+    for(int id = 4; id <= 1'000; id += 3) manager.deleteTask(id, 1);
+    CHECK(statusStats(manager) == counts(334, 0, 333, 333));
+    CHECK(taskCounts(manager) == "Tasks: 667\nDeleted: 333\n");
+
+    CHECK(manager.restoreTask(4, TaskStatus::DONE, 2));
+    CHECK(manager.setStatus(2, TaskStatus::IN_PROGRESS, 2));
+    CHECK(statusStats(manager) == counts(334, 1, 333, 332));
+
+    manager.saveTasksToStore();
+    CHECK(reloaded(store) == statusStats(manager));
+    manager.exportStore(directory.path("tasks.bin"), StoreFormat::BINARY);
+    CHECK(reloaded(directory.path("tasks.bin")) == statusStats(manager));
+
+    // Unknown is only listed when some task has that status
+    manager.emplaceTask(manager.nextId(), "unrecognized", TaskStatus::UNKNOWN, 0, 0);
+    std::string withUnknown = counts(334, 1, 333, 332);
+    withUnknown.insert(withUnknown.find("Total: "), "Unknown: 1\n");
+    withUnknown.replace(withUnknown.find("Total: 1000"), 11, "Total: 1001");
+    CHECK(statusStats(manager) == withUnknown);
+
+    // Purged tombstones are no longer counted
+    manager.purgeDeletedTasks();
+    withUnknown.replace(withUnknown.find("Deleted: 332"), 12, "Deleted: 0");
+    withUnknown.replace(withUnknown.find("Total: 1001"), 11, "Total: 669");
+    CHECK(statusStats(manager) == withUnknown);
+    CHECK(taskCounts(manager) == "Tasks: 669\nDeleted: 0\n");
+
+    return TestSupport::result();
+}
@@ -0,0 +1,125 @@
+#include "TestSupport.h"
+#include "core/Task.h"
+#include "core/TaskTable.h"
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @file TaskTableTest.cpp
+ * @brief Checks TaskTable against a std::map of tasks through random mutations and queries.
+ *
+ * Mutations insert in the middle (splitting chunks), replace, soft-delete and erase rows. Copies
+ * taken along the way must keep showing the tasks as they were when copied, however the table
+ * changes afterwards, since the daemon's published snapshots share chunks with the live table.
+ */
+
+namespace {
+
+    using Reference = std::map<int, Task>;
+
+    /**
+     * @brief Checks that a table holds exactly the reference tasks, in ID order.
+     */
+    bool same(const TaskTable& table, const Reference& reference) {
+        if(table.size() != reference.size()) return false;
+        std::size_t r = 0;
+        for(const auto& [id, task] : reference) {
+            TaskView row = table.row(r++);
+            if(row.getId() != id || row.getDescription() != task.getDescription() || row.getStatus() != task.getStatus() ||
+               row.getCreatedAt() != task.getCreatedAt() || row.getUpdatedAt() != task.getUpdatedAt()) {
+                return false;
+            }
+            if(table.find(id) != r - 1) return false;
+        }
+        return true;
+    }
+
+    std::vector<int> expected(const Reference& reference, const TaskQuery& query) {
+        std::vector<TaskView> tasks;
+        for(const auto& [id, task] : reference) tasks.emplace_back(task);
+        return TestSupport::expectedIds(tasks, query);
+    }
+
+    std::vector<int> actual(const TaskTable& table, const TaskQuery& query) {
+        std::vector<int> ids;
+        for(std::size_t r : table.query(query)) ids.push_back(table.row(r).getId());
+        return ids;
+    }
+
+}
+
+int main() {
+    std::mt19937 random(7);
+    TaskTable table;
+    Reference reference;
+    std::vector<std::pair<TaskTable, Reference>> snapshots;
+
+    auto put = [&](int id, TaskStatus status, std::time_t updatedAt) {
+        Task task(id, "task " + std::to_string(id) + std::string(random() % 40, 'x'), status, id, updatedAt);
+        table.upsert(task);
+        reference.insert_or_assign(id, task);
+    };
+
+    // Every other ID first, so the rest land in the middle of full chunks and split them
+    for(int id = 2; id <= 40'000; id += 2) put(id, static_cast<TaskStatus>(id % 3), id % 500);
+    CHECK(same(table, reference));
+    CHECK(table.chunkCount() > 1);
+    for(int id = 1; id <= 40'000; id += 2) put(id, static_cast<TaskStatus>(id % 3), id % 500);
+    CHECK(same(table, reference));
+
+    for(int round = 0; round < 20; ++round) {
+        snapshots.emplace_back(table, reference);
+        for(int i = 0; i < 500; ++i) {
+            int id = static_cast<int>(random() % 45'000) + 1;
+            switch(random() % 4) {
+                case 0: put(id, TaskStatus::DONE, static_cast<std::time_t>(random() % 500)); break;
+                case 1: put(id, TaskStatus::DELETED, static_cast<std::time_t>(random() % 500)); break;
+                case 2: put(id, TaskStatus::IN_PROGRESS, static_cast<std::time_t>(random() % 500)); break;
+                default:
+                    table.erase(id);
+                    reference.erase(id);
+            }
+        }
+        CHECK(same(table, reference));
+    }
+    for(const auto& [copy, state] : snapshots) CHECK(same(copy, state));
+
+    // Filters, orders, cursors and offsets, on the live table and on a snapshot
+    for(const auto& [subject, state] : {std::pair<const TaskTable&, const Reference&>(table, reference),
+                                        std::pair<const TaskTable&, const Reference&>(snapshots[3].first, snapshots[3].second)}) {
+        for(TaskOrder order : {TaskOrder::ID, TaskOrder::UPDATED, TaskOrder::RECENT}) {
+            for(std::optional<TaskStatus> status : {std::optional<TaskStatus>(), std::optional(TaskStatus::DONE),
+                                                    std::optional(TaskStatus::DELETED)}) {
+                TaskQuery query;
+                query.order = order;
+                query.filter.status = status;
+                CHECK(actual(subject, query) == expected(state, query));
+
+                query.filter.updatedFrom = 100;
+                query.filter.updatedUntil = 200;
+                query.limit = 50;
+                query.offset = 7;
+                CHECK(actual(subject, query) == expected(state, query));
+
+                query.offset = 0;
+                query.after = TaskCursor{150, 20'000};
+                CHECK(actual(subject, query) == expected(state, query));
+            }
+        }
+    }
+
+    // Erasing everything drops every chunk
+    for(auto& [id, task] : Reference(reference)) {
+        table.erase(id);
+        reference.erase(id);
+    }
+    CHECK(table.size() == 0);
+    CHECK(table.chunkCount() == 0);
+    CHECK(table.select({}).empty());
+    for(const auto& [copy, state] : snapshots) CHECK(same(copy, state));
+
+    return TestSupport::result();
+}
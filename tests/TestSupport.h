@@ -0,0 +1,162 @@
+#ifndef TEST_SUPPORT_H
+#define TEST_SUPPORT_H
+
+#include "cli/Commands.h"
+#include "core/TaskTable.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+/**
+ * @file TestSupport.h
+ * @brief Helpers shared by the test executables registered with ctest.
+ *
+ * Each test is a plain executable: CHECK() records failures instead of aborting, so one run
+ * reports every broken expectation, and main() returns TestSupport::result().
+ */
+
+/**
+ * @brief Checks a condition, printing the failing expression and its location when it is false.
+ */
+#define CHECK(condition)                                                                             \
+    do {                                                                                             \
+        if(!(condition)) TestSupport::fail(__FILE__, __LINE__, #condition);                          \
+    } while(false)
+
+namespace TestSupport {
+
+    /**
+     * @brief Gets the number of failed checks so far.
+     */
+    inline int& failures() {
+        static int count = 0;
+        return count;
+    }
+
+    /**
+     * @brief Records a failed check.
+     * @param file The source file of the check.
+     * @param line The line of the check.
+     * @param expression The expression that was false.
+     */
+    inline void fail(const char* file, int line, const char* expression) {
+        ++failures();
+        std::cerr << file << ":" << line << ": check failed: " << expression << std::endl;
+    }
+
+    /**
+     * @brief Gets the exit code of the test: 0 when every check passed, 1 otherwise.
+     */
+    inline int result() {
+        if(failures() != 0) std::cerr << failures() << " check(s) failed" << std::endl;
+        return failures() == 0 ? 0 : 1;
+    }
+
+    /**
+     * @brief Answers a query by filtering and sorting every task, as a reference for the indexed paths.
+     * @param tasks Every task, in any order.
+     * @param query The filter, order and page.
+     * @return The IDs of the tasks the query should return, in order.
+     */
+    inline std::vector<int> expectedIds(std::vector<TaskView> tasks, const TaskQuery& query) {
+        const TaskFilter& filter = query.filter;
+        std::erase_if(tasks, [&filter](const TaskView& task) {
+            if(filter.status ? task.getStatus() != *filter.status : task.getStatus() == TaskStatus::DELETED) return true;
+            if(filter.updatedFrom && task.getUpdatedAt() < *filter.updatedFrom) return true;
+            return filter.updatedUntil && task.getUpdatedAt() >= *filter.updatedUntil;
+        });
+        auto before = [&query](std::time_t updatedA, int idA, std::time_t updatedB, int idB) {
+            if(query.order == TaskOrder::ID) return idA < idB;
+            if(query.order == TaskOrder::UPDATED) return std::make_pair(updatedA, idA) < std::make_pair(updatedB, idB);
+            return std::make_pair(updatedB, idB) < std::make_pair(updatedA, idA);
+        };
+        std::sort(tasks.begin(), tasks.end(), [&before](const TaskView& a, const TaskView& b) {
+            return before(a.getUpdatedAt(), a.getId(), b.getUpdatedAt(), b.getId());
+        });
+        if(query.after) {
+            std::erase_if(tasks, [&](const TaskView& task) {
+                return !before(query.after->updatedAt, query.after->id, task.getUpdatedAt(), task.getId());
+            });
+        }
+        std::vector<int> ids;
+        for(std::size_t i = query.offset; i < tasks.size() && ids.size() < query.limit; ++i) ids.push_back(tasks[i].getId());
+        return ids;
+    }
+
+    /**
+     * @class ScratchDirectory
+     * @brief A fresh directory under the system temp directory, removed with everything in it on destruction.
+     */
+    class ScratchDirectory {
+    private:
+        std::filesystem::path directory; ///< The directory, unique per test name and process.
+    public:
+
+        /**
+         * @brief Creates an empty directory for the named test.
+         * @param name The test name, used in the directory name.
+         */
+        explicit ScratchDirectory(const std::string& name)
+            : directory(std::filesystem::temp_directory_path() / (name + "-" + std::to_string(::getpid()))) {
+            std::filesystem::remove_all(directory);
+            std::filesystem::create_directories(directory);
+        }
+
+        ~ScratchDirectory() {
+            std::error_code ignored;
+            std::filesystem::remove_all(directory, ignored);
+        }
+
+        ScratchDirectory(const ScratchDirectory&) = delete;
+        ScratchDirectory& operator=(const ScratchDirectory&) = delete;
+
+        /**
+         * @brief Gets the path of a file inside the directory.
+         * @param file The file name.
+         */
+        std::string path(const std::string& file) const { return (directory / file).string(); }
+    };
+
+    /**
+     * @struct CommandOutput
+     * @brief What a CLI command returned and printed.
+     */
+    struct CommandOutput {
+        int code = 0;    ///< The command's return value.
+        std::string out; ///< Everything printed to CLI::out().
+        std::string err; ///< Everything printed to CLI::err().
+    };
+
+    /**
+     * @brief Runs a CLI command the way main() would, capturing its output.
+     * @param target A TaskManager or a TaskTable, passed on to CLI::run().
+     * @param arguments The command and its arguments, without the program name.
+     * @note Only usable from tests that link src/cli/Commands.cpp.
+     */
+    template <typename Target>
+    CommandOutput run(Target& target, const std::vector<std::string>& arguments) {
+        std::vector<std::string> storage{"task-cli"};
+        storage.insert(storage.end(), arguments.begin(), arguments.end());
+        std::vector<char*> argv;
+        for(std::string& argument : storage) argv.push_back(argument.data());
+        argv.push_back(nullptr);
+
+        std::ostringstream out;
+        std::ostringstream err;
+        CommandOutput result;
+        {
+            CLI::OutputScope scope(out, err);
+            result.code = CLI::run(target, static_cast<int>(storage.size()), argv.data());
+        }
+        result.out = out.str();
+        result.err = err.str();
+        return result;
+    }
+
+}
+
+#endif //TEST_SUPPORT_H